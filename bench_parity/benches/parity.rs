@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: CC0-1.0
+
+//! Measures the overhead the Rust wrapper adds on top of the C library.
+//!
+//! Every operation is benchmarked twice: once as a loop written in C that calls libsecp256k1
+//! directly (see `c/parity.c`, compiled by `build.rs`), and once through the public API of this
+//! crate, including `Message` conversion, input validation in `from_slice`, copies into
+//! `SerializedSignature` and the like. The difference of the medians is the per-call cost of the
+//! wrapper.
+//!
+//! Run with `cargo bench` from this directory. It accepts the same options as the benchmarks of
+//! the main crate (see `benches/common/mod.rs`), so `-- --json FILE` writes the raw measurements.
+
+#[path = "../../benches/common/mod.rs"]
+mod common;
+
+use std::time::{Duration, Instant};
+
+use common::{black_box, format_ns, Report, Runner};
+use secp256k1::ffi::types::c_uchar;
+use secp256k1::ffi::Context;
+use secp256k1::{ecdh, ecdsa, Keypair, Message, PublicKey, Secp256k1, SecretKey};
+
+extern "C" {
+    fn parity_init(ctx: *const Context, seckey32: *const c_uchar, msg32: *const c_uchar);
+    fn parity_seckey_verify(iters: usize);
+    fn parity_pubkey_create(iters: usize);
+    fn parity_pubkey_parse(iters: usize);
+    fn parity_pubkey_serialize(iters: usize);
+    fn parity_ecdsa_parse_der(iters: usize);
+    fn parity_ecdsa_serialize_der(iters: usize);
+    fn parity_ecdsa_parse_compact(iters: usize);
+    fn parity_ecdsa_sign(iters: usize);
+    fn parity_ecdsa_verify(iters: usize);
+    fn parity_keypair_create(iters: usize);
+    fn parity_schnorr_sign(iters: usize);
+    fn parity_schnorr_verify(iters: usize);
+    fn parity_ecdh(iters: usize);
+}
+
+/// Times `iters` iterations of a C loop.
+fn time_c(f: unsafe extern "C" fn(usize), iters: u64) -> Duration {
+    let start = Instant::now();
+    unsafe { f(iters as usize) };
+    start.elapsed()
+}
+
+fn main() {
+    let mut r = Runner::from_args();
+
+    let secp = Secp256k1::new();
+    let seckey_bytes = [0x3c; 32];
+    let msg_bytes = [0xab; 32];
+    unsafe { parity_init(secp.ctx().as_ptr(), seckey_bytes.as_ptr(), msg_bytes.as_ptr()) };
+
+    let sk = SecretKey::from_slice(&seckey_bytes).unwrap();
+    let pk = PublicKey::from_secret_key(&secp, &sk);
+    let keypair = Keypair::from_secret_key(&secp, &sk);
+    let (xonly, _) = keypair.x_only_public_key();
+    let sig = secp.sign_ecdsa(Message::from_digest(msg_bytes), &sk);
+    let schnorr_sig = secp.sign_schnorr_no_aux_rand(&msg_bytes, &keypair);
+    let pubkey33 = pk.serialize();
+    let der = sig.serialize_der();
+    let compact = sig.serialize_compact();
+
+    let mut rows: Vec<(&str, Option<Report>, Option<Report>)> = vec![];
+    macro_rules! pair {
+        ($name:expr, $c:ident, $rust:expr) => {
+            let c = r.run_timed(concat!("c/", $name), |iters| time_c($c, iters));
+            let rust = r.run(concat!("rust/", $name), $rust);
+            rows.push(($name, c, rust));
+        };
+    }
+
+    pair!("seckey_parse", parity_seckey_verify, || SecretKey::from_slice(black_box(&seckey_bytes)));
+    pair!("pubkey_create", parity_pubkey_create, || PublicKey::from_secret_key(&secp, &sk));
+    pair!("pubkey_parse", parity_pubkey_parse, || PublicKey::from_slice(black_box(&pubkey33)));
+    pair!("pubkey_serialize", parity_pubkey_serialize, || black_box(&pk).serialize());
+    pair!("ecdsa_parse_der", parity_ecdsa_parse_der, || ecdsa::Signature::from_der(black_box(&der)));
+    pair!("ecdsa_serialize_der", parity_ecdsa_serialize_der, || black_box(&sig).serialize_der());
+    pair!("ecdsa_parse_compact", parity_ecdsa_parse_compact, || {
+        ecdsa::Signature::from_compact(black_box(&compact))
+    });
+    pair!("ecdsa_sign", parity_ecdsa_sign, || {
+        secp.sign_ecdsa(Message::from_digest(black_box(msg_bytes)), &sk)
+    });
+    pair!("ecdsa_verify", parity_ecdsa_verify, || {
+        secp.verify_ecdsa(Message::from_digest(black_box(msg_bytes)), &sig, &pk)
+    });
+    pair!("keypair_create", parity_keypair_create, || Keypair::from_secret_key(&secp, &sk));
+    pair!("schnorr_sign", parity_schnorr_sign, || {
+        secp.sign_schnorr_no_aux_rand(black_box(&msg_bytes), &keypair)
+    });
+    pair!("schnorr_verify", parity_schnorr_verify, || {
+        secp.verify_schnorr(&schnorr_sig, black_box(&msg_bytes), &xonly)
+    });
+    pair!("ecdh", parity_ecdh, || ecdh::SharedSecret::new(&pk, &sk));
+
+    let measured: Vec<_> = rows
+        .iter()
+        .filter_map(|(name, c, rust)| Some((name, c.as_ref()?, rust.as_ref()?)))
+        .collect();
+    if !measured.is_empty() {
+        println!();
+        println!("{:<24} {:>12} {:>12} {:>14} {:>9}", "operation", "C p50", "Rust p50", "overhead", "");
+        for (name, c, rust) in measured {
+            let overhead = rust.p50_ns - c.p50_ns;
+            println!(
+                "{:<24} {:>12} {:>12} {:>11.1} ns {:>8.1}%",
+                name,
+                format_ns(c.p50_ns),
+                format_ns(rust.p50_ns),
+                overhead,
+                100.0 * overhead / c.p50_ns
+            );
+        }
+    }
+
+    r.finish();
+}
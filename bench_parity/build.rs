@@ -0,0 +1,15 @@
+// SPDX-License-Identifier: CC0-1.0
+
+//! Compiles the C side of the parity benchmarks against the vendored headers.
+//!
+//! The library itself is linked through `secp256k1-sys`, so the C loops call exactly the code
+//! that the Rust wrapper calls.
+
+fn main() {
+    println!("cargo:rerun-if-changed=c/parity.c");
+    cc::Build::new()
+        .file("c/parity.c")
+        .include("../secp256k1-sys/depend/secp256k1/include")
+        .define("SECP256K1_API", Some("extern"))
+        .compile("secp256k1_parity");
+}
@@ -0,0 +1,150 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+/* The C side of the parity benchmarks: each function performs one operation
+ * `iters` times by calling libsecp256k1 directly, exactly like the loops in
+ * depend/secp256k1/src/bench.c. Timing is done by the caller around a single
+ * call, so the cost of crossing into C once per batch is negligible. */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "secp256k1.h"
+#include "secp256k1_ecdh.h"
+#include "secp256k1_extrakeys.h"
+#include "secp256k1_schnorrsig.h"
+
+static const rustsecp256k1_v0_11_context *ctx;
+static unsigned char seckey[32];
+static unsigned char msg[32];
+static unsigned char pubkey33[33];
+static unsigned char der[72];
+static size_t derlen;
+static unsigned char compact[64];
+static unsigned char schnorr_sig[64];
+static rustsecp256k1_v0_11_pubkey pubkey;
+static rustsecp256k1_v0_11_ecdsa_signature sig;
+static rustsecp256k1_v0_11_keypair keypair;
+static rustsecp256k1_v0_11_xonly_pubkey xonly;
+
+/* Prevents the compiler from dropping results. */
+static volatile int sink;
+
+void parity_init(const rustsecp256k1_v0_11_context *c, const unsigned char *seckey32, const unsigned char *msg32) {
+    size_t len = sizeof(pubkey33);
+
+    ctx = c;
+    memcpy(seckey, seckey32, 32);
+    memcpy(msg, msg32, 32);
+    sink = rustsecp256k1_v0_11_ec_pubkey_create(ctx, &pubkey, seckey);
+    sink = rustsecp256k1_v0_11_ec_pubkey_serialize(ctx, pubkey33, &len, &pubkey, SECP256K1_EC_COMPRESSED);
+    sink = rustsecp256k1_v0_11_ecdsa_sign(ctx, &sig, msg, seckey, NULL, NULL);
+    derlen = sizeof(der);
+    sink = rustsecp256k1_v0_11_ecdsa_signature_serialize_der(ctx, der, &derlen, &sig);
+    sink = rustsecp256k1_v0_11_ecdsa_signature_serialize_compact(ctx, compact, &sig);
+    sink = rustsecp256k1_v0_11_keypair_create(ctx, &keypair, seckey);
+    sink = rustsecp256k1_v0_11_keypair_xonly_pub(ctx, &xonly, NULL, &keypair);
+    sink = rustsecp256k1_v0_11_schnorrsig_sign32(ctx, schnorr_sig, msg, &keypair, NULL);
+}
+
+void parity_seckey_verify(size_t iters) {
+    size_t i;
+    for (i = 0; i < iters; i++) {
+        sink = rustsecp256k1_v0_11_ec_seckey_verify(ctx, seckey);
+    }
+}
+
+void parity_pubkey_create(size_t iters) {
+    rustsecp256k1_v0_11_pubkey pk;
+    size_t i;
+    for (i = 0; i < iters; i++) {
+        sink = rustsecp256k1_v0_11_ec_pubkey_create(ctx, &pk, seckey);
+    }
+}
+
+void parity_pubkey_parse(size_t iters) {
+    rustsecp256k1_v0_11_pubkey pk;
+    size_t i;
+    for (i = 0; i < iters; i++) {
+        sink = rustsecp256k1_v0_11_ec_pubkey_parse(ctx, &pk, pubkey33, sizeof(pubkey33));
+    }
+}
+
+void parity_pubkey_serialize(size_t iters) {
+    unsigned char out[33];
+    size_t i, len;
+    for (i = 0; i < iters; i++) {
+        len = sizeof(out);
+        sink = rustsecp256k1_v0_11_ec_pubkey_serialize(ctx, out, &len, &pubkey, SECP256K1_EC_COMPRESSED);
+    }
+}
+
+void parity_ecdsa_parse_der(size_t iters) {
+    rustsecp256k1_v0_11_ecdsa_signature s;
+    size_t i;
+    for (i = 0; i < iters; i++) {
+        sink = rustsecp256k1_v0_11_ecdsa_signature_parse_der(ctx, &s, der, derlen);
+    }
+}
+
+void parity_ecdsa_serialize_der(size_t iters) {
+    unsigned char out[72];
+    size_t i, len;
+    for (i = 0; i < iters; i++) {
+        len = sizeof(out);
+        sink = rustsecp256k1_v0_11_ecdsa_signature_serialize_der(ctx, out, &len, &sig);
+    }
+}
+
+void parity_ecdsa_parse_compact(size_t iters) {
+    rustsecp256k1_v0_11_ecdsa_signature s;
+    size_t i;
+    for (i = 0; i < iters; i++) {
+        sink = rustsecp256k1_v0_11_ecdsa_signature_parse_compact(ctx, &s, compact);
+    }
+}
+
+void parity_ecdsa_sign(size_t iters) {
+    rustsecp256k1_v0_11_ecdsa_signature s;
+    size_t i;
+    for (i = 0; i < iters; i++) {
+        sink = rustsecp256k1_v0_11_ecdsa_sign(ctx, &s, msg, seckey, NULL, NULL);
+    }
+}
+
+void parity_ecdsa_verify(size_t iters) {
+    size_t i;
+    for (i = 0; i < iters; i++) {
+        sink = rustsecp256k1_v0_11_ecdsa_verify(ctx, &sig, msg, &pubkey);
+    }
+}
+
+void parity_keypair_create(size_t iters) {
+    rustsecp256k1_v0_11_keypair kp;
+    size_t i;
+    for (i = 0; i < iters; i++) {
+        sink = rustsecp256k1_v0_11_keypair_create(ctx, &kp, seckey);
+    }
+}
+
+void parity_schnorr_sign(size_t iters) {
+    unsigned char out[64];
+    size_t i;
+    for (i = 0; i < iters; i++) {
+        sink = rustsecp256k1_v0_11_schnorrsig_sign32(ctx, out, msg, &keypair, NULL);
+    }
+}
+
+void parity_schnorr_verify(size_t iters) {
+    size_t i;
+    for (i = 0; i < iters; i++) {
+        sink = rustsecp256k1_v0_11_schnorrsig_verify(ctx, schnorr_sig, msg, sizeof(msg), &xonly);
+    }
+}
+
+void parity_ecdh(size_t iters) {
+    unsigned char out[32];
+    size_t i;
+    for (i = 0; i < iters; i++) {
+        sink = rustsecp256k1_v0_11_ecdh(ctx, out, &pubkey, seckey, NULL, NULL);
+    }
+}
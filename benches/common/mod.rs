@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: CC0-1.0
+
+//! A small benchmark harness that works on stable Rust.
+//!
+//! Each benchmark is run in batches of `k` calls, with `k` chosen during warm-up so that a batch
+//! takes roughly 20µs. The per-call latency of a batch is its duration divided by `k`; the
+//! reported p50 and p99 are percentiles over those batch latencies, and the throughput is the
+//! total number of calls divided by the total time spent in batches.
+//!
+//! Command line (after `cargo bench --bench <name> --`):
+//!
+//! - `FILTER`: only run benchmarks whose name contains this string.
+//! - `--json FILE`: also write the results as JSON to `FILE` (`-` for stdout).
+//! - `--time MS`: measurement time per benchmark in milliseconds (default 500).
+//!
+//! When the binary is not invoked through `cargo bench` (for example by
+//! `cargo test --all-targets`), every benchmark is run once as a smoke test and nothing is
+//! reported.
+
+#![allow(dead_code)] // Not every bench target uses every helper.
+
+use std::fmt::Write as _;
+use std::time::{Duration, Instant};
+use std::{env, fs, process};
+
+/// Prevents the compiler from optimizing away `x` or the computation producing it.
+///
+/// `std::hint::black_box` is not available at our MSRV.
+#[inline]
+pub fn black_box<T>(x: T) -> T {
+    unsafe {
+        let ret = std::ptr::read_volatile(&x);
+        std::mem::forget(x);
+        ret
+    }
+}
+
+/// The measurements of a single benchmark.
+#[derive(Clone, Debug)]
+pub struct Report {
+    /// The benchmark name.
+    pub name: String,
+    /// Total number of calls measured.
+    pub iterations: u64,
+    /// Calls per second.
+    pub ops_per_sec: f64,
+    /// Mean latency of a call in nanoseconds.
+    pub mean_ns: f64,
+    /// Median latency of a call in nanoseconds.
+    pub p50_ns: f64,
+    /// 99th percentile latency of a call in nanoseconds.
+    pub p99_ns: f64,
+}
+
+/// Runs benchmarks and collects their reports.
+pub struct Runner {
+    filter: Option<String>,
+    json: Option<String>,
+    time: Duration,
+    smoke: bool,
+    reports: Vec<Report>,
+}
+
+impl Runner {
+    /// Creates a runner configured from the command line.
+    pub fn from_args() -> Runner {
+        let mut runner = Runner {
+            filter: None,
+            json: None,
+            time: Duration::from_millis(500),
+            smoke: true,
+            reports: vec![],
+        };
+        let mut args = env::args().skip(1);
+        while let Some(arg) = args.next() {
+            match arg.as_str() {
+                // Passed by `cargo bench`.
+                "--bench" => runner.smoke = false,
+                "--json" => runner.json = Some(args.next().unwrap_or_else(|| usage())),
+                "--time" => {
+                    let ms = args.next().and_then(|ms| ms.parse().ok()).unwrap_or_else(|| usage());
+                    runner.time = Duration::from_millis(ms);
+                }
+                _ if arg.starts_with('-') => usage(),
+                _ => runner.filter = Some(arg),
+            }
+        }
+        runner
+    }
+
+    /// Returns whether the benchmark called `name` is selected by the filter.
+    pub fn wants(&self, name: &str) -> bool {
+        self.filter.as_ref().map_or(true, |filter| name.contains(filter.as_str()))
+    }
+
+    /// Benchmarks `f` under `name`, returning its report (or `None` if it was filtered out or
+    /// only smoke tested).
+    pub fn run<T, F: FnMut() -> T>(&mut self, name: &str, mut f: F) -> Option<Report> {
+        self.run_timed(name, |calls| {
+            let start = Instant::now();
+            for _ in 0..calls {
+                black_box(f());
+            }
+            start.elapsed()
+        })
+    }
+
+    /// Benchmarks an operation that times itself: `f(n)` must perform the operation `n` times
+    /// and return the time this took. This allows benchmarking loops that run outside of Rust.
+    pub fn run_timed<F: FnMut(u64) -> Duration>(&mut self, name: &str, mut f: F) -> Option<Report> {
+        if !self.wants(name) {
+            return None;
+        }
+        if self.smoke {
+            f(1);
+            return None;
+        }
+
+        // Warm up, and estimate how many calls make a batch of about 20µs.
+        let warmup = self.time / 10;
+        let mut warm = Duration::ZERO;
+        let mut calls = 0u64;
+        while warm < warmup || calls == 0 {
+            warm += f(1);
+            calls += 1;
+        }
+        let per_call = warm.as_nanos() as f64 / calls as f64;
+        let batch = ((20_000.0 / per_call) as u64).max(1);
+
+        let mut samples = Vec::new();
+        let mut total = Duration::ZERO;
+        while total < self.time || samples.len() < 10 {
+            let elapsed = f(batch);
+            total += elapsed;
+            samples.push(elapsed.as_nanos() as f64 / batch as f64);
+        }
+        samples.sort_by(|a, b| a.partial_cmp(b).expect("no NaN"));
+
+        let iterations = batch * samples.len() as u64;
+        let report = Report {
+            name: name.to_owned(),
+            iterations,
+            ops_per_sec: iterations as f64 / total.as_secs_f64(),
+            mean_ns: total.as_nanos() as f64 / iterations as f64,
+            p50_ns: percentile(&samples, 50),
+            p99_ns: percentile(&samples, 99),
+        };
+        println!(
+            "{:<40} {:>14.0} ops/s   p50 {:>12}   p99 {:>12}",
+            report.name,
+            report.ops_per_sec,
+            format_ns(report.p50_ns),
+            format_ns(report.p99_ns)
+        );
+        self.reports.push(report.clone());
+        Some(report)
+    }
+
+    /// Writes the JSON output, if requested.
+    pub fn finish(self) {
+        let path = match self.json {
+            Some(ref path) if !self.smoke => path,
+            _ => return,
+        };
+        let json = to_json(&self.reports);
+        if path == "-" {
+            println!("{}", json);
+        } else if let Err(e) = fs::write(path, json) {
+            eprintln!("failed to write {}: {}", path, e);
+            process::exit(1);
+        }
+    }
+}
+
+fn usage() -> ! {
+    eprintln!("usage: cargo bench --bench <name> -- [FILTER] [--json FILE] [--time MS]");
+    process::exit(2)
+}
+
+/// Returns the `p`-th percentile of the sorted `samples` (nearest rank).
+fn percentile(samples: &[f64], p: usize) -> f64 {
+    let rank = (samples.len() * p + 99) / 100;
+    samples[rank.max(1) - 1]
+}
+
+/// Formats a duration given in nanoseconds with a sensible unit.
+pub fn format_ns(ns: f64) -> String {
+    if ns < 1_000.0 {
+        format!("{:.1} ns", ns)
+    } else if ns < 1_000_000.0 {
+        format!("{:.2} µs", ns / 1_000.0)
+    } else {
+        format!("{:.2} ms", ns / 1_000_000.0)
+    }
+}
+
+/// Serializes the reports as a JSON document.
+fn to_json(reports: &[Report]) -> String {
+    let mut s = String::new();
+    s.push_str("{\n");
+    let _ = writeln!(s, "  \"crate_version\": \"{}\",", env!("CARGO_PKG_VERSION"));
+    s.push_str("  \"benchmarks\": [\n");
+    for (i, r) in reports.iter().enumerate() {
+        let _ = write!(
+            s,
+            "    {{\"name\": \"{}\", \"iterations\": {}, \"ops_per_sec\": {:.3}, \"mean_ns\": {:.3}, \"p50_ns\": {:.3}, \"p99_ns\": {:.3}}}",
+            r.name, r.iterations, r.ops_per_sec, r.mean_ns, r.p50_ns, r.p99_ns
+        );
+        s.push_str(if i + 1 < reports.len() { ",\n" } else { "\n" });
+    }
+    s.push_str("  ]\n}\n");
+    s
+}
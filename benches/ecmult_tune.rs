@@ -0,0 +1,271 @@
+// SPDX-License-Identifier: CC0-1.0
+
+//! Measures the multi-scalar multiplication crossovers of the C library on this machine.
+//!
+//! The library computes sums of many point multiplications with Strauss' algorithm below
+//! `ECMULT_PIPPENGER_THRESHOLD` points and with Pippenger's algorithm above, using a bucket
+//! window chosen from the number of points by `ECMULT_PIPPENGER_WINDOW_LIMITS` (both in
+//! `secp256k1-sys/depend/secp256k1/src/ecmult_impl.h`). The built-in values were measured on one
+//! machine; this benchmark times both algorithms and the plausible windows for a sweep of point
+//! counts and derives the values for the host.
+//!
+//! Run with
+//! `cargo bench --features ecmult-tune --bench ecmult_tune -- [--out FILE] [--max-points N]
+//! [--time MS]`, then build with `RUST_SECP_ECMULT_TUNING=FILE` in the environment to compile
+//! the measured values into the library.
+//!
+//! When the binary is not invoked through `cargo bench`, only a few small point counts are run
+//! to check that all algorithms agree.
+
+mod common;
+
+use std::time::{Duration, Instant};
+use std::{env, fs, process};
+
+use common::format_ns;
+use secp256k1::ffi::types::{c_int, c_uchar, c_void};
+use secp256k1::ffi::{self, CPtr};
+use secp256k1::{rand, PublicKey, Secp256k1, SecretKey, VerifyOnly};
+
+/// The largest Pippenger bucket window (`PIPPENGER_MAX_BUCKET_WINDOW`).
+const MAX_WINDOW: c_int = 12;
+
+/// The built-in `ECMULT_PIPPENGER_WINDOW_LIMITS`.
+const DEFAULT_LIMITS: [usize; MAX_WINDOW as usize - 1] =
+    [1, 4, 20, 57, 136, 235, 1260, 1260, 4420, 7880, 16050];
+
+/// Strauss' algorithm is not timed above this many points, where it is far slower than
+/// Pippenger's.
+const STRAUSS_MAX_POINTS: usize = 1024;
+
+struct Options {
+    out: Option<String>,
+    max_points: usize,
+    time: Duration,
+    smoke: bool,
+}
+
+/// The fastest time per call of each algorithm for one point count.
+struct Sample {
+    n: usize,
+    strauss: Option<f64>,
+    window: c_int,
+    pippenger: f64,
+}
+
+/// Aligned storage for the scratch space (the library aligns within it, not the base).
+#[derive(Clone, Copy)]
+#[repr(C, align(64))]
+struct Block([u8; 64]);
+
+struct Tuner {
+    secp: Secp256k1<VerifyOnly>,
+    points: Vec<ffi::PublicKey>,
+    scalars: Vec<[u8; 32]>,
+    scratch: Vec<Block>,
+}
+
+impl Tuner {
+    /// Computes the sum of the first `n` scalar-point products with the given algorithm
+    /// (window 0 is Strauss' algorithm).
+    fn multiply(&mut self, n: usize, window: c_int) -> PublicKey {
+        let size = unsafe { ffi::secp256k1_ecmult_multi_tune_scratch_size(n, window) };
+        let blocks = (size + 63) / 64;
+        if self.scratch.len() < blocks {
+            self.scratch.resize(blocks, Block([0; 64]));
+        }
+        unsafe {
+            let mut result = ffi::PublicKey::new();
+            let ret = ffi::secp256k1_ecmult_multi_tune(
+                self.secp.ctx().as_ptr(),
+                &mut result,
+                self.scratch.as_mut_ptr() as *mut c_void,
+                blocks * 64,
+                window,
+                self.scalars.as_ptr() as *const c_uchar,
+                self.points.as_ptr(),
+                n,
+            );
+            assert_eq!(ret, 1, "multiplication of {} points with window {} failed", n, window);
+            PublicKey::from(result)
+        }
+    }
+
+    /// Returns the fastest of repeated runs of `multiply(n, window)`, in nanoseconds.
+    fn time(&mut self, n: usize, window: c_int, budget: Duration) -> f64 {
+        let mut best = f64::INFINITY;
+        let mut total = Duration::ZERO;
+        let mut runs = 0;
+        while total < budget || runs < 3 {
+            let start = Instant::now();
+            common::black_box(self.multiply(n, window));
+            let elapsed = start.elapsed();
+            best = best.min(elapsed.as_nanos() as f64);
+            total += elapsed;
+            runs += 1;
+        }
+        best
+    }
+}
+
+/// Returns the built-in bucket window for `n` points.
+fn default_window(n: usize) -> c_int {
+    DEFAULT_LIMITS.iter().position(|&limit| n <= limit).map_or(MAX_WINDOW, |w| w as c_int + 1)
+}
+
+/// Returns roughly geometrically spaced point counts from 1 to `max`.
+fn point_counts(max: usize) -> Vec<usize> {
+    let mut counts = vec![];
+    let mut n = 1.0f64;
+    while (n as usize) <= max {
+        if counts.last() != Some(&(n as usize)) {
+            counts.push(n as usize);
+        }
+        n *= 1.25;
+    }
+    counts
+}
+
+/// Returns the smallest point count from which Pippenger's algorithm is always faster, placed
+/// halfway between the neighbouring samples.
+fn threshold(samples: &[Sample]) -> usize {
+    let timed: Vec<&Sample> = samples.iter().filter(|s| s.strauss.is_some()).collect();
+    let first_win = timed
+        .iter()
+        .rposition(|s| s.pippenger >= s.strauss.unwrap())
+        .map_or(0, |lose| lose + 1);
+    match (first_win.checked_sub(1).map(|i| timed[i]), timed.get(first_win)) {
+        (Some(lose), Some(win)) => (lose.n + win.n + 1) / 2,
+        (None, Some(win)) => win.n,
+        // Pippenger never won: keep it out of the measured range.
+        (_, None) => STRAUSS_MAX_POINTS,
+    }
+}
+
+/// Returns the largest point count for which each window is optimal.
+///
+/// The best window is made non-decreasing in the number of points, and each boundary is placed
+/// halfway between the neighbouring samples. Windows whose boundary lies beyond the sweep keep
+/// their built-in limit (or the end of the sweep, whichever is larger).
+fn window_limits(samples: &[Sample]) -> [usize; MAX_WINDOW as usize - 1] {
+    let mut best = Vec::with_capacity(samples.len());
+    let mut max = 1;
+    for s in samples {
+        max = max.max(s.window);
+        best.push(max);
+    }
+
+    let last = samples.last().expect("at least one sample").n;
+    let mut limits = [0; MAX_WINDOW as usize - 1];
+    let mut prev = 0;
+    for w in 1..MAX_WINDOW {
+        let limit = match best.iter().rposition(|&b| b <= w) {
+            Some(i) if i + 1 < samples.len() => (samples[i].n + samples[i + 1].n) / 2,
+            Some(_) => DEFAULT_LIMITS[w as usize - 1].max(last),
+            None => 0,
+        };
+        prev = limit.max(prev);
+        limits[w as usize - 1] = prev;
+    }
+    limits
+}
+
+fn parse_args() -> Options {
+    let mut opts =
+        Options { out: None, max_points: 20_000, time: Duration::from_millis(100), smoke: true };
+    let mut args = env::args().skip(1);
+    while let Some(arg) = args.next() {
+        let mut value = || args.next().unwrap_or_else(|| usage());
+        match arg.as_str() {
+            // Passed by `cargo bench`.
+            "--bench" => opts.smoke = false,
+            "--out" => opts.out = Some(value()),
+            "--max-points" => opts.max_points = value().parse().unwrap_or_else(|_| usage()),
+            "--time" => {
+                opts.time = Duration::from_millis(value().parse().unwrap_or_else(|_| usage()))
+            }
+            _ => usage(),
+        }
+    }
+    opts
+}
+
+fn usage() -> ! {
+    eprintln!(
+        "usage: cargo bench --bench ecmult_tune -- [--out FILE] [--max-points N] [--time MS]"
+    );
+    process::exit(2)
+}
+
+fn main() {
+    let opts = parse_args();
+    let counts = if opts.smoke { vec![1, 5, 40] } else { point_counts(opts.max_points) };
+    let max_points = *counts.last().unwrap();
+
+    let secp = Secp256k1::new();
+    let mut rng = rand::thread_rng();
+    let points = (0..max_points)
+        .map(|_| unsafe { *PublicKey::from_secret_key(&secp, &SecretKey::new(&mut rng)).as_c_ptr() })
+        .collect();
+    let scalars = (0..max_points).map(|_| rand::Rng::gen(&mut rng)).collect();
+    let mut tuner =
+        Tuner { secp: Secp256k1::verification_only(), points, scalars, scratch: vec![] };
+
+    if opts.smoke {
+        for n in counts {
+            let expected = tuner.multiply(n, 0);
+            for window in 1..=MAX_WINDOW {
+                assert_eq!(tuner.multiply(n, window), expected);
+            }
+        }
+        return;
+    }
+
+    println!("{:>8} {:>14} {:>6} {:>14}", "points", "strauss/pt", "window", "pippenger/pt");
+    let mut samples = vec![];
+    for n in counts {
+        let expected = tuner.multiply(n, 0);
+        let strauss =
+            if n <= STRAUSS_MAX_POINTS { Some(tuner.time(n, 0, opts.time)) } else { None };
+        let (mut window, mut pippenger) = (0, f64::INFINITY);
+        let default = default_window(n);
+        for w in (default - 2).max(1)..=(default + 2).min(MAX_WINDOW) {
+            assert_eq!(tuner.multiply(n, w), expected);
+            let t = tuner.time(n, w, opts.time);
+            if t < pippenger {
+                window = w;
+                pippenger = t;
+            }
+        }
+        println!(
+            "{:>8} {:>14} {:>6} {:>14}",
+            n,
+            strauss.map_or(String::from("-"), |t| format_ns(t / n as f64)),
+            window,
+            format_ns(pippenger / n as f64)
+        );
+        samples.push(Sample { n, strauss, window, pippenger });
+    }
+
+    let limits = window_limits(&samples)
+        .iter()
+        .map(usize::to_string)
+        .collect::<Vec<_>>()
+        .join(",");
+    let table = format!(
+        "# Multi-scalar multiplication crossovers measured by `cargo bench --bench ecmult_tune` on\n\
+         # {}. Build with RUST_SECP_ECMULT_TUNING=<this file> to use them.\n\
+         ECMULT_PIPPENGER_THRESHOLD={}\n\
+         ECMULT_PIPPENGER_WINDOW_LIMITS={}\n",
+        env::consts::ARCH,
+        threshold(&samples),
+        limits
+    );
+    println!("\n{}", table);
+    if let Some(path) = opts.out {
+        if let Err(e) = fs::write(&path, table) {
+            eprintln!("failed to write {}: {}", path, e);
+            process::exit(1);
+        }
+    }
+}
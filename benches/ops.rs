@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: CC0-1.0
+
+//! Benchmarks of the public API, runnable on stable Rust.
+//!
+//! Run with `cargo bench --bench ops --features=recovery -- [FILTER] [--json FILE]`, see
+//! `common/mod.rs` for the options and for how latencies are measured.
+
+mod common;
+
+use common::{black_box, Runner};
+use secp256k1::ellswift::{ElligatorSwift, Party};
+use secp256k1::{
+    ecdh, ecdsa, rand, schnorr, Keypair, Message, PublicKey, Scalar, Secp256k1, SecretKey,
+    XOnlyPublicKey,
+};
+
+fn main() {
+    let mut r = Runner::from_args();
+
+    let secp = Secp256k1::new();
+    let mut rng = rand::thread_rng();
+    let sk = SecretKey::from_slice(&[0x3c; 32]).unwrap();
+    let sk2 = SecretKey::from_slice(&[0x5e; 32]).unwrap();
+    let pk = PublicKey::from_secret_key(&secp, &sk);
+    let pk2 = PublicKey::from_secret_key(&secp, &sk2);
+    let keypair = Keypair::from_secret_key(&secp, &sk);
+    let (xonly, _) = keypair.x_only_public_key();
+    let msg_bytes = [0xab; 32];
+    let msg = Message::from_digest(msg_bytes);
+    let tweak = Scalar::from_be_bytes([0x11; 32]).unwrap();
+
+    // Contexts.
+    r.run("context/create", Secp256k1::new);
+    r.run("context/clone", || secp.clone());
+    let mut ctx = Secp256k1::new();
+    r.run("context/randomize", || ctx.seeded_randomize(&[0x42; 32]));
+
+    // Key generation.
+    r.run("keygen/secret_key", || SecretKey::new(&mut rng));
+    r.run("keygen/public_key", || PublicKey::from_secret_key(&secp, &sk));
+    r.run("keygen/keypair", || Keypair::from_secret_key(&secp, &sk));
+    r.run("keygen/generate_keypair", || secp.generate_keypair(&mut rng));
+    r.run("keygen/x_only_public_key", || keypair.x_only_public_key());
+
+    // Tweaks.
+    r.run("tweak/seckey_add", || sk.add_tweak(&tweak));
+    r.run("tweak/seckey_mul", || sk.mul_tweak(&tweak));
+    r.run("tweak/pubkey_add_exp", || pk.add_exp_tweak(&secp, &tweak));
+    r.run("tweak/pubkey_mul", || pk.mul_tweak(&secp, &tweak));
+    r.run("tweak/pubkey_combine", || pk.combine(&pk2));
+    r.run("tweak/keypair_add_xonly", || keypair.add_xonly_tweak(&secp, &tweak));
+    let (tweaked, parity) = xonly.add_tweak(&secp, &tweak).unwrap();
+    r.run("tweak/xonly_add", || xonly.add_tweak(&secp, &tweak));
+    r.run("tweak/xonly_add_check", || xonly.tweak_add_check(&secp, &tweaked, parity, tweak));
+
+    // ECDSA.
+    let sig = secp.sign_ecdsa(msg, &sk);
+    r.run("ecdsa/sign", || secp.sign_ecdsa(msg, &sk));
+    r.run("ecdsa/sign_low_r", || secp.sign_ecdsa_low_r(msg, &sk));
+    r.run("ecdsa/verify", || secp.verify_ecdsa(msg, &sig, &pk));
+    #[cfg(feature = "recovery")]
+    {
+        let rsig = secp.sign_ecdsa_recoverable(msg, &sk);
+        r.run("ecdsa/sign_recoverable", || secp.sign_ecdsa_recoverable(msg, &sk));
+        r.run("ecdsa/recover", || secp.recover_ecdsa(msg, &rsig));
+    }
+
+    // Schnorr.
+    let schnorr_sig = secp.sign_schnorr_no_aux_rand(&msg_bytes, &keypair);
+    r.run("schnorr/sign", || secp.sign_schnorr_with_aux_rand(&msg_bytes, &keypair, &[7; 32]));
+    r.run("schnorr/sign_no_aux_rand", || secp.sign_schnorr_no_aux_rand(&msg_bytes, &keypair));
+    r.run("schnorr/verify", || secp.verify_schnorr(&schnorr_sig, &msg_bytes, &xonly));
+    let batch: Vec<_> = (0..100u8)
+        .map(|i| {
+            let keypair = Keypair::from_seckey_slice(&secp, &[i + 1; 32]).unwrap();
+            let sig = secp.sign_schnorr_no_aux_rand(&msg_bytes, &keypair);
+            (sig, &msg_bytes[..], keypair.x_only_public_key().0)
+        })
+        .collect();
+    r.run("schnorr/verify_batch_100", || secp.verify_schnorr_batch(black_box(&batch)));
+
+    // Parsing and serialization.
+    let der = sig.serialize_der();
+    let compact = sig.serialize_compact();
+    let compressed = pk.serialize();
+    let uncompressed = pk.serialize_uncompressed();
+    let xonly_bytes = xonly.serialize();
+    let schnorr_bytes = schnorr_sig.to_byte_array();
+    r.run("parse/ecdsa_der", || ecdsa::Signature::from_der(black_box(&der)));
+    r.run("parse/ecdsa_compact", || ecdsa::Signature::from_compact(black_box(&compact)));
+    r.run("parse/pubkey_compressed", || PublicKey::from_slice(black_box(&compressed)));
+    r.run("parse/pubkey_uncompressed", || PublicKey::from_slice(black_box(&uncompressed)));
+    r.run("parse/xonly_pubkey", || XOnlyPublicKey::from_slice(black_box(&xonly_bytes)));
+    r.run("parse/schnorr_sig", || schnorr::Signature::from_slice(black_box(&schnorr_bytes)));
+    r.run("parse/seckey", || SecretKey::from_slice(black_box(&[0x3c; 32])));
+    let sigs: Vec<_> = (0..100u8).map(|i| secp.sign_ecdsa(Message::from_digest([i; 32]), &sk)).collect();
+    let mut der_buf = vec![];
+    let der_ranges = ecdsa::Signature::serialize_der_batch(&sigs, &mut der_buf);
+    r.run("parse/ecdsa_der_batch_100", || {
+        ecdsa::Signature::from_der_batch(black_box(&der_buf), &der_ranges)
+    });
+    r.run("serialize/ecdsa_der", || black_box(&sig).serialize_der());
+    r.run("serialize/ecdsa_der_batch_100", || {
+        ecdsa::Signature::serialize_der_batch(black_box(&sigs), &mut Vec::with_capacity(7200))
+    });
+    r.run("serialize/ecdsa_compact", || black_box(&sig).serialize_compact());
+    r.run("serialize/pubkey_compressed", || black_box(&pk).serialize());
+    r.run("serialize/pubkey_uncompressed", || black_box(&pk).serialize_uncompressed());
+    r.run("serialize/xonly_pubkey", || black_box(&xonly).serialize());
+    let keys: Vec<_> = (1..=1000u32)
+        .map(|i| {
+            let mut bytes = [0x3c; 32];
+            bytes[..4].copy_from_slice(&i.to_be_bytes());
+            SecretKey::from_slice(&bytes).unwrap().public_key(&secp)
+        })
+        .collect();
+    r.run("sort/pubkeys_1000", || keys.clone().sort());
+    r.run("sort/pubkeys_1000_sort_slice", || PublicKey::sort_slice(&mut keys.clone()));
+
+    // ECDH.
+    r.run("ecdh/shared_secret", || ecdh::SharedSecret::new(&pk2, &sk));
+    r.run("ecdh/shared_secret_point", || ecdh::shared_secret_point(&pk2, &sk));
+
+    // ElligatorSwift.
+    let ell = ElligatorSwift::from_seckey(&secp, sk, None);
+    let ell2 = ElligatorSwift::from_seckey(&secp, sk2, None);
+    r.run("ellswift/from_pubkey", || ElligatorSwift::from_pubkey(pk));
+    r.run("ellswift/from_seckey", || ElligatorSwift::from_seckey(&secp, sk, Some([9; 32])));
+    r.run("ellswift/decode", || PublicKey::from_ellswift(black_box(ell)));
+    r.run("ellswift/shared_secret", || {
+        ElligatorSwift::shared_secret(ell, ell2, sk, Party::Initiator, None)
+    });
+
+    r.finish();
+}
@@ -5,10 +5,10 @@
 # shellcheck disable=SC2034
 
 # Test all these features with "std" enabled.
-FEATURES_WITH_STD="hashes global-context global-context-less-secure lowmemory rand recovery serde"
+FEATURES_WITH_STD="hashes global-context global-context-less-secure lowmemory rand recovery serde instrumentation rayon"
 
 # Test all these features without "std" enabled.
-FEATURES_WITHOUT_STD="hashes global-context global-context-less-secure lowmemory rand recovery serde alloc"
+FEATURES_WITHOUT_STD="hashes global-context global-context-less-secure lowmemory rand recovery serde alloc instrumentation"
 
 # Run these examples.
 EXAMPLES="sign_verify:hashes,std sign_verify_recovery:hashes,std,recovery generate_keys:rand,std"
@@ -31,16 +31,44 @@ fn main() {
                // just #define it away.
                .define("printf(...)", Some(""));
 
+    // The tables for verification take 2^(window + 5) bytes: 512 bytes at window 4, 8 KiB at 8,
+    // 32 KiB at 10 and 1 MiB at 15. The precomputed tables go up to window 15.
+    println!("cargo:rerun-if-env-changed=RUST_SECP_ECMULT_WINDOW_SIZE");
+    let window = env::var("RUST_SECP_ECMULT_WINDOW_SIZE").ok().map(|w| match w.parse::<u32>() {
+        Ok(w @ 2..=15) => w.to_string(),
+        _ => panic!("RUST_SECP_ECMULT_WINDOW_SIZE must be an integer from 2 to 15, not {:?}", w),
+    });
     if cfg!(feature = "lowmemory") {
-        base_config.define("ECMULT_WINDOW_SIZE", Some("4")); // A low-enough value to consume negligible memory
+        // A low-enough value to consume negligible memory
+        base_config.define("ECMULT_WINDOW_SIZE", Some(window.as_deref().unwrap_or("4")));
         base_config.define("ECMULT_GEN_PREC_BITS", Some("2"));
     } else {
         base_config.define("ECMULT_GEN_PREC_BITS", Some("4"));
-        base_config.define("ECMULT_WINDOW_SIZE", Some("15")); // This is the default in the configure file (`auto`)
+        // 15 is the default in the configure file (`auto`)
+        base_config.define("ECMULT_WINDOW_SIZE", Some(window.as_deref().unwrap_or("15")));
     }
     base_config.define("USE_EXTERNAL_DEFAULT_CALLBACKS", Some("1"));
     #[cfg(feature = "recovery")]
     base_config.define("ENABLE_MODULE_RECOVERY", Some("1"));
+    // Per-thread table placement needs thread-local storage.
+    #[cfg(feature = "std")]
+    base_config.define("ENABLE_THREAD_LOCAL_TABLES", Some("1"));
+    #[cfg(feature = "instrumentation")]
+    base_config.define("ENABLE_INSTRUMENTATION", Some("1"));
+    #[cfg(feature = "instrumentation-cycles")]
+    base_config.define("ENABLE_INSTRUMENTATION_CYCLES", Some("1"));
+    #[cfg(feature = "ecmult-tune")]
+    base_config.define("ENABLE_MODULE_ECMULT_TUNE", Some("1"));
+
+    // Multi-scalar multiplication crossovers measured on the target, see
+    // `cargo bench --features ecmult-tune --bench ecmult_tune` in the secp256k1 crate.
+    println!("cargo:rerun-if-env-changed=RUST_SECP_ECMULT_TUNING");
+    if let Some(path) = env::var_os("RUST_SECP_ECMULT_TUNING") {
+        println!("cargo:rerun-if-changed={}", path.to_string_lossy());
+        for (key, value) in read_ecmult_tuning(&path) {
+            base_config.define(key, Some(value.as_str()));
+        }
+    }
 
     // WASM headers and size/align defines.
     if env::var("CARGO_CFG_TARGET_ARCH").unwrap() == "wasm32" {
@@ -48,11 +76,18 @@ fn main() {
                    .file("wasm/wasm.c");
     }
 
+    // Printing any rerun-if line above stops cargo from watching the package, so list the C
+    // sources explicitly.
+    for path in ["build.rs", "depend", "ext", "wasm"] {
+        println!("cargo:rerun-if-changed={}", path);
+    }
+
     // secp256k1
     base_config.file("depend/secp256k1/contrib/lax_der_parsing.c")
                .file("depend/secp256k1/src/precomputed_ecmult_gen.c")
                .file("depend/secp256k1/src/precomputed_ecmult.c")
-               .file("depend/secp256k1/src/secp256k1.c");
+               // Includes depend/secp256k1/src/secp256k1.c followed by our extension modules.
+               .file("ext/secp256k1_ext.c");
 
     if base_config.try_compile("libsecp256k1.a").is_err() {
         // Some embedded platforms may not have, eg, string.h available, so if the build fails
@@ -63,3 +98,35 @@ fn main() {
     }
 }
 
+/// Parses a file of `KEY=VALUE` lines as written by the `ecmult_tune` benchmark.
+///
+/// Only the keys which `ecmult_impl.h` allows to override are accepted. Empty lines and lines
+/// starting with `#` are ignored.
+fn read_ecmult_tuning(path: &std::ffi::OsStr) -> Vec<(&'static str, String)> {
+    let contents = std::fs::read_to_string(path)
+        .unwrap_or_else(|e| panic!("cannot read RUST_SECP_ECMULT_TUNING file {:?}: {}", path, e));
+
+    let mut ret = vec![];
+    for line in contents.lines().map(str::trim) {
+        if line.is_empty() || line.starts_with('#') {
+            continue;
+        }
+        let (key, value) = line.split_once('=').unwrap_or_else(|| panic!("invalid tuning line {:?}", line));
+        let numbers = value
+            .split(',')
+            .map(|n| n.trim().parse::<u64>())
+            .collect::<Result<Vec<_>, _>>()
+            .unwrap_or_else(|_| panic!("invalid tuning value {:?}", value));
+        let key = match key.trim() {
+            "ECMULT_PIPPENGER_THRESHOLD" if numbers.len() == 1 => "ECMULT_PIPPENGER_THRESHOLD",
+            // One limit for each window from 1 to PIPPENGER_MAX_BUCKET_WINDOW - 1.
+            "ECMULT_PIPPENGER_WINDOW_LIMITS" if numbers.len() == 11 && numbers.windows(2).all(|w| w[0] <= w[1]) => {
+                "ECMULT_PIPPENGER_WINDOW_LIMITS"
+            }
+            _ => panic!("invalid tuning line {:?}", line),
+        };
+        let value = numbers.iter().map(u64::to_string).collect::<Vec<_>>().join(",");
+        ret.push((key, value));
+    }
+    ret
+}
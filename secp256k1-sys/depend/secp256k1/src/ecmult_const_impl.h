@@ -199,8 +199,10 @@ static void rustsecp256k1_v0_11_ecmult_const(rustsecp256k1_v0_11_gej *r, const r
     /* We're allowed to be non-constant time in the point, and the code below (in particular,
      * rustsecp256k1_v0_11_ecmult_const_odd_multiples_table_globalz) cannot deal with infinity in a
      * constant-time manner anyway. */
+    SECP256K1_STATS_BEGIN(SECP256K1_STATS_ECMULT_CONST);
     if (rustsecp256k1_v0_11_ge_is_infinity(a)) {
         rustsecp256k1_v0_11_gej_set_infinity(r);
+        SECP256K1_STATS_END(SECP256K1_STATS_ECMULT_CONST);
         return;
     }
 
@@ -265,6 +267,7 @@ static void rustsecp256k1_v0_11_ecmult_const(rustsecp256k1_v0_11_gej *r, const r
 
     /* Map the result back to the secp256k1 curve from the isomorphic curve. */
     rustsecp256k1_v0_11_fe_mul(&r->z, &r->z, &global_z);
+    SECP256K1_STATS_END(SECP256K1_STATS_ECMULT_CONST);
 }
 
 static int rustsecp256k1_v0_11_ecmult_const_xonly(rustsecp256k1_v0_11_fe* r, const rustsecp256k1_v0_11_fe *n, const rustsecp256k1_v0_11_fe *d, const rustsecp256k1_v0_11_scalar *q, int known_on_curve) {
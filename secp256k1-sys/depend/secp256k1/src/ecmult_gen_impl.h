@@ -14,6 +14,12 @@
 #include "hash_impl.h"
 #include "precomputed_ecmult_gen.h"
 
+/* The table read by ecmult_gen. The including code can redirect it to a copy
+ * elsewhere in memory (see secp256k1-sys/ext/tables.h). */
+#ifndef SECP256K1_ECMULT_GEN_PREC_TABLE
+#define SECP256K1_ECMULT_GEN_PREC_TABLE rustsecp256k1_v0_11_ecmult_gen_prec_table
+#endif
+
 static void rustsecp256k1_v0_11_ecmult_gen_context_build(rustsecp256k1_v0_11_ecmult_gen_context *ctx) {
     rustsecp256k1_v0_11_ecmult_gen_blind(ctx, NULL);
     ctx->built = 1;
@@ -62,7 +68,9 @@ static void rustsecp256k1_v0_11_ecmult_gen(const rustsecp256k1_v0_11_ecmult_gen_
      * avoids the need to deal with out-of-bounds reads from a scalar. */
     uint32_t recoded[(COMB_BITS + 31) >> 5] = {0};
     int first = 1, i;
+    const rustsecp256k1_v0_11_ge_storage (*prec_table)[COMB_POINTS] = SECP256K1_ECMULT_GEN_PREC_TABLE;
 
+    SECP256K1_STATS_BEGIN(SECP256K1_STATS_ECMULT_GEN);
     memset(&adds, 0, sizeof(adds));
 
     /* We want to compute R = gn*G.
@@ -245,7 +253,7 @@ static void rustsecp256k1_v0_11_ecmult_gen(const rustsecp256k1_v0_11_ecmult_gen_
              *    (https://www.tau.ac.il/~tromer/papers/cache.pdf)
              */
             for (index = 0; index < COMB_POINTS; ++index) {
-                rustsecp256k1_v0_11_ge_storage_cmov(&adds, &rustsecp256k1_v0_11_ecmult_gen_prec_table[block][index], index == abs);
+                rustsecp256k1_v0_11_ge_storage_cmov(&adds, &prec_table[block][index], index == abs);
             }
 
             /* Set add=adds or add=-adds, in constant time, based on sign. */
@@ -279,6 +287,7 @@ static void rustsecp256k1_v0_11_ecmult_gen(const rustsecp256k1_v0_11_ecmult_gen_
     rustsecp256k1_v0_11_ge_clear(&add);
     rustsecp256k1_v0_11_memclear(&adds, sizeof(adds));
     rustsecp256k1_v0_11_memclear(&recoded, sizeof(recoded));
+    SECP256K1_STATS_END(SECP256K1_STATS_ECMULT_GEN);
 }
 
 /* Setup blinding values for rustsecp256k1_v0_11_ecmult_gen. */
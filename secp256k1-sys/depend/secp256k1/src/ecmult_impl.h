@@ -16,6 +16,13 @@
 #include "ecmult.h"
 #include "precomputed_ecmult.h"
 
+/* The tables of multiples of G read by ecmult. The including code can redirect
+ * them to a copy elsewhere in memory (see secp256k1-sys/ext/tables.h). */
+#ifndef SECP256K1_ECMULT_PRE_G
+#define SECP256K1_ECMULT_PRE_G rustsecp256k1_v0_11_pre_g
+#define SECP256K1_ECMULT_PRE_G_128 rustsecp256k1_v0_11_pre_g_128
+#endif
+
 #if defined(EXHAUSTIVE_TEST_ORDER)
 /* We need to lower these values for exhaustive tests because
  * the tables cannot have infinities in them (this breaks the
@@ -52,7 +59,17 @@
 #define PIPPENGER_MAX_BUCKET_WINDOW 12
 
 /* Minimum number of points for which pippenger_wnaf is faster than strauss wnaf */
+#ifndef ECMULT_PIPPENGER_THRESHOLD
 #define ECMULT_PIPPENGER_THRESHOLD 88
+#endif
+
+/* For each bucket_window from 1 to PIPPENGER_MAX_BUCKET_WINDOW - 1, the maximum
+ * number of points for which it is optimal. A window whose limit equals that of
+ * the previous window is never used. Both this and ECMULT_PIPPENGER_THRESHOLD
+ * can be overridden with values measured on the target machine. */
+#ifndef ECMULT_PIPPENGER_WINDOW_LIMITS
+#define ECMULT_PIPPENGER_WINDOW_LIMITS 1, 4, 20, 57, 136, 235, 1260, 1260, 4420, 7880, 16050
+#endif
 
 #define ECMULT_MAX_POINTS_PER_BATCH 5000000
 
@@ -247,6 +264,8 @@ static void rustsecp256k1_v0_11_ecmult_strauss_wnaf(const struct rustsecp256k1_v
     int bits = 0;
     size_t np;
     size_t no = 0;
+    const rustsecp256k1_v0_11_ge_storage *pre_g = SECP256K1_ECMULT_PRE_G;
+    const rustsecp256k1_v0_11_ge_storage *pre_g_128 = SECP256K1_ECMULT_PRE_G_128;
 
     rustsecp256k1_v0_11_fe_set_int(&Z, 1);
     for (np = 0; np < num; ++np) {
@@ -332,11 +351,11 @@ static void rustsecp256k1_v0_11_ecmult_strauss_wnaf(const struct rustsecp256k1_v
             }
         }
         if (i < bits_ng_1 && (n = wnaf_ng_1[i])) {
-            rustsecp256k1_v0_11_ecmult_table_get_ge_storage(&tmpa, rustsecp256k1_v0_11_pre_g, n, WINDOW_G);
+            rustsecp256k1_v0_11_ecmult_table_get_ge_storage(&tmpa, pre_g, n, WINDOW_G);
             rustsecp256k1_v0_11_gej_add_zinv_var(r, r, &tmpa, &Z);
         }
         if (i < bits_ng_128 && (n = wnaf_ng_128[i])) {
-            rustsecp256k1_v0_11_ecmult_table_get_ge_storage(&tmpa, rustsecp256k1_v0_11_pre_g_128, n, WINDOW_G);
+            rustsecp256k1_v0_11_ecmult_table_get_ge_storage(&tmpa, pre_g_128, n, WINDOW_G);
             rustsecp256k1_v0_11_gej_add_zinv_var(r, r, &tmpa, &Z);
         }
     }
@@ -352,10 +371,12 @@ static void rustsecp256k1_v0_11_ecmult(rustsecp256k1_v0_11_gej *r, const rustsec
     struct rustsecp256k1_v0_11_strauss_point_state ps[1];
     struct rustsecp256k1_v0_11_strauss_state state;
 
+    SECP256K1_STATS_BEGIN(SECP256K1_STATS_ECMULT);
     state.aux = aux;
     state.pre_a = pre_a;
     state.ps = ps;
     rustsecp256k1_v0_11_ecmult_strauss_wnaf(&state, r, 1, a, na, ng);
+    SECP256K1_STATS_END(SECP256K1_STATS_ECMULT);
 }
 
 static size_t rustsecp256k1_v0_11_strauss_scratch_size(size_t n_points) {
@@ -574,53 +595,30 @@ static int rustsecp256k1_v0_11_ecmult_pippenger_wnaf(rustsecp256k1_v0_11_gej *bu
     return 1;
 }
 
+static const size_t rustsecp256k1_v0_11_pippenger_window_limits[PIPPENGER_MAX_BUCKET_WINDOW - 1] = { ECMULT_PIPPENGER_WINDOW_LIMITS };
+
 /**
  * Returns optimal bucket_window (number of bits of a scalar represented by a
  * set of buckets) for a given number of points.
  */
 static int rustsecp256k1_v0_11_pippenger_bucket_window(size_t n) {
-    if (n <= 1) {
-        return 1;
-    } else if (n <= 4) {
-        return 2;
-    } else if (n <= 20) {
-        return 3;
-    } else if (n <= 57) {
-        return 4;
-    } else if (n <= 136) {
-        return 5;
-    } else if (n <= 235) {
-        return 6;
-    } else if (n <= 1260) {
-        return 7;
-    } else if (n <= 4420) {
-        return 9;
-    } else if (n <= 7880) {
-        return 10;
-    } else if (n <= 16050) {
-        return 11;
-    } else {
-        return PIPPENGER_MAX_BUCKET_WINDOW;
+    int i;
+    for (i = 0; i < PIPPENGER_MAX_BUCKET_WINDOW - 1; i++) {
+        if (n <= rustsecp256k1_v0_11_pippenger_window_limits[i]) {
+            return i + 1;
+        }
     }
+    return PIPPENGER_MAX_BUCKET_WINDOW;
 }
 
 /**
  * Returns the maximum optimal number of points for a bucket_window.
  */
 static size_t rustsecp256k1_v0_11_pippenger_bucket_window_inv(int bucket_window) {
-    switch(bucket_window) {
-        case 1: return 1;
-        case 2: return 4;
-        case 3: return 20;
-        case 4: return 57;
-        case 5: return 136;
-        case 6: return 235;
-        case 7: return 1260;
-        case 8: return 1260;
-        case 9: return 4420;
-        case 10: return 7880;
-        case 11: return 16050;
-        case PIPPENGER_MAX_BUCKET_WINDOW: return SIZE_MAX;
+    if (bucket_window >= 1 && bucket_window < PIPPENGER_MAX_BUCKET_WINDOW) {
+        return rustsecp256k1_v0_11_pippenger_window_limits[bucket_window - 1];
+    } else if (bucket_window == PIPPENGER_MAX_BUCKET_WINDOW) {
+        return SIZE_MAX;
     }
     return 0;
 }
@@ -811,6 +809,7 @@ static int rustsecp256k1_v0_11_ecmult_multi_var(const rustsecp256k1_v0_11_callba
     size_t n_batches;
     size_t n_batch_points;
 
+    SECP256K1_STATS_COUNT(SECP256K1_STATS_ECMULT_MULTI);
     rustsecp256k1_v0_11_gej_set_infinity(r);
     if (inp_g_sc == NULL && n == 0) {
         return 1;
@@ -480,20 +480,24 @@ static void rustsecp256k1_v0_11_fe_impl_inv(rustsecp256k1_v0_11_fe *r, const rus
     rustsecp256k1_v0_11_fe tmp = *x;
     rustsecp256k1_v0_11_modinv64_signed62 s;
 
+    SECP256K1_STATS_BEGIN(SECP256K1_STATS_FE_INV);
     rustsecp256k1_v0_11_fe_normalize(&tmp);
     rustsecp256k1_v0_11_fe_to_signed62(&s, &tmp);
     rustsecp256k1_v0_11_modinv64(&s, &rustsecp256k1_v0_11_const_modinfo_fe);
     rustsecp256k1_v0_11_fe_from_signed62(r, &s);
+    SECP256K1_STATS_END(SECP256K1_STATS_FE_INV);
 }
 
 static void rustsecp256k1_v0_11_fe_impl_inv_var(rustsecp256k1_v0_11_fe *r, const rustsecp256k1_v0_11_fe *x) {
     rustsecp256k1_v0_11_fe tmp = *x;
     rustsecp256k1_v0_11_modinv64_signed62 s;
 
+    SECP256K1_STATS_BEGIN(SECP256K1_STATS_FE_INV_VAR);
     rustsecp256k1_v0_11_fe_normalize_var(&tmp);
     rustsecp256k1_v0_11_fe_to_signed62(&s, &tmp);
     rustsecp256k1_v0_11_modinv64_var(&s, &rustsecp256k1_v0_11_const_modinfo_fe);
     rustsecp256k1_v0_11_fe_from_signed62(r, &s);
+    SECP256K1_STATS_END(SECP256K1_STATS_FE_INV_VAR);
 }
 
 static int rustsecp256k1_v0_11_fe_impl_is_square_var(const rustsecp256k1_v0_11_fe *x) {
@@ -501,6 +505,7 @@ static int rustsecp256k1_v0_11_fe_impl_is_square_var(const rustsecp256k1_v0_11_f
     rustsecp256k1_v0_11_modinv64_signed62 s;
     int jac, ret;
 
+    SECP256K1_STATS_COUNT(SECP256K1_STATS_FE_IS_SQUARE_VAR);
     tmp = *x;
     rustsecp256k1_v0_11_fe_normalize_var(&tmp);
     /* rustsecp256k1_v0_11_jacobi64_maybe_var cannot deal with input 0. */
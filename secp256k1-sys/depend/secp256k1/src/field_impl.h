@@ -47,6 +47,7 @@ static int rustsecp256k1_v0_11_fe_sqrt(rustsecp256k1_v0_11_fe * SECP256K1_RESTRI
     rustsecp256k1_v0_11_fe x2, x3, x6, x9, x11, x22, x44, x88, x176, x220, x223, t1;
     int j, ret;
 
+    SECP256K1_STATS_BEGIN(SECP256K1_STATS_FE_SQRT);
     VERIFY_CHECK(r != a);
     SECP256K1_FE_VERIFY(a);
     SECP256K1_FE_VERIFY_MAGNITUDE(a, 8);
@@ -142,6 +143,7 @@ static int rustsecp256k1_v0_11_fe_sqrt(rustsecp256k1_v0_11_fe * SECP256K1_RESTRI
         VERIFY_CHECK(rustsecp256k1_v0_11_fe_equal(&t1, a));
     }
 #endif
+    SECP256K1_STATS_END(SECP256K1_STATS_FE_SQRT);
     return ret;
 }
 
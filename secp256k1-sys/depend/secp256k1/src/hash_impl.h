@@ -45,6 +45,7 @@ static void rustsecp256k1_v0_11_sha256_transform(uint32_t* s, const unsigned cha
     uint32_t a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
     uint32_t w0, w1, w2, w3, w4, w5, w6, w7, w8, w9, w10, w11, w12, w13, w14, w15;
 
+    SECP256K1_STATS_BEGIN(SECP256K1_STATS_SHA256_TRANSFORM);
     Round(a, b, c, d, e, f, g, h, 0x428a2f98,  w0 = rustsecp256k1_v0_11_read_be32(&buf[0]));
     Round(h, a, b, c, d, e, f, g, 0x71374491,  w1 = rustsecp256k1_v0_11_read_be32(&buf[4]));
     Round(g, h, a, b, c, d, e, f, 0xb5c0fbcf,  w2 = rustsecp256k1_v0_11_read_be32(&buf[8]));
@@ -121,6 +122,7 @@ static void rustsecp256k1_v0_11_sha256_transform(uint32_t* s, const unsigned cha
     s[5] += f;
     s[6] += g;
     s[7] += h;
+    SECP256K1_STATS_END(SECP256K1_STATS_SHA256_TRANSFORM);
 }
 
 static void rustsecp256k1_v0_11_sha256_write(rustsecp256k1_v0_11_sha256 *hash, const unsigned char *data, size_t len) {
@@ -19,6 +19,14 @@
 #include <Windows.h>
 #endif
 
+/* Hooks for operation counters. Unless the including code defines them beforehand
+ * (see secp256k1-sys/ext/instrumentation.h), they expand to nothing. */
+#ifndef SECP256K1_STATS_COUNT
+#define SECP256K1_STATS_COUNT(stat)
+#define SECP256K1_STATS_BEGIN(stat)
+#define SECP256K1_STATS_END(stat)
+#endif
+
 #define STR_(x) #x
 #define STR(x) STR_(x)
 #define DEBUG_CONFIG_MSG(x) "DEBUG_CONFIG: " x
@@ -0,0 +1,54 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+/* Helpers for the modules which check many equations of the form
+ * sum(points) = scalar*G at once. Each equation i is multiplied by a
+ * randomizer a_i derived from a hash of the whole batch (a_0 = 1), and the
+ * sum of the randomized equations is checked with a single call to
+ * rustsecp256k1_v0_11_ecmult_multi_var. The randomizers must be unpredictable
+ * to whoever chose the inputs, so every input goes into the hash. Included
+ * after the library. */
+
+#ifndef SECP256K1_EXT_BATCH_IMPL_H
+#define SECP256K1_EXT_BATCH_IMPL_H
+
+/* The points and scalars of the multi-scalar multiplication, prepared up front. */
+typedef struct {
+    const rustsecp256k1_v0_11_ge *points;
+    const rustsecp256k1_v0_11_scalar *scalars;
+} rustsecp256k1_v0_11_ext_batch_data;
+
+static int rustsecp256k1_v0_11_ext_batch_callback(rustsecp256k1_v0_11_scalar *sc, rustsecp256k1_v0_11_ge *pt, size_t idx, void *data) {
+    const rustsecp256k1_v0_11_ext_batch_data *d = (const rustsecp256k1_v0_11_ext_batch_data *)data;
+    *sc = d->scalars[idx];
+    *pt = d->points[idx];
+    return 1;
+}
+
+/* Writes n as 8 little-endian bytes to sha. */
+static void rustsecp256k1_v0_11_ext_batch_write_le64(rustsecp256k1_v0_11_sha256 *sha, size_t n) {
+    unsigned char buf[8];
+    size_t j;
+
+    for (j = 0; j < 8; j++) {
+        buf[j] = (unsigned char)(n >> (8 * j));
+    }
+    rustsecp256k1_v0_11_sha256_write(sha, buf, 8);
+}
+
+/* Sets a to the i-th randomizer for the batch hashed into seed. */
+static void rustsecp256k1_v0_11_ext_batch_randomizer(rustsecp256k1_v0_11_scalar *a, const unsigned char *seed, size_t i) {
+    rustsecp256k1_v0_11_sha256 sha;
+    unsigned char buf[32];
+
+    if (i == 0) {
+        *a = rustsecp256k1_v0_11_scalar_one;
+        return;
+    }
+    rustsecp256k1_v0_11_sha256_initialize(&sha);
+    rustsecp256k1_v0_11_sha256_write(&sha, seed, 32);
+    rustsecp256k1_v0_11_ext_batch_write_le64(&sha, i);
+    rustsecp256k1_v0_11_sha256_finalize(&sha, buf);
+    rustsecp256k1_v0_11_scalar_set_b32(a, buf, NULL);
+}
+
+#endif /* SECP256K1_EXT_BATCH_IMPL_H */
@@ -0,0 +1,17 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+/* Helpers shared by the headers which secp256k1_ext.c includes ahead of the
+ * library. Nothing of the library itself is declared at that point. */
+
+#ifndef SECP256K1_EXT_UTIL_H
+#define SECP256K1_EXT_UTIL_H
+
+#if defined(_MSC_VER)
+#  define SECP256K1_EXT_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+#  define SECP256K1_EXT_THREAD_LOCAL __thread
+#else
+#  define SECP256K1_EXT_THREAD_LOCAL _Thread_local
+#endif
+
+#endif /* SECP256K1_EXT_UTIL_H */
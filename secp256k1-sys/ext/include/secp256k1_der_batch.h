@@ -0,0 +1,72 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_DER_BATCH_H
+#define SECP256K1_DER_BATCH_H
+
+#include "secp256k1.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bulk versions of rustsecp256k1_v0_11_ecdsa_signature_parse_der (or the lax parser in
+ * contrib/lax_der_parsing.h) and rustsecp256k1_v0_11_ecdsa_signature_serialize_der for
+ * signatures stored in one buffer. The results are identical to calling the single
+ * functions once per signature. */
+
+/** Parse n DER signatures from one buffer.
+ *
+ *  Signatures in the canonical shape produced by every DER encoder are checked
+ *  by a fast path; anything else is passed on to the full parser.
+ *
+ *  Returns: the number of signatures that were parsed successfully
+ *  Args:    ctx:      pointer to a context object
+ *  Out:     sigs:     pointer to an array of n signatures. Signatures that could
+ *                     not be parsed are zeroed.
+ *           valid:    pointer to an array of n bytes, set to 1 for each signature
+ *                     that was parsed successfully and to 0 otherwise
+ *  In:      input:    pointer to the buffer holding the encodings
+ *           offsets:  pointer to an array of n offsets into input
+ *           lengths:  pointer to an array of n lengths; signature i is the
+ *                     lengths[i] bytes starting at input + offsets[i]
+ *           n:        the number of signatures
+ *           lax:      if non-zero, parse as rustsecp256k1_v0_11_ecdsa_signature_parse_der_lax
+ *                     does instead of as strict DER
+ */
+SECP256K1_API size_t rustsecp256k1_v0_11_ecdsa_signature_parse_der_batch(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_ecdsa_signature *sigs,
+    unsigned char *valid,
+    const unsigned char *input,
+    const size_t *offsets,
+    const size_t *lengths,
+    size_t n,
+    int lax
+) SECP256K1_ARG_NONNULL(1);
+
+/** Serialize n signatures in DER format, back to back.
+ *
+ *  Returns: 1 if output was large enough (72 * n bytes always are), 0 otherwise
+ *  Args:    ctx:        pointer to a context object
+ *  Out:     output:     pointer to the buffer to write the encodings to
+ *           offsets:    pointer to an array of n + 1 offsets; signature i is
+ *                       written to output[offsets[i]] .. output[offsets[i + 1] - 1]
+ *  In/Out:  outputlen:  pointer to the length of output; set to the number of
+ *                       bytes written on success
+ *  In:      sigs:       pointer to an array of n signatures
+ *           n:          the number of signatures
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_ecdsa_signature_serialize_der_batch(
+    const rustsecp256k1_v0_11_context *ctx,
+    unsigned char *output,
+    size_t *outputlen,
+    size_t *offsets,
+    const rustsecp256k1_v0_11_ecdsa_signature *sigs,
+    size_t n
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SECP256K1_DER_BATCH_H */
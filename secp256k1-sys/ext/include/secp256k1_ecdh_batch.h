@@ -0,0 +1,51 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_ECDH_BATCH_H
+#define SECP256K1_ECDH_BATCH_H
+
+#include "secp256k1.h"
+#include "secp256k1_ecdh.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Compute EC Diffie-Hellman secrets of one secret key with many public keys
+ *
+ *  The result is identical to calling rustsecp256k1_v0_11_ecdh once per public
+ *  key, but the scalar is recoded only once and the resulting points are
+ *  normalized with a single field inversion per chunk of points. The
+ *  computation is constant time in the scalar (it is variable time only in
+ *  the number of points).
+ *
+ *  Returns: 1: all exponentiations were successful
+ *           0: scalar was invalid (zero or overflow) or hashfp returned 0 for
+ *              at least one point
+ *  Args:    ctx:        pointer to a context object.
+ *  Out:     output:     pointer to an array of n_pubkeys * outputlen bytes. The
+ *                       i-th output of hashfp is written to output + i * outputlen.
+ *  In:      outputlen:  the number of bytes written by hashfp per point (32 for
+ *                       rustsecp256k1_v0_11_ecdh_hash_function_sha256).
+ *           pubkeys:    pointer to an array of n_pubkeys initialized public keys.
+ *           n_pubkeys:  the number of public keys.
+ *           seckey:     a 32-byte scalar with which to multiply the points.
+ *           hashfp:     pointer to a hash function. If NULL,
+ *                       rustsecp256k1_v0_11_ecdh_hash_function_sha256 is used.
+ *           data:       arbitrary data pointer that is passed through to hashfp.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_ecdh_batch(
+  const rustsecp256k1_v0_11_context *ctx,
+  unsigned char *output,
+  size_t outputlen,
+  const rustsecp256k1_v0_11_pubkey *pubkeys,
+  size_t n_pubkeys,
+  const unsigned char *seckey,
+  rustsecp256k1_v0_11_ecdh_hash_function hashfp,
+  void *data
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(6);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SECP256K1_ECDH_BATCH_H */
@@ -0,0 +1,62 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_ECDSA_PRESIGN_H
+#define SECP256K1_ECDSA_PRESIGN_H
+
+#include "secp256k1.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Precompute the nonce part of an ECDSA signature.
+ *
+ *  Computes R = k*G and stores r = R.x mod n and k^-1 in presig64, so that a
+ *  later rustsecp256k1_v0_11_ecdsa_presignature_sign needs neither the
+ *  multiplication with G nor the inversion. The nonce must be uniformly random
+ *  and secret, and every presignature must be used at most once: two
+ *  signatures with the same presignature reveal the secret key.
+ *
+ *  Returns: 1: the presignature was created
+ *           0: the nonce was zero or not below the group order; presig64 is
+ *              zeroed
+ *  Args:    ctx:       pointer to a context object, initialized for signing
+ *  Out:     presig64:  pointer to a 64-byte array for the presignature
+ *  In:      nonce32:   pointer to a 32-byte random nonce
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_ecdsa_presignature_create(
+    const rustsecp256k1_v0_11_context *ctx,
+    unsigned char *presig64,
+    const unsigned char *nonce32
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+/** Create a low-S ECDSA signature with a presignature.
+ *
+ *  Computes s = k^-1*(m + r*x) in constant time. The presignature is zeroed
+ *  before anything else, so that it cannot be used again, and a zeroed
+ *  presignature is rejected.
+ *
+ *  Returns: 1: the signature was created
+ *           0: the presignature or the secret key was invalid; the signature
+ *              is zeroed
+ *  Args:    ctx:        pointer to a context object
+ *  Out:     sig:        pointer to a signature object
+ *  In/Out:  presig64:   pointer to a presignature from
+ *                       rustsecp256k1_v0_11_ecdsa_presignature_create, zeroed
+ *                       on return
+ *  In:      msghash32:  the 32-byte message hash being signed
+ *           seckey:     pointer to a 32-byte secret key
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_ecdsa_presignature_sign(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_ecdsa_signature *sig,
+    unsigned char *presig64,
+    const unsigned char *msghash32,
+    const unsigned char *seckey
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SECP256K1_ECDSA_PRESIGN_H */
@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_ECMULT_TUNE_H
+#define SECP256K1_ECMULT_TUNE_H
+
+#include "secp256k1.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Entry points for measuring the multi-scalar multiplication algorithms.
+ *
+ *  The library picks between Strauss' and Pippenger's algorithm, and the
+ *  bucket window of the latter, from the number of points, using the tables
+ *  ECMULT_PIPPENGER_THRESHOLD and ECMULT_PIPPENGER_WINDOW_LIMITS in
+ *  ecmult_impl.h. These functions run one algorithm with a forced window so
+ *  that the crossovers can be measured on the target machine, see
+ *  benches/ecmult_tune.rs in the secp256k1 crate. They are not meant for
+ *  production use.
+ */
+
+/** Return the scratch memory needed by rustsecp256k1_v0_11_ecmult_multi_tune.
+ *
+ *  Returns: the number of bytes, or 0 if bucket_window is out of range
+ *  In:      n:              the number of points
+ *           bucket_window:  0 for Strauss' algorithm, otherwise the Pippenger
+ *                           bucket window (1 to 12)
+ */
+SECP256K1_API size_t rustsecp256k1_v0_11_ecmult_multi_tune_scratch_size(
+    size_t n,
+    int bucket_window
+);
+
+/** Compute sum(scalars[i]*points[i]) with the given algorithm.
+ *
+ *  Returns: 1 if the result is a valid public key
+ *           0 if the scratch memory is too small, the arguments are invalid,
+ *             or the result is the point at infinity
+ *  Args:    ctx:            pointer to a context object
+ *  Out:     result:         pointer to a public key
+ *  In:      scratch_mem:    pointer to scratch memory of the size returned by
+ *                           rustsecp256k1_v0_11_ecmult_multi_tune_scratch_size
+ *           scratch_size:   size of scratch_mem in bytes
+ *           bucket_window:  0 for Strauss' algorithm, otherwise the Pippenger
+ *                           bucket window (1 to 12)
+ *           scalars32:      pointer to n concatenated 32-byte big-endian scalars
+ *           points:         pointer to n public keys
+ *           n:              the number of points
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_ecmult_multi_tune(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_pubkey *result,
+    void *scratch_mem,
+    size_t scratch_size,
+    int bucket_window,
+    const unsigned char *scalars32,
+    const rustsecp256k1_v0_11_pubkey *points,
+    size_t n
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SECP256K1_ECMULT_TUNE_H */
@@ -0,0 +1,91 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_ELLSWIFT_BATCH_H
+#define SECP256K1_ELLSWIFT_BATCH_H
+
+#include "secp256k1.h"
+#include "secp256k1_ellswift.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Batched versions of the functions in secp256k1_ellswift.h. Each produces
+ * exactly the same results as calling the corresponding single function once
+ * per element, but the field inversions of all elements in a chunk are shared
+ * (Montgomery's trick), and the whole batch is processed in a single call. */
+
+/** Decode n 64-byte ElligatorSwift encodings into public keys.
+ *
+ *  Returns: always 1
+ *  Args:    ctx:      pointer to a context object
+ *  Out:     pubkeys:  pointer to an array of n public keys
+ *  In:      ell64s:   pointer to n concatenated 64-byte encodings
+ *           n:        the number of encodings
+ */
+SECP256K1_API int rustsecp256k1_v0_11_ellswift_decode_batch(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_pubkey *pubkeys,
+    const unsigned char *ell64s,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
+/** Compute ElligatorSwift public keys for n secret keys.
+ *
+ *  Equivalent to rustsecp256k1_v0_11_ellswift_create for each key; the public keys are
+ *  brought to affine coordinates with a single constant-time inversion per chunk.
+ *
+ *  Returns: 1: all secret keys were valid
+ *           0: at least one secret key was invalid; its encoding is zeroed
+ *  Args:    ctx:        pointer to a context object with ecmult_gen built
+ *  Out:     ell64s:     pointer to n * 64 bytes for the encodings
+ *  In:      seckeys32:  pointer to n concatenated 32-byte secret keys
+ *           auxrnd32s:  pointer to n concatenated 32-byte values of auxiliary
+ *                       randomness, or NULL (see rustsecp256k1_v0_11_ellswift_create)
+ *           n:          the number of secret keys
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_ellswift_create_batch(
+    const rustsecp256k1_v0_11_context *ctx,
+    unsigned char *ell64s,
+    const unsigned char *seckeys32,
+    const unsigned char *auxrnd32s,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
+/** Compute n x-only ECDH shared secrets from ElligatorSwift encodings.
+ *
+ *  Element i is equivalent to rustsecp256k1_v0_11_ellswift_xdh(ctx, output + 32*i,
+ *  ell_a64s + 64*i, ell_b64s + 64*i, seckeys32 + 32*i, parties[i], hashfp, data).
+ *  The x coordinates of all shared points in a chunk are computed with a single
+ *  constant-time inversion.
+ *
+ *  Returns: 1: all secret keys were valid and hashfp returned 1 for every element
+ *           0: otherwise
+ *  Args:    ctx:        pointer to a context object
+ *  Out:     output:     pointer to n * 32 bytes for the hashfp outputs
+ *  In:      ell_a64s:   pointer to n concatenated encodings of the initiators
+ *           ell_b64s:   pointer to n concatenated encodings of the responders
+ *           seckeys32:  pointer to n concatenated 32-byte secret keys
+ *           parties:    pointer to n party values (0 if we are the initiator of
+ *                       element i, 1 if we are the responder)
+ *           n:          the number of elements
+ *           hashfp:     pointer to a hash function (as for ellswift_xdh)
+ *           data:       arbitrary data pointer passed through to hashfp
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_ellswift_xdh_batch(
+    const rustsecp256k1_v0_11_context *ctx,
+    unsigned char *output,
+    const unsigned char *ell_a64s,
+    const unsigned char *ell_b64s,
+    const unsigned char *seckeys32,
+    const int *parties,
+    size_t n,
+    rustsecp256k1_v0_11_ellswift_xdh_hash_function hashfp,
+    void *data
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(8);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SECP256K1_ELLSWIFT_BATCH_H */
@@ -0,0 +1,153 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_EXTRAKEYS_BATCH_H
+#define SECP256K1_EXTRAKEYS_BATCH_H
+
+#include "secp256k1.h"
+#include "secp256k1_extrakeys.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Return the scratch memory needed by rustsecp256k1_v0_11_xonly_pubkey_tweak_add_check_batch.
+ *
+ *  Returns: the number of bytes
+ *  In:      n:  the number of tweaks
+ */
+SECP256K1_API size_t rustsecp256k1_v0_11_xonly_pubkey_tweak_add_check_batch_scratch_size(
+    size_t n
+);
+
+/** Check n x-only public key tweaks at once, such as the commitments of
+ *  Taproot script path spends.
+ *
+ *  Checks the randomized sum of the equations (P_i - Q_i) + t_i*G = 0, where
+ *  Q_i is the tweaked key with the given parity, with a single multi-scalar
+ *  multiplication of n points. The randomizers are derived from a hash of all
+ *  inputs. The result equals that of calling
+ *  rustsecp256k1_v0_11_xonly_pubkey_tweak_add_check for each tweak, except with
+ *  negligible probability, but it does not tell which tweaks are invalid.
+ *
+ *  Returns: 1: all tweaked keys are the result of tweaking their internal keys
+ *           0: at least one is not, or the scratch memory is too small
+ *  Args:    ctx:                  pointer to a context object
+ *  In:      scratch_mem:          pointer to scratch memory of the size returned by
+ *                                 rustsecp256k1_v0_11_xonly_pubkey_tweak_add_check_batch_scratch_size
+ *           scratch_size:         size of scratch_mem in bytes
+ *           tweaked_pubkey32s:    pointer to n concatenated 32-byte serialized tweaked keys
+ *           tweaked_pk_parities:  pointer to an array of n parities of the tweaked keys
+ *           internal_pubkeys:     pointer to an array of n x-only public keys to tweak
+ *           tweak32s:             pointer to n concatenated 32-byte tweaks
+ *           n:                    the number of tweaks
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_xonly_pubkey_tweak_add_check_batch(
+    const rustsecp256k1_v0_11_context *ctx,
+    void *scratch_mem,
+    size_t scratch_size,
+    const unsigned char *tweaked_pubkey32s,
+    const int *tweaked_pk_parities,
+    const rustsecp256k1_v0_11_xonly_pubkey *internal_pubkeys,
+    const unsigned char *tweak32s,
+    size_t n
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
+/** Tweak n x-only public keys: Q_i = P_i + t_i*G.
+ *
+ *  The result for each key is identical to rustsecp256k1_v0_11_xonly_pubkey_tweak_add
+ *  followed by rustsecp256k1_v0_11_xonly_pubkey_from_pubkey, but the tweaked keys
+ *  are brought to affine coordinates with a single field inversion per chunk.
+ *
+ *  Returns: 1: all keys were tweaked successfully
+ *           0: at least one internal key was invalid, or a tweak was out of range
+ *              or produced the point at infinity; the output keys and parities of
+ *              the affected keys are zeroed
+ *  Args:    ctx:                pointer to a context object
+ *  Out:     output_pubkeys:     pointer to an array of n x-only public keys
+ *           pk_parities:        pointer to an array of n parities of the output keys
+ *  In:      internal_pubkeys:   pointer to an array of n x-only public keys to tweak
+ *           tweaks32:           pointer to n concatenated 32-byte tweaks
+ *           n:                  the number of keys
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_xonly_pubkey_tweak_add_batch(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_xonly_pubkey *output_pubkeys,
+    int *pk_parities,
+    const rustsecp256k1_v0_11_xonly_pubkey *internal_pubkeys,
+    const unsigned char *tweaks32,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
+/** Compute n Taproot output keys (BIP341): Q_i = P_i + t_i*G with
+ *  t_i = hash_TapTweak(P_i || merkle_root_i).
+ *
+ *  Like rustsecp256k1_v0_11_xonly_pubkey_tweak_add_batch, but computes the tweaks,
+ *  starting every tagged hash from one precomputed midstate.
+ *
+ *  Returns: 1: all output keys were computed successfully
+ *           0: at least one internal key was invalid, or a tweak was out of range
+ *              or produced the point at infinity; the output keys and parities of
+ *              the affected keys are zeroed
+ *  Args:    ctx:                pointer to a context object
+ *  Out:     output_pubkeys:     pointer to an array of n x-only public keys
+ *           pk_parities:        pointer to an array of n parities of the output keys
+ *  In:      internal_pubkeys:   pointer to an array of n x-only internal keys
+ *           merkle_roots32:     pointer to n concatenated 32-byte script tree roots, or
+ *                               NULL if the outputs have no script path, in which case
+ *                               t_i = hash_TapTweak(P_i)
+ *           n:                  the number of keys
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_xonly_pubkey_taptweak_add_batch(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_xonly_pubkey *output_pubkeys,
+    int *pk_parities,
+    const rustsecp256k1_v0_11_xonly_pubkey *internal_pubkeys,
+    const unsigned char *merkle_roots32,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
+/** Return the scratch memory needed by rustsecp256k1_v0_11_keypair_import_check_batch.
+ *
+ *  Returns: the number of bytes
+ *  In:      n:  the number of key pairs
+ */
+SECP256K1_API size_t rustsecp256k1_v0_11_keypair_import_check_batch_scratch_size(
+    size_t n
+);
+
+/** Check that n stored public keys belong to their secret keys, such as the
+ *  key pairs of a wallet loaded from disk.
+ *
+ *  Checks the randomized sum of the equations P_i = x_i*G: the secret sum
+ *  sum(a_i*x_i) is multiplied with G in constant time, and the public sum
+ *  sum(a_i*P_i) with a single multi-scalar multiplication of n points. The
+ *  randomizers are derived from a hash of all inputs. The result equals that
+ *  of comparing the output of rustsecp256k1_v0_11_ec_pubkey_create with each
+ *  public key, except with negligible probability, but it does not tell which
+ *  key pairs are inconsistent.
+ *
+ *  Returns: 1: every public key is its secret key times G
+ *           0: at least one is not, a secret key is invalid, or the scratch memory
+ *              is too small
+ *  Args:    ctx:           pointer to a context object, initialized for signing
+ *  In:      scratch_mem:   pointer to scratch memory of the size returned by
+ *                          rustsecp256k1_v0_11_keypair_import_check_batch_scratch_size
+ *           scratch_size:  size of scratch_mem in bytes
+ *           seckeys32:     pointer to n concatenated 32-byte secret keys
+ *           pubkeys:       pointer to an array of n public keys
+ *           n:             the number of key pairs
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_keypair_import_check_batch(
+    const rustsecp256k1_v0_11_context *ctx,
+    void *scratch_mem,
+    size_t scratch_size,
+    const unsigned char *seckeys32,
+    const rustsecp256k1_v0_11_pubkey *pubkeys,
+    size_t n
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SECP256K1_EXTRAKEYS_BATCH_H */
@@ -0,0 +1,162 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_FIXED_BASE_H
+#define SECP256K1_FIXED_BASE_H
+
+#include "secp256k1.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Multiplication of a fixed point with precomputed comb tables.
+ *
+ *  Multiplying the generator is several times faster than multiplying any
+ *  other point because the library ships a precomputed table for it. These
+ *  functions build the same kind of signed-digit multi-comb table for an
+ *  arbitrary point at runtime, so that a point which is multiplied many times
+ *  (such as a key used for ECDH with many peers or a fixed commitment basis)
+ *  gets the same speedup.
+ *
+ *  A table for teeth t and blocks b holds b * 2^(t-1) points of 64 bytes each,
+ *  and a multiplication with it takes b * ceil(256 / (b * t)) point additions.
+ *  The library itself uses t = 6 and b = 11 (22 kB) for the generator. Teeth
+ *  must be between 1 and 8 and blocks between 1 and 256, and combinations for
+ *  which fewer teeth or blocks would need the same number of additions are
+ *  rejected, as the library does for its own table.
+ */
+
+/** Return the size in bytes of a table with the given parameters, or 0 if the
+ *  parameters are not supported.
+ *
+ *  In:      teeth:   the number of teeth of the comb
+ *           blocks:  the number of blocks of the comb
+ */
+SECP256K1_API size_t rustsecp256k1_v0_11_fixed_base_table_size(
+    unsigned int teeth,
+    unsigned int blocks
+);
+
+/** Compute the table for a point.
+ *
+ *  Returns: 1 on success, 0 if the parameters are not supported or the public
+ *           key is invalid
+ *  Args:    ctx:     pointer to a context object
+ *  Out:     table:   pointer to rustsecp256k1_v0_11_fixed_base_table_size(teeth,
+ *                    blocks) bytes of memory aligned to at least 8 bytes
+ *  In:      point:   pointer to the public key to be multiplied with the table
+ *           teeth:   the number of teeth of the comb
+ *           blocks:  the number of blocks of the comb
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_fixed_base_table_build(
+    const rustsecp256k1_v0_11_context *ctx,
+    void *table,
+    const rustsecp256k1_v0_11_pubkey *point,
+    unsigned int teeth,
+    unsigned int blocks
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+/** Multiply the point of a table with a scalar, in constant time.
+ *
+ *  The result is identical to rustsecp256k1_v0_11_ec_pubkey_tweak_mul of the
+ *  point. Neither the time taken nor the memory accessed depend on the scalar.
+ *  If ctx is a randomized signing context, its blinding value is used to
+ *  randomize the coordinates of the intermediate points as in signing.
+ *
+ *  Returns: 1 on success, 0 if the scalar is zero or not below the group order,
+ *           in which case the result is zeroed
+ *  Args:    ctx:       pointer to a context object
+ *  Out:     result:    pointer to a public key object for the product
+ *  In:      table:     pointer to a table built for the given parameters
+ *           teeth:     the number of teeth of the table
+ *           blocks:    the number of blocks of the table
+ *           scalar32:  pointer to a 32-byte big-endian scalar
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_fixed_base_mul(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_pubkey *result,
+    const void *table,
+    unsigned int teeth,
+    unsigned int blocks,
+    const unsigned char *scalar32
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(6);
+
+/** Multiply the point of a table with a public scalar, in variable time.
+ *
+ *  Like rustsecp256k1_v0_11_fixed_base_mul, but only reads the table entries
+ *  selected by the scalar, which makes it faster and leaks the scalar through
+ *  timing and memory access. Use it only for scalars which are not secret.
+ *
+ *  Returns: 1 on success, 0 if the scalar is zero or not below the group order,
+ *           in which case the result is zeroed
+ *  Args:    ctx:       pointer to a context object
+ *  Out:     result:    pointer to a public key object for the product
+ *  In:      table:     pointer to a table built for the given parameters
+ *           teeth:     the number of teeth of the table
+ *           blocks:    the number of blocks of the table
+ *           scalar32:  pointer to a 32-byte big-endian scalar
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_fixed_base_mul_var(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_pubkey *result,
+    const void *table,
+    unsigned int teeth,
+    unsigned int blocks,
+    const unsigned char *scalar32
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(6);
+
+/** Serialize the entries of a table.
+ *
+ *  The in-memory layout of a table depends on the platform. The serialization
+ *  is portable: it consists of the 32-byte big-endian x and y coordinates of
+ *  every entry, so it takes 64 * blocks * 2^(teeth-1) bytes.
+ *
+ *  Returns: 1 on success, 0 if the parameters are not supported
+ *  Args:    ctx:     pointer to a context object
+ *  Out:     output:  pointer to the serialization
+ *  In:      table:   pointer to a table built for the given parameters
+ *           teeth:   the number of teeth of the table
+ *           blocks:  the number of blocks of the table
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_fixed_base_table_serialize(
+    const rustsecp256k1_v0_11_context *ctx,
+    unsigned char *output,
+    const void *table,
+    unsigned int teeth,
+    unsigned int blocks
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+/** Parse a serialized table.
+ *
+ *  Every entry is checked to be a point on the curve, and the first block of
+ *  entries is recomputed from the point and compared, which rejects the table
+ *  of another point and catches most corruption cheaply. The other entries are
+ *  not checked against the point: a table built from a tampered serialization
+ *  can still yield wrong products. Only parse serializations from trusted
+ *  storage.
+ *
+ *  Returns: 1 on success, 0 if the parameters are not supported, the public key
+ *           is invalid, an entry is not a point on the curve or the first block
+ *           does not belong to the point
+ *  Args:    ctx:     pointer to a context object
+ *  Out:     table:   pointer to rustsecp256k1_v0_11_fixed_base_table_size(teeth,
+ *                    blocks) bytes of memory aligned to at least 8 bytes
+ *  In:      input:   pointer to the serialization
+ *           point:   pointer to the public key the table was built for
+ *           teeth:   the number of teeth of the table
+ *           blocks:  the number of blocks of the table
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_fixed_base_table_parse(
+    const rustsecp256k1_v0_11_context *ctx,
+    void *table,
+    const unsigned char *input,
+    const rustsecp256k1_v0_11_pubkey *point,
+    unsigned int teeth,
+    unsigned int blocks
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SECP256K1_FIXED_BASE_H */
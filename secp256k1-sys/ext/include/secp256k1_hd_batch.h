@@ -0,0 +1,42 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_HD_BATCH_H
+#define SECP256K1_HD_BATCH_H
+
+#include "secp256k1.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Derive many children of one public key: children[i] = parent + tweaks[i]*G.
+ *
+ *  This is the point arithmetic of BIP32 non-hardened public child derivation,
+ *  where tweaks[i] is the left half of the HMAC-SHA512 output for child i. The
+ *  result for each child is identical to rustsecp256k1_v0_11_ec_pubkey_tweak_add
+ *  on a copy of the parent, but the parent is parsed only once and the children
+ *  are brought to affine coordinates with a single field inversion per chunk.
+ *
+ *  Returns: 1: all children were derived successfully
+ *           0: the parent was invalid, or at least one tweak was out of range or
+ *              produced the point at infinity (BIP32 says such indices must be
+ *              skipped); the public keys of the affected children are zeroed
+ *  Args:    ctx:       pointer to a context object with ecmult_gen built
+ *  Out:     children:  pointer to an array of n public keys
+ *  In:      parent:    pointer to the parent public key
+ *           tweaks32:  pointer to n concatenated 32-byte tweaks
+ *           n:         the number of children
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_ec_pubkey_derive_batch(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_pubkey *children,
+    const rustsecp256k1_v0_11_pubkey *parent,
+    const unsigned char *tweaks32,
+    size_t n
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(3);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SECP256K1_HD_BATCH_H */
@@ -0,0 +1,39 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_INSTRUMENTATION_H
+#define SECP256K1_INSTRUMENTATION_H
+
+#include "secp256k1.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Copy the calling thread's operation counters.
+ *
+ *  Only available when the library is compiled with ENABLE_INSTRUMENTATION.
+ *  Index i of the output arrays corresponds to the SECP256K1_STATS_* constant
+ *  with value i (see ext/instrumentation.h); at most n entries are written.
+ *
+ *  Returns: 1 if cycle counts were written, 0 if the build does not measure cycles
+ *           (in which case cycles is left untouched)
+ *  Out:     counts:  pointer to an array of n counters
+ *           cycles:  pointer to an array of n cycle totals (can be NULL)
+ *  In:      n:       the number of entries to copy
+ */
+SECP256K1_API int rustsecp256k1_v0_11_stats_snapshot(
+    uint64_t *counts,
+    uint64_t *cycles,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
+/** Reset the calling thread's operation counters to zero. */
+SECP256K1_API void rustsecp256k1_v0_11_stats_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SECP256K1_INSTRUMENTATION_H */
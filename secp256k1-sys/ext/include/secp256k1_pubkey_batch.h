@@ -0,0 +1,60 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_PUBKEY_BATCH_H
+#define SECP256K1_PUBKEY_BATCH_H
+
+#include "secp256k1.h"
+#include "secp256k1_extrakeys.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Decompress n public keys stored as x coordinates and a bitmap of y parities.
+ *
+ *  The result for key i is identical to rustsecp256k1_v0_11_ec_pubkey_parse of the
+ *  compressed serialization with prefix 0x03 if bit offset + i of odd_bitmap is
+ *  set (bits are numbered from the least significant bit of each byte) and 0x02
+ *  otherwise, but the keys do not need to be laid out as serializations.
+ *
+ *  Returns: 1: all keys were decompressed
+ *           0: at least one x coordinate is not on the curve; the public keys
+ *              of the affected keys are zeroed
+ *  Args:    ctx:         pointer to a context object
+ *  Out:     pubkeys:     pointer to an array of n public keys
+ *  In:      x32s:        pointer to n concatenated 32-byte x coordinates
+ *           odd_bitmap:  pointer to the parity bitmap
+ *           offset:      the bit of odd_bitmap that belongs to the first key
+ *           n:           the number of keys
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_ec_pubkey_decompress_batch(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_pubkey *pubkeys,
+    const unsigned char *x32s,
+    const unsigned char *odd_bitmap,
+    size_t offset,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
+/** Parse n 32-byte x-only public keys, like rustsecp256k1_v0_11_xonly_pubkey_parse.
+ *
+ *  Returns: 1: all keys were parsed
+ *           0: at least one x coordinate is not on the curve; the public keys
+ *              of the affected keys are zeroed
+ *  Args:    ctx:      pointer to a context object
+ *  Out:     pubkeys:  pointer to an array of n x-only public keys
+ *  In:      x32s:     pointer to n concatenated 32-byte x coordinates
+ *           n:        the number of keys
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_xonly_pubkey_parse_batch(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_xonly_pubkey *pubkeys,
+    const unsigned char *x32s,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SECP256K1_PUBKEY_BATCH_H */
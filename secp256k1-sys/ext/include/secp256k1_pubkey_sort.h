@@ -0,0 +1,49 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_PUBKEY_SORT_H
+#define SECP256K1_PUBKEY_SORT_H
+
+#include "secp256k1.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Return the scratch memory needed by rustsecp256k1_v0_11_ec_pubkey_sort_scratch.
+ *
+ *  Returns: the number of bytes
+ *  In:      n_pubkeys:  the number of public keys
+ */
+SECP256K1_API size_t rustsecp256k1_v0_11_ec_pubkey_sort_scratch_size(
+    size_t n_pubkeys
+);
+
+/** Sort public keys like rustsecp256k1_v0_11_ec_pubkey_sort, serializing each only once.
+ *
+ *  rustsecp256k1_v0_11_ec_pubkey_sort serializes both keys in every comparison. This
+ *  function serializes every key once into scratch memory, distributes the
+ *  serializations into 512 buckets by their first two bytes and sorts each
+ *  bucket by comparing the serializations. The resulting order is the same.
+ *
+ *  Returns: 0 if the arguments are invalid. 1 otherwise.
+ *  Args:     ctx:           pointer to a context object
+ *  In:Out:   pubkeys:       array of pointers to public keys to sort
+ *  In:       n_pubkeys:     number of elements in the pubkeys array
+ *            scratch:       pointer to scratch memory of at least the size returned by
+ *                           rustsecp256k1_v0_11_ec_pubkey_sort_scratch_size, aligned
+ *                           for a pointer
+ *            scratch_size:  size of scratch in bytes
+ */
+SECP256K1_API int rustsecp256k1_v0_11_ec_pubkey_sort_scratch(
+    const rustsecp256k1_v0_11_context *ctx,
+    const rustsecp256k1_v0_11_pubkey **pubkeys,
+    size_t n_pubkeys,
+    void *scratch,
+    size_t scratch_size
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SECP256K1_PUBKEY_SORT_H */
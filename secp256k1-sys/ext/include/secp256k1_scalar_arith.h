@@ -0,0 +1,126 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_SCALAR_ARITH_H
+#define SECP256K1_SCALAR_ARITH_H
+
+#include "secp256k1.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Arithmetic modulo the group order.
+ *
+ *  These functions expose the scalar arithmetic of the library, so that
+ *  protocols which compute with scalars (such as threshold signing) do not have
+ *  to serialize and parse them around every operation. Except for
+ *  rustsecp256k1_v0_11_unpacked_scalar_inverse_var, they run in constant time.
+ */
+
+/** Opaque data structure that holds a scalar modulo the group order.
+ *
+ *  The exact representation is platform dependent, but it is reduced, so two
+ *  scalars are equal if and only if their data is. Use parse and serialize to
+ *  convert it to and from bytes. All functions accept their output pointer to
+ *  be equal to their input pointers.
+ */
+typedef struct rustsecp256k1_v0_11_unpacked_scalar {
+    unsigned char data[32];
+} rustsecp256k1_v0_11_unpacked_scalar;
+
+/** Parse a 32-byte big-endian scalar.
+ *
+ *  Returns: 1 if the value is below the group order, 0 otherwise, in which case
+ *           the scalar is set to zero
+ *  Args:    ctx:     pointer to a context object
+ *  Out:     scalar:  pointer to the parsed scalar
+ *  In:      input32: pointer to the 32-byte big-endian value
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_unpacked_scalar_parse(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_unpacked_scalar *scalar,
+    const unsigned char *input32
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+/** Serialize a scalar as 32 big-endian bytes.
+ *
+ *  Args:    ctx:      pointer to a context object
+ *  Out:     output32: pointer to 32 bytes for the serialization
+ *  In:      scalar:   pointer to the scalar
+ */
+SECP256K1_API void rustsecp256k1_v0_11_unpacked_scalar_serialize(
+    const rustsecp256k1_v0_11_context *ctx,
+    unsigned char *output32,
+    const rustsecp256k1_v0_11_unpacked_scalar *scalar
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+/** Compute r = a + b modulo the group order.
+ *
+ *  Args:    ctx:  pointer to a context object
+ *  Out:     r:    pointer to the sum
+ *  In:      a, b: pointers to the summands
+ */
+SECP256K1_API void rustsecp256k1_v0_11_unpacked_scalar_add(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_unpacked_scalar *r,
+    const rustsecp256k1_v0_11_unpacked_scalar *a,
+    const rustsecp256k1_v0_11_unpacked_scalar *b
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
+/** Compute r = a * b modulo the group order.
+ *
+ *  Args:    ctx:  pointer to a context object
+ *  Out:     r:    pointer to the product
+ *  In:      a, b: pointers to the factors
+ */
+SECP256K1_API void rustsecp256k1_v0_11_unpacked_scalar_mul(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_unpacked_scalar *r,
+    const rustsecp256k1_v0_11_unpacked_scalar *a,
+    const rustsecp256k1_v0_11_unpacked_scalar *b
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
+/** Compute r = -a modulo the group order.
+ *
+ *  Args:    ctx:  pointer to a context object
+ *  Out:     r:    pointer to the negation
+ *  In:      a:    pointer to the scalar to negate
+ */
+SECP256K1_API void rustsecp256k1_v0_11_unpacked_scalar_negate(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_unpacked_scalar *r,
+    const rustsecp256k1_v0_11_unpacked_scalar *a
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+/** Compute the multiplicative inverse r = 1/a modulo the group order.
+ *
+ *  Returns: 1 if a is nonzero, 0 if it is zero, in which case r is set to zero
+ *  Args:    ctx:  pointer to a context object
+ *  Out:     r:    pointer to the inverse
+ *  In:      a:    pointer to the scalar to invert
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_unpacked_scalar_inverse(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_unpacked_scalar *r,
+    const rustsecp256k1_v0_11_unpacked_scalar *a
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+/** Compute the multiplicative inverse like rustsecp256k1_v0_11_unpacked_scalar_inverse,
+ *  but faster and in variable time. Use it only for public scalars.
+ *
+ *  Returns: 1 if a is nonzero, 0 if it is zero, in which case r is set to zero
+ *  Args:    ctx:  pointer to a context object
+ *  Out:     r:    pointer to the inverse
+ *  In:      a:    pointer to the scalar to invert
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_unpacked_scalar_inverse_var(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_unpacked_scalar *r,
+    const rustsecp256k1_v0_11_unpacked_scalar *a
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SECP256K1_SCALAR_ARITH_H */
@@ -0,0 +1,57 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_SCHNORRSIG_BATCH_H
+#define SECP256K1_SCHNORRSIG_BATCH_H
+
+#include "secp256k1.h"
+#include "secp256k1_extrakeys.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Return the scratch memory needed by rustsecp256k1_v0_11_schnorrsig_verify_batch.
+ *
+ *  Returns: the number of bytes
+ *  In:      n:  the number of signatures
+ */
+SECP256K1_API size_t rustsecp256k1_v0_11_schnorrsig_verify_batch_scratch_size(
+    size_t n
+);
+
+/** Verify n Schnorr signatures at once.
+ *
+ *  Checks the randomized sum of the verification equations of all signatures
+ *  with a single multi-scalar multiplication of 2n points. The randomizers are
+ *  derived from a hash of all inputs. The result equals that of calling
+ *  rustsecp256k1_v0_11_schnorrsig_verify for each signature, except with negligible
+ *  probability, but it does not tell which signatures are invalid.
+ *
+ *  Returns: 1: all signatures are valid
+ *           0: at least one signature is invalid, or the scratch memory is too small
+ *  Args:    ctx:           pointer to a context object
+ *  In:      scratch_mem:   pointer to scratch memory of the size returned by
+ *                          rustsecp256k1_v0_11_schnorrsig_verify_batch_scratch_size
+ *           scratch_size:  size of scratch_mem in bytes
+ *           sig64s:        pointer to n concatenated 64-byte signatures
+ *           msgs:          pointer to an array of n pointers to messages
+ *           msglens:       pointer to an array of n message lengths
+ *           pubkeys:       pointer to an array of n x-only public keys
+ *           n:             the number of signatures
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_schnorrsig_verify_batch(
+    const rustsecp256k1_v0_11_context *ctx,
+    void *scratch_mem,
+    size_t scratch_size,
+    const unsigned char *sig64s,
+    const unsigned char * const *msgs,
+    const size_t *msglens,
+    const rustsecp256k1_v0_11_xonly_pubkey *pubkeys,
+    size_t n
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SECP256K1_SCHNORRSIG_BATCH_H */
@@ -0,0 +1,67 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_SCHNORRSIG_PRESIGN_H
+#define SECP256K1_SCHNORRSIG_PRESIGN_H
+
+#include "secp256k1.h"
+#include "secp256k1_extrakeys.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Precompute the nonce part of a BIP340 signature.
+ *
+ *  Computes R = k*G, negates k if R has an odd Y coordinate, and stores the
+ *  x coordinate of R and k in presig64, so that a later
+ *  rustsecp256k1_v0_11_schnorrsig_presignature_sign needs no multiplication with
+ *  G. The nonce must be uniformly random and secret, and every presignature
+ *  must be used at most once: two signatures with the same presignature reveal
+ *  the secret key.
+ *
+ *  Returns: 1: the presignature was created
+ *           0: the nonce was zero or not below the group order; presig64 is
+ *              zeroed
+ *  Args:    ctx:       pointer to a context object, initialized for signing
+ *  Out:     presig64:  pointer to a 64-byte array for the presignature
+ *  In:      nonce32:   pointer to a 32-byte random nonce
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_schnorrsig_presignature_create(
+    const rustsecp256k1_v0_11_context *ctx,
+    unsigned char *presig64,
+    const unsigned char *nonce32
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+/** Create a BIP340 signature with a presignature.
+ *
+ *  Computes the challenge e and s = k + e*x. The presignature is zeroed before
+ *  anything else, so that it cannot be used again, and a zeroed presignature
+ *  is rejected. The signature verifies like one from
+ *  rustsecp256k1_v0_11_schnorrsig_sign_custom, whose nonce is derived from the
+ *  key and message instead.
+ *
+ *  Returns: 1: the signature was created
+ *           0: the presignature or the key pair was invalid; sig64 is zeroed
+ *  Args:    ctx:       pointer to a context object
+ *  Out:     sig64:     pointer to a 64-byte array for the signature
+ *  In/Out:  presig64:  pointer to a presignature from
+ *                      rustsecp256k1_v0_11_schnorrsig_presignature_create, zeroed
+ *                      on return
+ *  In:      msg:       the message being signed, can be NULL if msglen is 0
+ *           msglen:    length of the message
+ *           keypair:   pointer to an initialized key pair
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_schnorrsig_presignature_sign(
+    const rustsecp256k1_v0_11_context *ctx,
+    unsigned char *sig64,
+    unsigned char *presig64,
+    const unsigned char *msg,
+    size_t msglen,
+    const rustsecp256k1_v0_11_keypair *keypair
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(6);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SECP256K1_SCHNORRSIG_PRESIGN_H */
@@ -0,0 +1,158 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_SILENTPAYMENTS_H
+#define SECP256K1_SILENTPAYMENTS_H
+
+#include "secp256k1.h"
+#include "secp256k1_extrakeys.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* This module implements BIP352 Silent Payments output scanning for a
+ * recipient, together with the sender side operation needed to construct a
+ * single output.
+ *
+ * Serialization of outpoints is left to the caller: outpoint_smallest36 is the
+ * lexicographically smallest of the transaction's outpoints, each serialized
+ * as the 32-byte txid followed by the 4-byte little-endian output index.
+ */
+
+/** Data about an output that belongs to the recipient.
+ *
+ *  output:           the x-only output public key found in the transaction.
+ *  tweak:            32-byte scalar t such that output = spend_pubkey + t*G
+ *                    (the spend secret key for the output is b_spend + t).
+ *  found_with_label: 1 if the output was paid to a labeled spend key, 0 otherwise.
+ *  label:            if found_with_label is 1, the label point (label_tweak*G).
+ */
+typedef struct rustsecp256k1_v0_11_silentpayments_found_output {
+    rustsecp256k1_v0_11_xonly_pubkey output;
+    unsigned char tweak[32];
+    int found_with_label;
+    rustsecp256k1_v0_11_pubkey label;
+} rustsecp256k1_v0_11_silentpayments_found_output;
+
+/** A pointer to a function that looks up a label.
+ *
+ *  Returns: a pointer to the 32-byte label tweak if label33 is a label of the
+ *           recipient, NULL otherwise. The pointer must remain valid until the
+ *           function is called again or the scan returns.
+ *  In:      label33:       the 33-byte compressed serialization of a candidate
+ *                          label point.
+ *           label_context: arbitrary data pointer passed through from the scan.
+ */
+typedef const unsigned char *(*rustsecp256k1_v0_11_silentpayments_label_lookup)(
+    const unsigned char *label33,
+    const void *label_context
+);
+
+/** Compute a label for a recipient.
+ *
+ *  The label tweak is hash_BIP0352/Label(scan_key || ser32(m)) and the label
+ *  is label_tweak*G. A labeled spend public key is spend_pubkey + label.
+ *
+ *  Returns: 1 if the label was computed, 0 if the label tweak is not a valid
+ *           non-zero scalar.
+ *  Args:    ctx:         pointer to a context object.
+ *  Out:     label:       pointer to the resulting label point.
+ *           label_tweak32: pointer to a 32-byte buffer for the label tweak.
+ *  In:      scan_key32:  pointer to the recipient's 32-byte scan secret key.
+ *           m:           the label index.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_silentpayments_recipient_create_label(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_pubkey *label,
+    unsigned char *label_tweak32,
+    const unsigned char *scan_key32,
+    uint32_t m
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
+/** Scan the outputs of a transaction for outputs belonging to a recipient.
+ *
+ *  The input public keys are summed, the shared secret
+ *  hash_BIP0352/Inputs(outpoint_smallest36 || A) * scan_key * A is computed
+ *  with a single constant-time multiplication, and candidate outputs
+ *  spend_pubkey + t_k*G are derived for k = 0, 1, 2, ... until one is not
+ *  found among tx_outputs. If label_lookup is not NULL, each transaction
+ *  output is also checked for being paid to a labeled spend key: all label
+ *  candidates for a given k are normalized with a single field inversion per
+ *  chunk and passed to label_lookup.
+ *
+ *  Returns: 1 if the transaction was scanned (n_found_outputs may be 0).
+ *           0 if the scan key is invalid, the input public keys sum to
+ *             infinity, or a derived hash is not a valid scalar.
+ *  Args:    ctx:              pointer to a context object.
+ *  Out:     found_outputs:    pointer to an array of n_tx_outputs elements.
+ *           n_found_outputs:  pointer to the number of found outputs written.
+ *  In:      tx_outputs:       pointer to an array of the transaction's taproot
+ *                             output keys.
+ *           n_tx_outputs:     the number of elements in tx_outputs.
+ *           scan_key32:       pointer to the recipient's 32-byte scan secret key.
+ *           xonly_inputs:     pointer to an array of n_xonly_inputs x-only input
+ *                             public keys (taproot key path inputs), or NULL.
+ *           n_xonly_inputs:   the number of x-only input public keys.
+ *           plain_inputs:     pointer to an array of n_plain_inputs input public
+ *                             keys (all other eligible inputs), or NULL.
+ *           n_plain_inputs:   the number of plain input public keys. The total
+ *                             number of input public keys must be at least 1.
+ *           outpoint_smallest36: pointer to the serialized smallest outpoint.
+ *           spend_pubkey:     pointer to the recipient's spend public key.
+ *           label_lookup:     pointer to a label lookup function, or NULL to
+ *                             skip label checks.
+ *           label_context:    arbitrary data pointer passed to label_lookup.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_silentpayments_recipient_scan_outputs(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_silentpayments_found_output *found_outputs,
+    size_t *n_found_outputs,
+    const rustsecp256k1_v0_11_xonly_pubkey *tx_outputs,
+    size_t n_tx_outputs,
+    const unsigned char *scan_key32,
+    const rustsecp256k1_v0_11_xonly_pubkey *xonly_inputs,
+    size_t n_xonly_inputs,
+    const rustsecp256k1_v0_11_pubkey *plain_inputs,
+    size_t n_plain_inputs,
+    const unsigned char *outpoint_smallest36,
+    const rustsecp256k1_v0_11_pubkey *spend_pubkey,
+    rustsecp256k1_v0_11_silentpayments_label_lookup label_lookup,
+    const void *label_context
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3)
+  SECP256K1_ARG_NONNULL(6) SECP256K1_ARG_NONNULL(11) SECP256K1_ARG_NONNULL(12);
+
+/** Create the k-th output for a recipient, as a sender.
+ *
+ *  Returns: 1 if the output was created, 0 if the input secret keys sum to
+ *           zero or are invalid, or a derived hash is not a valid scalar.
+ *  Args:    ctx:              pointer to a context object.
+ *  Out:     output:           pointer to the resulting x-only output key.
+ *  In:      input_seckeys32:  pointer to n_input_seckeys concatenated 32-byte
+ *                             input secret keys. Secret keys of taproot inputs
+ *                             must already be negated if their public key has
+ *                             an odd Y coordinate.
+ *           n_input_seckeys:  the number of input secret keys (at least 1).
+ *           outpoint_smallest36: pointer to the serialized smallest outpoint.
+ *           scan_pubkey:      pointer to the recipient's scan public key.
+ *           spend_pubkey:     pointer to the recipient's (possibly labeled)
+ *                             spend public key.
+ *           k:                the index of this output among the outputs to
+ *                             the same recipient in the transaction.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1_v0_11_silentpayments_sender_create_output(
+    const rustsecp256k1_v0_11_context *ctx,
+    rustsecp256k1_v0_11_xonly_pubkey *output,
+    const unsigned char *input_seckeys32,
+    size_t n_input_seckeys,
+    const unsigned char *outpoint_smallest36,
+    const rustsecp256k1_v0_11_pubkey *scan_pubkey,
+    const rustsecp256k1_v0_11_pubkey *spend_pubkey,
+    uint32_t k
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3)
+  SECP256K1_ARG_NONNULL(5) SECP256K1_ARG_NONNULL(6) SECP256K1_ARG_NONNULL(7);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SECP256K1_SILENTPAYMENTS_H */
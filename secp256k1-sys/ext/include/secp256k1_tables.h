@@ -0,0 +1,58 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_TABLES_H
+#define SECP256K1_TABLES_H
+
+#include "secp256k1.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Relocation of the precomputed tables.
+ *
+ *  Verification and signing read precomputed multiples of the generator from
+ *  static tables of rustsecp256k1_v0_11_tables_size() bytes in total (about
+ *  1.3 MB with the default window size). These functions copy the tables into
+ *  caller-supplied memory, such as memory backed by huge pages or allocated on
+ *  a particular NUMA node, and make the library read from the copy.
+ *
+ *  The copy must stay valid and unmodified for as long as it is installed.
+ */
+
+/** Return the size in bytes of the precomputed tables, which is the size of a copy. */
+SECP256K1_API size_t rustsecp256k1_v0_11_tables_size(void);
+
+/** Copy the precomputed tables into mem.
+ *
+ *  Returns: 1 on success, 0 if size is smaller than rustsecp256k1_v0_11_tables_size()
+ *  Out:     mem:   pointer to memory aligned to at least 8 bytes (64 recommended)
+ *  In:      size:  size of mem in bytes
+ */
+SECP256K1_API int rustsecp256k1_v0_11_tables_copy(
+    void *mem,
+    size_t size
+) SECP256K1_ARG_NONNULL(1);
+
+/** Make all threads read from the given copy, or from the static tables if NULL.
+ *
+ *  This function is not thread-safe: it must not be called while another thread
+ *  may be using the library.
+ *
+ *  In:      tables:  pointer to a copy made by rustsecp256k1_v0_11_tables_copy, or NULL
+ */
+SECP256K1_API void rustsecp256k1_v0_11_tables_set_default(const void *tables);
+
+/** Make the calling thread read from the given copy, or from the default if NULL.
+ *
+ *  Only available when the library is compiled with ENABLE_THREAD_LOCAL_TABLES.
+ *
+ *  In:      tables:  pointer to a copy made by rustsecp256k1_v0_11_tables_copy, or NULL
+ */
+SECP256K1_API void rustsecp256k1_v0_11_tables_set_thread(const void *tables);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SECP256K1_TABLES_H */
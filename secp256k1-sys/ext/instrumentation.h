@@ -0,0 +1,61 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+/* Per-thread operation counters, compiled in with the `instrumentation` feature.
+ *
+ * The vendored sources call SECP256K1_STATS_BEGIN/END around a handful of
+ * expensive internal operations and SECP256K1_STATS_COUNT at the entry of
+ * those with several exits. util.h defines these hooks away unless this file
+ * has been included first, so without the feature the library is compiled
+ * exactly as upstream.
+ *
+ * With ENABLE_INSTRUMENTATION_CYCLES on x86, BEGIN/END additionally accumulate
+ * the time stamp counter delta. Operations only hooked with COUNT are counted
+ * but never timed. Calls are not expected to nest within the same operation. */
+
+#ifndef SECP256K1_EXT_INSTRUMENTATION_H
+#define SECP256K1_EXT_INSTRUMENTATION_H
+
+#include <stdint.h>
+
+#include "ext_util.h"
+
+/* Keep in sync with `Op` in src/stats.rs. */
+#define SECP256K1_STATS_ECMULT 0
+#define SECP256K1_STATS_ECMULT_MULTI 1
+#define SECP256K1_STATS_ECMULT_GEN 2
+#define SECP256K1_STATS_ECMULT_CONST 3
+#define SECP256K1_STATS_FE_INV 4
+#define SECP256K1_STATS_FE_INV_VAR 5
+#define SECP256K1_STATS_FE_SQRT 6
+#define SECP256K1_STATS_FE_IS_SQUARE_VAR 7
+#define SECP256K1_STATS_SHA256_TRANSFORM 8
+#define SECP256K1_STATS_NUM 9
+
+static SECP256K1_EXT_THREAD_LOCAL uint64_t rustsecp256k1_v0_11_stats_counts[SECP256K1_STATS_NUM];
+
+#define SECP256K1_STATS_COUNT(stat) (rustsecp256k1_v0_11_stats_counts[(stat)]++)
+
+#if defined(ENABLE_INSTRUMENTATION_CYCLES) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  else
+#    include <x86intrin.h>
+#  endif
+#  define SECP256K1_STATS_HAVE_CYCLES 1
+
+static SECP256K1_EXT_THREAD_LOCAL uint64_t rustsecp256k1_v0_11_stats_start[SECP256K1_STATS_NUM];
+static SECP256K1_EXT_THREAD_LOCAL uint64_t rustsecp256k1_v0_11_stats_cycles[SECP256K1_STATS_NUM];
+
+#  define SECP256K1_STATS_BEGIN(stat) do { \
+    SECP256K1_STATS_COUNT(stat); \
+    rustsecp256k1_v0_11_stats_start[(stat)] = __rdtsc(); \
+} while (0)
+#  define SECP256K1_STATS_END(stat) \
+    (rustsecp256k1_v0_11_stats_cycles[(stat)] += __rdtsc() - rustsecp256k1_v0_11_stats_start[(stat)])
+#else
+#  define SECP256K1_STATS_HAVE_CYCLES 0
+#  define SECP256K1_STATS_BEGIN(stat) SECP256K1_STATS_COUNT(stat)
+#  define SECP256K1_STATS_END(stat)
+#endif
+
+#endif /* SECP256K1_EXT_INSTRUMENTATION_H */
@@ -0,0 +1,124 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_MODULE_DER_BATCH_MAIN_H
+#define SECP256K1_MODULE_DER_BATCH_MAIN_H
+
+#include "../../include/secp256k1_der_batch.h"
+#include "../../../depend/secp256k1/contrib/lax_der_parsing.h"
+
+/* Returns whether the content of a DER integer of len bytes (1 to 33) starting at p is
+ * anything but a non-negative, minimally encoded number of at most 32 bytes. */
+static int rustsecp256k1_v0_11_der_batch_bad_integer(const unsigned char *p, size_t len) {
+    int bad = p[0] >> 7;
+    bad |= (len == 33) & (p[0] != 0);
+    if (len > 1) {
+        bad |= (p[0] == 0) & ((p[1] >> 7) == 0);
+    }
+    return bad;
+}
+
+/* Sets r to the validated integer of len bytes at p, which is read in place if it has the
+ * usual 32 significant bytes. */
+static void rustsecp256k1_v0_11_der_batch_scalar_set(rustsecp256k1_v0_11_scalar *r, const unsigned char *p, size_t len, int *overflow) {
+    unsigned char b32[32] = {0};
+
+    if (len >= 32) {
+        rustsecp256k1_v0_11_scalar_set_b32(r, p + len - 32, overflow);
+        return;
+    }
+    memcpy(b32 + 32 - len, p, len);
+    rustsecp256k1_v0_11_scalar_set_b32(r, b32, overflow);
+}
+
+/* Parses sig if it has the shape which every DER encoder produces,
+ *
+ *   30 <4 + lr + ls> 02 <lr> <r> 02 <ls> <s>
+ *
+ * with short-form lengths and minimally encoded integers in the range of the scalars. The
+ * structure is checked by accumulating all conditions before branching once. Returns 0 for
+ * anything else, including encodings which the full parsers accept as a zero signature
+ * (negative or out of range integers), so that these are left to the full parsers. */
+static int rustsecp256k1_v0_11_der_batch_parse_fast(rustsecp256k1_v0_11_scalar *r, rustsecp256k1_v0_11_scalar *s, const unsigned char *sig, size_t size) {
+    size_t lr, ls;
+    int bad, overflow;
+
+    /* Two integers of 1 to 33 bytes. */
+    if (size < 8 || size > 72) {
+        return 0;
+    }
+    lr = sig[3];
+    if (lr > size - 7) {
+        return 0;
+    }
+    ls = sig[5 + lr];
+    bad = (sig[0] ^ 0x30) | (sig[1] ^ (int)(size - 2)) | (sig[2] ^ 0x02) | (sig[4 + lr] ^ 0x02);
+    bad |= (lr == 0) | (ls == 0) | (lr > 33) | (ls > 33) | (6 + lr + ls != size);
+    if (bad) {
+        return 0;
+    }
+    if (rustsecp256k1_v0_11_der_batch_bad_integer(&sig[4], lr) | rustsecp256k1_v0_11_der_batch_bad_integer(&sig[6 + lr], ls)) {
+        return 0;
+    }
+
+    rustsecp256k1_v0_11_der_batch_scalar_set(r, &sig[4], lr, &overflow);
+    bad = overflow;
+    rustsecp256k1_v0_11_der_batch_scalar_set(s, &sig[6 + lr], ls, &overflow);
+    return !(bad | overflow);
+}
+
+size_t rustsecp256k1_v0_11_ecdsa_signature_parse_der_batch(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_ecdsa_signature *sigs, unsigned char *valid, const unsigned char *input, const size_t *offsets, const size_t *lengths, size_t n, int lax) {
+    rustsecp256k1_v0_11_scalar r, s;
+    size_t i, parsed = 0;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(sigs != NULL || n == 0);
+    ARG_CHECK(valid != NULL || n == 0);
+    ARG_CHECK(input != NULL || n == 0);
+    ARG_CHECK(offsets != NULL || n == 0);
+    ARG_CHECK(lengths != NULL || n == 0);
+
+    for (i = 0; i < n; i++) {
+        const unsigned char *sig = input + offsets[i];
+        int ok;
+
+        if (rustsecp256k1_v0_11_der_batch_parse_fast(&r, &s, sig, lengths[i])
+            || (!lax && rustsecp256k1_v0_11_ecdsa_sig_parse(&r, &s, sig, lengths[i]))) {
+            rustsecp256k1_v0_11_ecdsa_signature_save(&sigs[i], &r, &s);
+            ok = 1;
+        } else if (lax) {
+            ok = rustsecp256k1_v0_11_ecdsa_signature_parse_der_lax(ctx, &sigs[i], sig, lengths[i]);
+        } else {
+            memset(&sigs[i], 0, sizeof(sigs[i]));
+            ok = 0;
+        }
+        valid[i] = ok;
+        parsed += ok;
+    }
+    return parsed;
+}
+
+int rustsecp256k1_v0_11_ecdsa_signature_serialize_der_batch(const rustsecp256k1_v0_11_context *ctx, unsigned char *output, size_t *outputlen, size_t *offsets, const rustsecp256k1_v0_11_ecdsa_signature *sigs, size_t n) {
+    rustsecp256k1_v0_11_scalar r, s;
+    size_t i, len, pos = 0;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(output != NULL || n == 0);
+    ARG_CHECK(outputlen != NULL);
+    ARG_CHECK(offsets != NULL);
+    ARG_CHECK(sigs != NULL || n == 0);
+
+    offsets[0] = 0;
+    for (i = 0; i < n; i++) {
+        rustsecp256k1_v0_11_ecdsa_signature_load(ctx, &r, &s, &sigs[i]);
+        len = *outputlen - pos;
+        if (!rustsecp256k1_v0_11_ecdsa_sig_serialize(output + pos, &len, &r, &s)) {
+            return 0;
+        }
+        pos += len;
+        offsets[i + 1] = pos;
+    }
+    *outputlen = pos;
+    return 1;
+}
+
+#endif /* SECP256K1_MODULE_DER_BATCH_MAIN_H */
@@ -0,0 +1,167 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_MODULE_ECDH_BATCH_MAIN_H
+#define SECP256K1_MODULE_ECDH_BATCH_MAIN_H
+
+#include "../../include/secp256k1_ecdh_batch.h"
+#include "ecmult_const_impl.h"
+
+/* Number of points whose results are normalized together with one inversion. */
+#define ECDH_BATCH_CHUNK 16
+
+/* The signed-digit recoding of a scalar as used by rustsecp256k1_v0_11_ecmult_const,
+ * split into the two GLV halves. The digits only depend on the scalar, so they
+ * can be computed once and reused for any number of points. */
+typedef struct {
+    unsigned int digits1[ECMULT_CONST_GROUPS];
+    unsigned int digits2[ECMULT_CONST_GROUPS];
+} rustsecp256k1_v0_11_ecdh_batch_recoding;
+
+static void rustsecp256k1_v0_11_ecdh_batch_recode(rustsecp256k1_v0_11_ecdh_batch_recoding *rec, const rustsecp256k1_v0_11_scalar *q) {
+    /* See rustsecp256k1_v0_11_ecmult_const for the derivation of these values. */
+    static const rustsecp256k1_v0_11_scalar S_OFFSET = SECP256K1_SCALAR_CONST(0, 0, 0, 1, 0, 0, 0, 0);
+    rustsecp256k1_v0_11_scalar s, v1, v2;
+    int group;
+
+    rustsecp256k1_v0_11_scalar_add(&s, q, &rustsecp256k1_v0_11_ecmult_const_K);
+    rustsecp256k1_v0_11_scalar_half(&s, &s);
+    rustsecp256k1_v0_11_scalar_split_lambda(&v1, &v2, &s);
+    rustsecp256k1_v0_11_scalar_add(&v1, &v1, &S_OFFSET);
+    rustsecp256k1_v0_11_scalar_add(&v2, &v2, &S_OFFSET);
+
+    for (group = 0; group < ECMULT_CONST_GROUPS; group++) {
+        /* Variable only in offset and count, not in the scalar. */
+        rec->digits1[group] = rustsecp256k1_v0_11_scalar_get_bits_var(&v1, group * ECMULT_CONST_GROUP_SIZE, ECMULT_CONST_GROUP_SIZE);
+        rec->digits2[group] = rustsecp256k1_v0_11_scalar_get_bits_var(&v2, group * ECMULT_CONST_GROUP_SIZE, ECMULT_CONST_GROUP_SIZE);
+    }
+
+    rustsecp256k1_v0_11_scalar_clear(&s);
+    rustsecp256k1_v0_11_scalar_clear(&v1);
+    rustsecp256k1_v0_11_scalar_clear(&v2);
+}
+
+static void rustsecp256k1_v0_11_ecdh_batch_recoding_clear(rustsecp256k1_v0_11_ecdh_batch_recoding *rec) {
+    rustsecp256k1_v0_11_memclear(rec, sizeof(*rec));
+}
+
+/* Constant-time multiplication of a (non-infinity) point by a recoded scalar. This is the
+ * main loop of rustsecp256k1_v0_11_ecmult_const with the recoding hoisted out. */
+static void rustsecp256k1_v0_11_ecdh_batch_ecmult_const(rustsecp256k1_v0_11_gej *r, const rustsecp256k1_v0_11_ge *a, const rustsecp256k1_v0_11_ecdh_batch_recoding *rec) {
+    rustsecp256k1_v0_11_ge pre_a[ECMULT_CONST_TABLE_SIZE];
+    rustsecp256k1_v0_11_ge pre_a_lam[ECMULT_CONST_TABLE_SIZE];
+    rustsecp256k1_v0_11_fe global_z;
+    int group, i;
+
+    VERIFY_CHECK(!rustsecp256k1_v0_11_ge_is_infinity(a));
+
+    rustsecp256k1_v0_11_gej_set_ge(r, a);
+    rustsecp256k1_v0_11_ecmult_const_odd_multiples_table_globalz(pre_a, &global_z, r);
+    for (i = 0; i < ECMULT_CONST_TABLE_SIZE; i++) {
+        rustsecp256k1_v0_11_ge_mul_lambda(&pre_a_lam[i], &pre_a[i]);
+    }
+
+    for (group = ECMULT_CONST_GROUPS - 1; group >= 0; --group) {
+        unsigned int bits1 = rec->digits1[group];
+        unsigned int bits2 = rec->digits2[group];
+        rustsecp256k1_v0_11_ge t;
+        int j;
+
+        ECMULT_CONST_TABLE_GET_GE(&t, pre_a, bits1);
+        if (group == ECMULT_CONST_GROUPS - 1) {
+            rustsecp256k1_v0_11_gej_set_ge(r, &t);
+        } else {
+            for (j = 0; j < ECMULT_CONST_GROUP_SIZE; ++j) {
+                rustsecp256k1_v0_11_gej_double(r, r);
+            }
+            rustsecp256k1_v0_11_gej_add_ge(r, r, &t);
+        }
+        ECMULT_CONST_TABLE_GET_GE(&t, pre_a_lam, bits2);
+        rustsecp256k1_v0_11_gej_add_ge(r, r, &t);
+    }
+
+    rustsecp256k1_v0_11_fe_mul(&r->z, &r->z, &global_z);
+}
+
+/* Constant-time counterpart of rustsecp256k1_v0_11_ge_set_all_gej_var for points known not
+ * to be infinity: Montgomery's trick with a single constant-time inversion. */
+static void rustsecp256k1_v0_11_ecdh_batch_ge_set_all_gej(rustsecp256k1_v0_11_ge *r, const rustsecp256k1_v0_11_gej *a, size_t len) {
+    rustsecp256k1_v0_11_fe u, zinv;
+    size_t i;
+
+    VERIFY_CHECK(len > 0);
+
+    /* Use destination's x coordinates as scratch space for the running products. */
+    r[0].x = a[0].z;
+    for (i = 1; i < len; i++) {
+        rustsecp256k1_v0_11_fe_mul(&r[i].x, &r[i - 1].x, &a[i].z);
+    }
+    rustsecp256k1_v0_11_fe_inv(&u, &r[len - 1].x);
+
+    for (i = len - 1; i > 0; i--) {
+        rustsecp256k1_v0_11_fe_mul(&zinv, &r[i - 1].x, &u);
+        rustsecp256k1_v0_11_fe_mul(&u, &u, &a[i].z);
+        rustsecp256k1_v0_11_ge_set_gej_zinv(&r[i], &a[i], &zinv);
+    }
+    rustsecp256k1_v0_11_ge_set_gej_zinv(&r[0], &a[0], &u);
+
+    rustsecp256k1_v0_11_fe_clear(&u);
+    rustsecp256k1_v0_11_fe_clear(&zinv);
+}
+
+int rustsecp256k1_v0_11_ecdh_batch(const rustsecp256k1_v0_11_context* ctx, unsigned char *output, size_t outputlen, const rustsecp256k1_v0_11_pubkey *pubkeys, size_t n_pubkeys, const unsigned char *seckey, rustsecp256k1_v0_11_ecdh_hash_function hashfp, void *data) {
+    int ret = 1;
+    int overflow = 0;
+    rustsecp256k1_v0_11_scalar s;
+    rustsecp256k1_v0_11_ecdh_batch_recoding rec;
+    rustsecp256k1_v0_11_gej res[ECDH_BATCH_CHUNK];
+    rustsecp256k1_v0_11_ge pt[ECDH_BATCH_CHUNK];
+    unsigned char x[32];
+    unsigned char y[32];
+    size_t i, j, chunk;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(output != NULL || n_pubkeys == 0);
+    ARG_CHECK(pubkeys != NULL || n_pubkeys == 0);
+    ARG_CHECK(seckey != NULL);
+
+    if (hashfp == NULL) {
+        hashfp = rustsecp256k1_v0_11_ecdh_hash_function_default;
+    }
+
+    rustsecp256k1_v0_11_scalar_set_b32(&s, seckey, &overflow);
+    overflow |= rustsecp256k1_v0_11_scalar_is_zero(&s);
+    rustsecp256k1_v0_11_scalar_cmov(&s, &rustsecp256k1_v0_11_scalar_one, overflow);
+    rustsecp256k1_v0_11_ecdh_batch_recode(&rec, &s);
+
+    for (i = 0; i < n_pubkeys; i += chunk) {
+        chunk = n_pubkeys - i < ECDH_BATCH_CHUNK ? n_pubkeys - i : ECDH_BATCH_CHUNK;
+        for (j = 0; j < chunk; j++) {
+            if (!rustsecp256k1_v0_11_pubkey_load(ctx, &pt[j], &pubkeys[i + j])) {
+                /* An invalid pubkey has already triggered the illegal callback. */
+                ret = 0;
+                pt[j] = rustsecp256k1_v0_11_ge_const_g;
+            }
+            rustsecp256k1_v0_11_ecdh_batch_ecmult_const(&res[j], &pt[j], &rec);
+        }
+        rustsecp256k1_v0_11_ecdh_batch_ge_set_all_gej(pt, res, chunk);
+
+        for (j = 0; j < chunk; j++) {
+            rustsecp256k1_v0_11_fe_normalize(&pt[j].x);
+            rustsecp256k1_v0_11_fe_normalize(&pt[j].y);
+            rustsecp256k1_v0_11_fe_get_b32(x, &pt[j].x);
+            rustsecp256k1_v0_11_fe_get_b32(y, &pt[j].y);
+            ret &= !!hashfp(output + (i + j) * outputlen, x, y, data);
+        }
+    }
+
+    rustsecp256k1_v0_11_memclear(x, sizeof(x));
+    rustsecp256k1_v0_11_memclear(y, sizeof(y));
+    rustsecp256k1_v0_11_memclear(pt, sizeof(pt));
+    rustsecp256k1_v0_11_memclear(res, sizeof(res));
+    rustsecp256k1_v0_11_scalar_clear(&s);
+    rustsecp256k1_v0_11_ecdh_batch_recoding_clear(&rec);
+
+    return ret & !overflow;
+}
+
+#endif /* SECP256K1_MODULE_ECDH_BATCH_MAIN_H */
@@ -0,0 +1,80 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_MODULE_ECDSA_PRESIGN_MAIN_H
+#define SECP256K1_MODULE_ECDSA_PRESIGN_MAIN_H
+
+#include "../../include/secp256k1_ecdsa_presign.h"
+
+int rustsecp256k1_v0_11_ecdsa_presignature_create(const rustsecp256k1_v0_11_context *ctx, unsigned char *presig64, const unsigned char *nonce32) {
+    rustsecp256k1_v0_11_scalar k, kinv, r;
+    rustsecp256k1_v0_11_gej rj;
+    rustsecp256k1_v0_11_ge rp;
+    unsigned char buf[32];
+    int ret;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(rustsecp256k1_v0_11_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(presig64 != NULL);
+    ARG_CHECK(nonce32 != NULL);
+
+    /* As in ecdsa_sig_sign, with an invalid nonce replaced by one to stay constant time. */
+    ret = rustsecp256k1_v0_11_scalar_set_b32_seckey(&k, nonce32);
+    rustsecp256k1_v0_11_scalar_cmov(&k, &rustsecp256k1_v0_11_scalar_one, !ret);
+    rustsecp256k1_v0_11_ecmult_gen(&ctx->ecmult_gen_ctx, &rj, &k);
+    rustsecp256k1_v0_11_ge_set_gej(&rp, &rj);
+    rustsecp256k1_v0_11_fe_normalize(&rp.x);
+    rustsecp256k1_v0_11_fe_get_b32(buf, &rp.x);
+    rustsecp256k1_v0_11_scalar_set_b32(&r, buf, NULL);
+    rustsecp256k1_v0_11_scalar_inverse(&kinv, &k);
+    /* r = 0 is cryptographically unreachable, see ecdsa_sig_sign. */
+    ret &= !rustsecp256k1_v0_11_scalar_is_zero(&r);
+
+    rustsecp256k1_v0_11_scalar_get_b32(presig64, &r);
+    rustsecp256k1_v0_11_scalar_get_b32(presig64 + 32, &kinv);
+    rustsecp256k1_v0_11_memczero(presig64, 64, !ret);
+
+    rustsecp256k1_v0_11_scalar_clear(&k);
+    rustsecp256k1_v0_11_scalar_clear(&kinv);
+    rustsecp256k1_v0_11_gej_clear(&rj);
+    rustsecp256k1_v0_11_ge_clear(&rp);
+    rustsecp256k1_v0_11_memclear(buf, sizeof(buf));
+    return ret;
+}
+
+int rustsecp256k1_v0_11_ecdsa_presignature_sign(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_ecdsa_signature *sig, unsigned char *presig64, const unsigned char *msghash32, const unsigned char *seckey) {
+    rustsecp256k1_v0_11_scalar r, s, kinv, sec, msg, n;
+    int overflow_r, overflow_kinv;
+    int ret;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(sig != NULL);
+    ARG_CHECK(presig64 != NULL);
+    ARG_CHECK(msghash32 != NULL);
+    ARG_CHECK(seckey != NULL);
+
+    rustsecp256k1_v0_11_scalar_set_b32(&r, presig64, &overflow_r);
+    rustsecp256k1_v0_11_scalar_set_b32(&kinv, presig64 + 32, &overflow_kinv);
+    rustsecp256k1_v0_11_memclear(presig64, 64);
+    ret = !overflow_r & !overflow_kinv;
+    ret &= !rustsecp256k1_v0_11_scalar_is_zero(&r) & !rustsecp256k1_v0_11_scalar_is_zero(&kinv);
+
+    ret &= rustsecp256k1_v0_11_scalar_set_b32_seckey(&sec, seckey);
+    rustsecp256k1_v0_11_scalar_set_b32(&msg, msghash32, NULL);
+    rustsecp256k1_v0_11_scalar_mul(&n, &r, &sec);
+    rustsecp256k1_v0_11_scalar_add(&n, &n, &msg);
+    rustsecp256k1_v0_11_scalar_mul(&s, &kinv, &n);
+    rustsecp256k1_v0_11_scalar_cond_negate(&s, rustsecp256k1_v0_11_scalar_is_high(&s));
+    ret &= !rustsecp256k1_v0_11_scalar_is_zero(&s);
+
+    rustsecp256k1_v0_11_scalar_cmov(&r, &rustsecp256k1_v0_11_scalar_zero, !ret);
+    rustsecp256k1_v0_11_scalar_cmov(&s, &rustsecp256k1_v0_11_scalar_zero, !ret);
+    rustsecp256k1_v0_11_ecdsa_signature_save(sig, &r, &s);
+
+    rustsecp256k1_v0_11_scalar_clear(&kinv);
+    rustsecp256k1_v0_11_scalar_clear(&sec);
+    rustsecp256k1_v0_11_scalar_clear(&msg);
+    rustsecp256k1_v0_11_scalar_clear(&n);
+    return ret;
+}
+
+#endif /* SECP256K1_MODULE_ECDSA_PRESIGN_MAIN_H */
@@ -0,0 +1,105 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_MODULE_ECMULT_TUNE_MAIN_H
+#define SECP256K1_MODULE_ECMULT_TUNE_MAIN_H
+
+#include "../../include/secp256k1_ecmult_tune.h"
+
+typedef struct {
+    const rustsecp256k1_v0_11_context *ctx;
+    const unsigned char *scalars32;
+    const rustsecp256k1_v0_11_pubkey *points;
+} rustsecp256k1_v0_11_ecmult_tune_data;
+
+static int rustsecp256k1_v0_11_ecmult_tune_callback(rustsecp256k1_v0_11_scalar *sc, rustsecp256k1_v0_11_ge *pt, size_t idx, void *data) {
+    const rustsecp256k1_v0_11_ecmult_tune_data *d = (const rustsecp256k1_v0_11_ecmult_tune_data *)data;
+    rustsecp256k1_v0_11_scalar_set_b32(sc, &d->scalars32[32 * idx], NULL);
+    return rustsecp256k1_v0_11_pubkey_load(d->ctx, pt, &d->points[idx]);
+}
+
+/* Like ecmult_pippenger_batch, but with the given bucket_window instead of the
+ * one picked by pippenger_bucket_window. */
+static int rustsecp256k1_v0_11_ecmult_tune_pippenger(const rustsecp256k1_v0_11_callback* error_callback, rustsecp256k1_v0_11_scratch *scratch, rustsecp256k1_v0_11_gej *r, int bucket_window, rustsecp256k1_v0_11_ecmult_multi_callback cb, void *cbdata, size_t n_points) {
+    const size_t scratch_checkpoint = rustsecp256k1_v0_11_scratch_checkpoint(error_callback, scratch);
+    size_t entries = 2*n_points + 2;
+    rustsecp256k1_v0_11_ge *points;
+    rustsecp256k1_v0_11_scalar *scalars;
+    rustsecp256k1_v0_11_gej *buckets;
+    struct rustsecp256k1_v0_11_pippenger_state *state_space;
+    size_t idx = 0;
+    size_t point_idx;
+
+    points = (rustsecp256k1_v0_11_ge *) rustsecp256k1_v0_11_scratch_alloc(error_callback, scratch, entries * sizeof(*points));
+    scalars = (rustsecp256k1_v0_11_scalar *) rustsecp256k1_v0_11_scratch_alloc(error_callback, scratch, entries * sizeof(*scalars));
+    state_space = (struct rustsecp256k1_v0_11_pippenger_state *) rustsecp256k1_v0_11_scratch_alloc(error_callback, scratch, sizeof(*state_space));
+    if (points == NULL || scalars == NULL || state_space == NULL) {
+        rustsecp256k1_v0_11_scratch_apply_checkpoint(error_callback, scratch, scratch_checkpoint);
+        return 0;
+    }
+    state_space->ps = (struct rustsecp256k1_v0_11_pippenger_point_state *) rustsecp256k1_v0_11_scratch_alloc(error_callback, scratch, entries * sizeof(*state_space->ps));
+    state_space->wnaf_na = (int *) rustsecp256k1_v0_11_scratch_alloc(error_callback, scratch, entries*(WNAF_SIZE(bucket_window+1)) * sizeof(int));
+    buckets = (rustsecp256k1_v0_11_gej *) rustsecp256k1_v0_11_scratch_alloc(error_callback, scratch, ((size_t)1 << bucket_window) * sizeof(*buckets));
+    if (state_space->ps == NULL || state_space->wnaf_na == NULL || buckets == NULL) {
+        rustsecp256k1_v0_11_scratch_apply_checkpoint(error_callback, scratch, scratch_checkpoint);
+        return 0;
+    }
+
+    for (point_idx = 0; point_idx < n_points; point_idx++) {
+        if (!cb(&scalars[idx], &points[idx], point_idx, cbdata)) {
+            rustsecp256k1_v0_11_scratch_apply_checkpoint(error_callback, scratch, scratch_checkpoint);
+            return 0;
+        }
+        idx++;
+        rustsecp256k1_v0_11_ecmult_endo_split(&scalars[idx - 1], &scalars[idx], &points[idx - 1], &points[idx]);
+        idx++;
+    }
+
+    rustsecp256k1_v0_11_ecmult_pippenger_wnaf(buckets, bucket_window, state_space, r, scalars, points, idx);
+    rustsecp256k1_v0_11_scratch_apply_checkpoint(error_callback, scratch, scratch_checkpoint);
+    return 1;
+}
+
+size_t rustsecp256k1_v0_11_ecmult_multi_tune_scratch_size(size_t n, int bucket_window) {
+    if (bucket_window == 0) {
+        return rustsecp256k1_v0_11_strauss_scratch_size(n) + STRAUSS_SCRATCH_OBJECTS * ALIGNMENT;
+    }
+    if (bucket_window < 1 || bucket_window > PIPPENGER_MAX_BUCKET_WINDOW) {
+        return 0;
+    }
+    return rustsecp256k1_v0_11_pippenger_scratch_size(n, bucket_window) + PIPPENGER_SCRATCH_OBJECTS * ALIGNMENT;
+}
+
+int rustsecp256k1_v0_11_ecmult_multi_tune(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_pubkey *result, void *scratch_mem, size_t scratch_size, int bucket_window, const unsigned char *scalars32, const rustsecp256k1_v0_11_pubkey *points, size_t n) {
+    rustsecp256k1_v0_11_scratch scratch;
+    rustsecp256k1_v0_11_ecmult_tune_data data;
+    rustsecp256k1_v0_11_gej rj;
+    rustsecp256k1_v0_11_ge r;
+    int ret;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(result != NULL);
+    memset(result, 0, sizeof(*result));
+    ARG_CHECK(scratch_mem != NULL);
+    ARG_CHECK(n == 0 || scalars32 != NULL);
+    ARG_CHECK(n == 0 || points != NULL);
+    ARG_CHECK(bucket_window >= 0 && bucket_window <= PIPPENGER_MAX_BUCKET_WINDOW);
+
+    rustsecp256k1_v0_11_ext_scratch_init(&scratch, scratch_mem, scratch_size);
+
+    data.ctx = ctx;
+    data.scalars32 = scalars32;
+    data.points = points;
+    if (bucket_window == 0) {
+        ret = rustsecp256k1_v0_11_ecmult_strauss_batch(&ctx->error_callback, &scratch, &rj, NULL, rustsecp256k1_v0_11_ecmult_tune_callback, &data, n, 0);
+    } else {
+        ret = rustsecp256k1_v0_11_ecmult_tune_pippenger(&ctx->error_callback, &scratch, &rj, bucket_window, rustsecp256k1_v0_11_ecmult_tune_callback, &data, n);
+    }
+    if (!ret || rustsecp256k1_v0_11_gej_is_infinity(&rj)) {
+        return 0;
+    }
+    rustsecp256k1_v0_11_ge_set_gej_var(&r, &rj);
+    rustsecp256k1_v0_11_pubkey_save(result, &r);
+    return 1;
+}
+
+#endif /* SECP256K1_MODULE_ECMULT_TUNE_MAIN_H */
@@ -0,0 +1,196 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_MODULE_ELLSWIFT_BATCH_MAIN_H
+#define SECP256K1_MODULE_ELLSWIFT_BATCH_MAIN_H
+
+#include "../../include/secp256k1_ellswift_batch.h"
+
+/* Number of elements whose field inversions are shared. */
+#define ELLSWIFT_BATCH_CHUNK 16
+
+/* Sets r[i] = 1/a[i] for all i using Montgomery's trick. None of the a[i] may be zero and r
+ * must not alias a. If var is nonzero a variable-time inversion is used, otherwise a
+ * constant-time one. */
+static void rustsecp256k1_v0_11_ellswift_batch_fe_inv_all(rustsecp256k1_v0_11_fe *r, const rustsecp256k1_v0_11_fe *a, size_t len, int var) {
+    rustsecp256k1_v0_11_fe u;
+    size_t i;
+
+    VERIFY_CHECK(len > 0);
+
+    r[0] = a[0];
+    for (i = 1; i < len; i++) {
+        rustsecp256k1_v0_11_fe_mul(&r[i], &r[i - 1], &a[i]);
+    }
+    if (var) {
+        rustsecp256k1_v0_11_fe_inv_var(&u, &r[len - 1]);
+    } else {
+        rustsecp256k1_v0_11_fe_inv(&u, &r[len - 1]);
+    }
+    for (i = len - 1; i > 0; i--) {
+        rustsecp256k1_v0_11_fe_mul(&r[i], &r[i - 1], &u);
+        rustsecp256k1_v0_11_fe_mul(&u, &u, &a[i]);
+    }
+    r[0] = u;
+
+    rustsecp256k1_v0_11_fe_clear(&u);
+}
+
+int rustsecp256k1_v0_11_ellswift_decode_batch(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_pubkey *pubkeys, const unsigned char *ell64s, size_t n) {
+    rustsecp256k1_v0_11_fe xn[ELLSWIFT_BATCH_CHUNK], xd[ELLSWIFT_BATCH_CHUNK], xdinv[ELLSWIFT_BATCH_CHUNK];
+    rustsecp256k1_v0_11_fe u, t, x;
+    rustsecp256k1_v0_11_ge p;
+    size_t i, j, chunk;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(pubkeys != NULL || n == 0);
+    ARG_CHECK(ell64s != NULL || n == 0);
+
+    for (i = 0; i < n; i += chunk) {
+        chunk = n - i < ELLSWIFT_BATCH_CHUNK ? n - i : ELLSWIFT_BATCH_CHUNK;
+        for (j = 0; j < chunk; j++) {
+            rustsecp256k1_v0_11_fe_set_b32_mod(&u, ell64s + 64 * (i + j));
+            rustsecp256k1_v0_11_fe_set_b32_mod(&t, ell64s + 64 * (i + j) + 32);
+            rustsecp256k1_v0_11_ellswift_xswiftec_frac_var(&xn[j], &xd[j], &u, &t);
+        }
+        rustsecp256k1_v0_11_ellswift_batch_fe_inv_all(xdinv, xd, chunk, 1);
+        for (j = 0; j < chunk; j++) {
+            rustsecp256k1_v0_11_fe_set_b32_mod(&t, ell64s + 64 * (i + j) + 32);
+            rustsecp256k1_v0_11_fe_normalize_var(&t);
+            rustsecp256k1_v0_11_fe_mul(&x, &xn[j], &xdinv[j]);
+            rustsecp256k1_v0_11_ge_set_xo_var(&p, &x, rustsecp256k1_v0_11_fe_is_odd(&t));
+            rustsecp256k1_v0_11_pubkey_save(&pubkeys[i + j], &p);
+        }
+    }
+    return 1;
+}
+
+int rustsecp256k1_v0_11_ellswift_create_batch(const rustsecp256k1_v0_11_context *ctx, unsigned char *ell64s, const unsigned char *seckeys32, const unsigned char *auxrnd32s, size_t n) {
+    static const unsigned char zero32[32] = {0};
+    rustsecp256k1_v0_11_gej pj[ELLSWIFT_BATCH_CHUNK];
+    rustsecp256k1_v0_11_fe z[ELLSWIFT_BATCH_CHUNK], zinv[ELLSWIFT_BATCH_CHUNK];
+    int valid[ELLSWIFT_BATCH_CHUNK];
+    rustsecp256k1_v0_11_scalar s;
+    rustsecp256k1_v0_11_sha256 hash;
+    rustsecp256k1_v0_11_ge p;
+    rustsecp256k1_v0_11_fe t;
+    size_t i, j, chunk;
+    int ret = 1;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(ell64s != NULL || n == 0);
+    if (n > 0) {
+        memset(ell64s, 0, 64 * n);
+    }
+    ARG_CHECK(rustsecp256k1_v0_11_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(seckeys32 != NULL || n == 0);
+
+    for (i = 0; i < n; i += chunk) {
+        chunk = n - i < ELLSWIFT_BATCH_CHUNK ? n - i : ELLSWIFT_BATCH_CHUNK;
+        for (j = 0; j < chunk; j++) {
+            valid[j] = rustsecp256k1_v0_11_scalar_set_b32_seckey(&s, seckeys32 + 32 * (i + j));
+            rustsecp256k1_v0_11_scalar_cmov(&s, &rustsecp256k1_v0_11_scalar_one, !valid[j]);
+            rustsecp256k1_v0_11_ecmult_gen(&ctx->ecmult_gen_ctx, &pj[j], &s);
+            z[j] = pj[j].z;
+        }
+        rustsecp256k1_v0_11_ellswift_batch_fe_inv_all(zinv, z, chunk, 0);
+
+        for (j = 0; j < chunk; j++) {
+            unsigned char *ell64 = ell64s + 64 * (i + j);
+
+            rustsecp256k1_v0_11_ge_set_gej_zinv(&p, &pj[j], &zinv[j]);
+            rustsecp256k1_v0_11_declassify(ctx, &p, sizeof(p)); /* not constant time in produced pubkey */
+            rustsecp256k1_v0_11_fe_normalize_var(&p.x);
+            rustsecp256k1_v0_11_fe_normalize_var(&p.y);
+
+            /* Same hasher as rustsecp256k1_v0_11_ellswift_create. */
+            rustsecp256k1_v0_11_ellswift_sha256_init_create(&hash);
+            rustsecp256k1_v0_11_sha256_write(&hash, seckeys32 + 32 * (i + j), 32);
+            rustsecp256k1_v0_11_sha256_write(&hash, zero32, sizeof(zero32));
+            rustsecp256k1_v0_11_declassify(ctx, &hash, sizeof(hash)); /* private key is hashed now */
+            if (auxrnd32s) rustsecp256k1_v0_11_sha256_write(&hash, auxrnd32s + 32 * (i + j), 32);
+
+            rustsecp256k1_v0_11_ellswift_elligatorswift_var(ell64, &t, &p, &hash);
+            rustsecp256k1_v0_11_fe_get_b32(ell64 + 32, &t);
+            rustsecp256k1_v0_11_memczero(ell64, 64, !valid[j]);
+            ret &= valid[j];
+        }
+    }
+
+    rustsecp256k1_v0_11_scalar_clear(&s);
+    rustsecp256k1_v0_11_memclear(pj, sizeof(pj));
+    rustsecp256k1_v0_11_memclear(z, sizeof(z));
+    rustsecp256k1_v0_11_memclear(zinv, sizeof(zinv));
+    return ret;
+}
+
+int rustsecp256k1_v0_11_ellswift_xdh_batch(const rustsecp256k1_v0_11_context *ctx, unsigned char *output, const unsigned char *ell_a64s, const unsigned char *ell_b64s, const unsigned char *seckeys32, const int *parties, size_t n, rustsecp256k1_v0_11_ellswift_xdh_hash_function hashfp, void *data) {
+    rustsecp256k1_v0_11_gej rj[ELLSWIFT_BATCH_CHUNK];
+    rustsecp256k1_v0_11_fe den[ELLSWIFT_BATCH_CHUNK], deninv[ELLSWIFT_BATCH_CHUNK];
+    rustsecp256k1_v0_11_scalar s;
+    rustsecp256k1_v0_11_fe xn, xd, u, t, g, b, x;
+    rustsecp256k1_v0_11_ge p;
+    unsigned char sx[32];
+    size_t i, j, chunk;
+    int ret = 1;
+    int overflow;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(output != NULL || n == 0);
+    ARG_CHECK(ell_a64s != NULL || n == 0);
+    ARG_CHECK(ell_b64s != NULL || n == 0);
+    ARG_CHECK(seckeys32 != NULL || n == 0);
+    ARG_CHECK(parties != NULL || n == 0);
+    ARG_CHECK(hashfp != NULL);
+
+    for (i = 0; i < n; i += chunk) {
+        chunk = n - i < ELLSWIFT_BATCH_CHUNK ? n - i : ELLSWIFT_BATCH_CHUNK;
+        for (j = 0; j < chunk; j++) {
+            const unsigned char *theirs64 = parties[i + j] ? ell_a64s + 64 * (i + j) : ell_b64s + 64 * (i + j);
+
+            /* Load remote public key (as fraction). */
+            rustsecp256k1_v0_11_fe_set_b32_mod(&u, theirs64);
+            rustsecp256k1_v0_11_fe_set_b32_mod(&t, theirs64 + 32);
+            rustsecp256k1_v0_11_ellswift_xswiftec_frac_var(&xn, &xd, &u, &t);
+
+            /* Load private key (using one if invalid). */
+            rustsecp256k1_v0_11_scalar_set_b32(&s, seckeys32 + 32 * (i + j), &overflow);
+            overflow = rustsecp256k1_v0_11_scalar_is_zero(&s);
+            rustsecp256k1_v0_11_scalar_cmov(&s, &rustsecp256k1_v0_11_scalar_one, overflow);
+            ret &= !overflow;
+
+            /* This is rustsecp256k1_v0_11_ecmult_const_xonly with known_on_curve set, except
+             * that the final denominator Z^2*d*g is kept for the batch inversion. */
+            rustsecp256k1_v0_11_fe_sqr(&g, &xn);
+            rustsecp256k1_v0_11_fe_mul(&g, &g, &xn);
+            rustsecp256k1_v0_11_fe_sqr(&b, &xd);
+            rustsecp256k1_v0_11_fe_mul_int(&b, SECP256K1_B);
+            rustsecp256k1_v0_11_fe_mul(&b, &b, &xd);
+            rustsecp256k1_v0_11_fe_add(&g, &b);
+            rustsecp256k1_v0_11_fe_mul(&p.x, &g, &xn);
+            rustsecp256k1_v0_11_fe_sqr(&p.y, &g);
+            p.infinity = 0;
+            rustsecp256k1_v0_11_ecmult_const(&rj[j], &p, &s);
+            rustsecp256k1_v0_11_fe_sqr(&den[j], &rj[j].z);
+            rustsecp256k1_v0_11_fe_mul(&den[j], &den[j], &g);
+            rustsecp256k1_v0_11_fe_mul(&den[j], &den[j], &xd);
+        }
+        rustsecp256k1_v0_11_ellswift_batch_fe_inv_all(deninv, den, chunk, 0);
+
+        for (j = 0; j < chunk; j++) {
+            rustsecp256k1_v0_11_fe_mul(&x, &rj[j].x, &deninv[j]);
+            rustsecp256k1_v0_11_fe_normalize(&x);
+            rustsecp256k1_v0_11_fe_get_b32(sx, &x);
+            ret &= !!hashfp(output + 32 * (i + j), sx, ell_a64s + 64 * (i + j), ell_b64s + 64 * (i + j), data);
+        }
+    }
+
+    rustsecp256k1_v0_11_memclear(sx, sizeof(sx));
+    rustsecp256k1_v0_11_fe_clear(&x);
+    rustsecp256k1_v0_11_scalar_clear(&s);
+    rustsecp256k1_v0_11_memclear(rj, sizeof(rj));
+    rustsecp256k1_v0_11_memclear(den, sizeof(den));
+    rustsecp256k1_v0_11_memclear(deninv, sizeof(deninv));
+    return ret;
+}
+
+#endif /* SECP256K1_MODULE_ELLSWIFT_BATCH_MAIN_H */
@@ -0,0 +1,251 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_MODULE_EXTRAKEYS_BATCH_MAIN_H
+#define SECP256K1_MODULE_EXTRAKEYS_BATCH_MAIN_H
+
+#include "../../include/secp256k1_extrakeys_batch.h"
+
+size_t rustsecp256k1_v0_11_xonly_pubkey_tweak_add_check_batch_scratch_size(size_t n) {
+    return n * (sizeof(rustsecp256k1_v0_11_gej) + sizeof(rustsecp256k1_v0_11_ge) + sizeof(rustsecp256k1_v0_11_scalar)) + 3 * ALIGNMENT
+        + rustsecp256k1_v0_11_ext_ecmult_multi_scratch_size(n);
+}
+
+int rustsecp256k1_v0_11_xonly_pubkey_tweak_add_check_batch(const rustsecp256k1_v0_11_context *ctx, void *scratch_mem, size_t scratch_size, const unsigned char *tweaked_pubkey32s, const int *tweaked_pk_parities, const rustsecp256k1_v0_11_xonly_pubkey *internal_pubkeys, const unsigned char *tweak32s, size_t n) {
+    rustsecp256k1_v0_11_scratch scratch;
+    rustsecp256k1_v0_11_ext_batch_data data;
+    rustsecp256k1_v0_11_gej *diffs;
+    rustsecp256k1_v0_11_ge *points;
+    rustsecp256k1_v0_11_scalar *scalars;
+    rustsecp256k1_v0_11_scalar t, g_scalar;
+    rustsecp256k1_v0_11_sha256 sha;
+    rustsecp256k1_v0_11_gej rj;
+    rustsecp256k1_v0_11_ge p, q;
+    rustsecp256k1_v0_11_fe qx;
+    unsigned char seed[32], buf[33];
+    size_t i;
+    int overflow;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(scratch_mem != NULL);
+    ARG_CHECK(tweaked_pubkey32s != NULL || n == 0);
+    ARG_CHECK(tweaked_pk_parities != NULL || n == 0);
+    ARG_CHECK(internal_pubkeys != NULL || n == 0);
+    ARG_CHECK(tweak32s != NULL || n == 0);
+
+    rustsecp256k1_v0_11_ext_scratch_init(&scratch, scratch_mem, scratch_size);
+    diffs = (rustsecp256k1_v0_11_gej *)rustsecp256k1_v0_11_scratch_alloc(&ctx->error_callback, &scratch, n * sizeof(*diffs));
+    points = (rustsecp256k1_v0_11_ge *)rustsecp256k1_v0_11_scratch_alloc(&ctx->error_callback, &scratch, n * sizeof(*points));
+    scalars = (rustsecp256k1_v0_11_scalar *)rustsecp256k1_v0_11_scratch_alloc(&ctx->error_callback, &scratch, n * sizeof(*scalars));
+    if (diffs == NULL || points == NULL || scalars == NULL) {
+        return 0;
+    }
+
+    /* Compute P_i - Q_i, where Q_i is the tweaked key with the given parity, and hash all inputs
+     * into the seed of the randomizers, see batch_impl.h. */
+    rustsecp256k1_v0_11_sha256_initialize(&sha);
+    for (i = 0; i < n; i++) {
+        /* tweak_add_check compares the parity with fe_is_odd, so anything else never matches. */
+        if (tweaked_pk_parities[i] != 0 && tweaked_pk_parities[i] != 1) {
+            return 0;
+        }
+        if (!rustsecp256k1_v0_11_xonly_pubkey_load(ctx, &p, &internal_pubkeys[i])) {
+            return 0;
+        }
+        if (!rustsecp256k1_v0_11_fe_set_b32_limit(&qx, &tweaked_pubkey32s[32 * i])) {
+            return 0;
+        }
+        if (!rustsecp256k1_v0_11_ge_set_xo_var(&q, &qx, tweaked_pk_parities[i])) {
+            return 0;
+        }
+        rustsecp256k1_v0_11_ge_neg(&q, &q);
+        rustsecp256k1_v0_11_gej_set_ge(&diffs[i], &p);
+        rustsecp256k1_v0_11_gej_add_ge_var(&diffs[i], &diffs[i], &q, NULL);
+
+        rustsecp256k1_v0_11_fe_get_b32(buf, &p.x);
+        buf[32] = (unsigned char)tweaked_pk_parities[i];
+        rustsecp256k1_v0_11_sha256_write(&sha, &tweaked_pubkey32s[32 * i], 32);
+        rustsecp256k1_v0_11_sha256_write(&sha, buf, 33);
+        rustsecp256k1_v0_11_sha256_write(&sha, &tweak32s[32 * i], 32);
+    }
+    rustsecp256k1_v0_11_sha256_finalize(&sha, seed);
+    rustsecp256k1_v0_11_ge_set_all_gej_var(points, diffs, n);
+
+    /* Check that sum(a_i*t_i)*G + sum(a_i*(P_i - Q_i)) is infinity. Q_i is never infinity, so
+     * neither is any P_i + t_i*G which passes, as tweak_add_check requires. */
+    rustsecp256k1_v0_11_scalar_clear(&g_scalar);
+    for (i = 0; i < n; i++) {
+        rustsecp256k1_v0_11_scalar_set_b32(&t, &tweak32s[32 * i], &overflow);
+        if (overflow) {
+            return 0;
+        }
+        rustsecp256k1_v0_11_ext_batch_randomizer(&scalars[i], seed, i);
+        rustsecp256k1_v0_11_scalar_mul(&t, &t, &scalars[i]);
+        rustsecp256k1_v0_11_scalar_add(&g_scalar, &g_scalar, &t);
+    }
+
+    data.points = points;
+    data.scalars = scalars;
+    if (!rustsecp256k1_v0_11_ecmult_multi_var(&ctx->error_callback, &scratch, &rj, &g_scalar, rustsecp256k1_v0_11_ext_batch_callback, &data, n)) {
+        return 0;
+    }
+    return rustsecp256k1_v0_11_gej_is_infinity(&rj);
+}
+
+/* Number of tweaked keys normalized with a single field inversion. */
+#define EXTRAKEYS_BATCH_CHUNK 16
+
+/* Computes output_pubkeys[i] = internal_pubkeys[i] + t_i*G. The tweaks t_i are read from
+ * tweaks32 if taptweak is NULL, and hashed from the internal key and merkle_roots32 (if not
+ * NULL) starting from the tagged hash midstate taptweak otherwise. */
+static int rustsecp256k1_v0_11_xonly_pubkey_tweak_add_batch_impl(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_xonly_pubkey *output_pubkeys, int *pk_parities, const rustsecp256k1_v0_11_xonly_pubkey *internal_pubkeys, const unsigned char *tweaks32, const rustsecp256k1_v0_11_sha256 *taptweak, const unsigned char *merkle_roots32, size_t n) {
+    rustsecp256k1_v0_11_gej rj[EXTRAKEYS_BATCH_CHUNK];
+    rustsecp256k1_v0_11_ge r[EXTRAKEYS_BATCH_CHUNK];
+    int valid[EXTRAKEYS_BATCH_CHUNK];
+    rustsecp256k1_v0_11_ge p;
+    rustsecp256k1_v0_11_scalar t;
+    rustsecp256k1_v0_11_sha256 sha;
+    unsigned char buf[32];
+    size_t i, j, chunk;
+    int overflow;
+    int ret = 1;
+
+    if (n > 0) {
+        memset(output_pubkeys, 0, n * sizeof(*output_pubkeys));
+        memset(pk_parities, 0, n * sizeof(*pk_parities));
+    }
+    ARG_CHECK(rustsecp256k1_v0_11_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+
+    for (i = 0; i < n; i += chunk) {
+        chunk = n - i < EXTRAKEYS_BATCH_CHUNK ? n - i : EXTRAKEYS_BATCH_CHUNK;
+        for (j = 0; j < chunk; j++) {
+            valid[j] = rustsecp256k1_v0_11_xonly_pubkey_load(ctx, &p, &internal_pubkeys[i + j]);
+            if (!valid[j]) {
+                rustsecp256k1_v0_11_gej_set_infinity(&rj[j]);
+                continue;
+            }
+            if (taptweak != NULL) {
+                sha = *taptweak;
+                rustsecp256k1_v0_11_fe_get_b32(buf, &p.x);
+                rustsecp256k1_v0_11_sha256_write(&sha, buf, 32);
+                if (merkle_roots32 != NULL) {
+                    rustsecp256k1_v0_11_sha256_write(&sha, &merkle_roots32[32 * (i + j)], 32);
+                }
+                rustsecp256k1_v0_11_sha256_finalize(&sha, buf);
+                rustsecp256k1_v0_11_scalar_set_b32(&t, buf, &overflow);
+            } else {
+                rustsecp256k1_v0_11_scalar_set_b32(&t, &tweaks32[32 * (i + j)], &overflow);
+            }
+            valid[j] = !overflow;
+            rustsecp256k1_v0_11_ecmult_gen(&ctx->ecmult_gen_ctx, &rj[j], &t);
+            rustsecp256k1_v0_11_gej_add_ge_var(&rj[j], &rj[j], &p, NULL);
+        }
+        rustsecp256k1_v0_11_ge_set_all_gej_var(r, rj, chunk);
+
+        for (j = 0; j < chunk; j++) {
+            if (valid[j] && !rustsecp256k1_v0_11_ge_is_infinity(&r[j])) {
+                rustsecp256k1_v0_11_fe_normalize_var(&r[j].y);
+                pk_parities[i + j] = rustsecp256k1_v0_11_extrakeys_ge_even_y(&r[j]);
+                rustsecp256k1_v0_11_xonly_pubkey_save(&output_pubkeys[i + j], &r[j]);
+            } else {
+                ret = 0;
+            }
+        }
+    }
+
+    return ret;
+}
+
+int rustsecp256k1_v0_11_xonly_pubkey_tweak_add_batch(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_xonly_pubkey *output_pubkeys, int *pk_parities, const rustsecp256k1_v0_11_xonly_pubkey *internal_pubkeys, const unsigned char *tweaks32, size_t n) {
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(output_pubkeys != NULL || n == 0);
+    ARG_CHECK(pk_parities != NULL || n == 0);
+    ARG_CHECK(internal_pubkeys != NULL || n == 0);
+    ARG_CHECK(tweaks32 != NULL || n == 0);
+
+    return rustsecp256k1_v0_11_xonly_pubkey_tweak_add_batch_impl(ctx, output_pubkeys, pk_parities, internal_pubkeys, tweaks32, NULL, NULL, n);
+}
+
+int rustsecp256k1_v0_11_xonly_pubkey_taptweak_add_batch(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_xonly_pubkey *output_pubkeys, int *pk_parities, const rustsecp256k1_v0_11_xonly_pubkey *internal_pubkeys, const unsigned char *merkle_roots32, size_t n) {
+    static const unsigned char tag[] = {'T', 'a', 'p', 'T', 'w', 'e', 'a', 'k'};
+    rustsecp256k1_v0_11_sha256 taptweak;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(output_pubkeys != NULL || n == 0);
+    ARG_CHECK(pk_parities != NULL || n == 0);
+    ARG_CHECK(internal_pubkeys != NULL || n == 0);
+
+    rustsecp256k1_v0_11_sha256_initialize_tagged(&taptweak, tag, sizeof(tag));
+    return rustsecp256k1_v0_11_xonly_pubkey_tweak_add_batch_impl(ctx, output_pubkeys, pk_parities, internal_pubkeys, NULL, &taptweak, merkle_roots32, n);
+}
+
+size_t rustsecp256k1_v0_11_keypair_import_check_batch_scratch_size(size_t n) {
+    return n * (sizeof(rustsecp256k1_v0_11_ge) + sizeof(rustsecp256k1_v0_11_scalar)) + 2 * ALIGNMENT
+        + rustsecp256k1_v0_11_ext_ecmult_multi_scratch_size(n);
+}
+
+int rustsecp256k1_v0_11_keypair_import_check_batch(const rustsecp256k1_v0_11_context *ctx, void *scratch_mem, size_t scratch_size, const unsigned char *seckeys32, const rustsecp256k1_v0_11_pubkey *pubkeys, size_t n) {
+    rustsecp256k1_v0_11_scratch scratch;
+    rustsecp256k1_v0_11_ext_batch_data data;
+    rustsecp256k1_v0_11_ge *points;
+    rustsecp256k1_v0_11_scalar *scalars;
+    rustsecp256k1_v0_11_scalar x, s;
+    rustsecp256k1_v0_11_sha256 sha;
+    rustsecp256k1_v0_11_gej sj, pj;
+    unsigned char seed[32];
+    size_t i;
+    int ret = 1;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(rustsecp256k1_v0_11_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(scratch_mem != NULL);
+    ARG_CHECK(seckeys32 != NULL || n == 0);
+    ARG_CHECK(pubkeys != NULL || n == 0);
+
+    rustsecp256k1_v0_11_ext_scratch_init(&scratch, scratch_mem, scratch_size);
+    points = (rustsecp256k1_v0_11_ge *)rustsecp256k1_v0_11_scratch_alloc(&ctx->error_callback, &scratch, n * sizeof(*points));
+    scalars = (rustsecp256k1_v0_11_scalar *)rustsecp256k1_v0_11_scratch_alloc(&ctx->error_callback, &scratch, n * sizeof(*scalars));
+    if (points == NULL || scalars == NULL) {
+        return 0;
+    }
+
+    /* The secret keys go into the seed too, so that whoever wrote the public keys cannot
+     * predict the randomizers without knowing them. */
+    rustsecp256k1_v0_11_sha256_initialize(&sha);
+    for (i = 0; i < n; i++) {
+        if (!rustsecp256k1_v0_11_pubkey_load(ctx, &points[i], &pubkeys[i])) {
+            return 0;
+        }
+        rustsecp256k1_v0_11_sha256_write(&sha, pubkeys[i].data, sizeof(pubkeys[i].data));
+        rustsecp256k1_v0_11_sha256_write(&sha, &seckeys32[32 * i], 32);
+    }
+    rustsecp256k1_v0_11_sha256_finalize(&sha, seed);
+    rustsecp256k1_v0_11_sha256_clear(&sha);
+
+    /* s = sum(a_i*x_i), computed in constant time. */
+    rustsecp256k1_v0_11_scalar_clear(&s);
+    for (i = 0; i < n; i++) {
+        ret &= rustsecp256k1_v0_11_scalar_set_b32_seckey(&x, &seckeys32[32 * i]);
+        rustsecp256k1_v0_11_ext_batch_randomizer(&scalars[i], seed, i);
+        rustsecp256k1_v0_11_scalar_mul(&x, &x, &scalars[i]);
+        rustsecp256k1_v0_11_scalar_add(&s, &s, &x);
+    }
+    rustsecp256k1_v0_11_ecmult_gen(&ctx->ecmult_gen_ctx, &sj, &s);
+    rustsecp256k1_v0_11_scalar_clear(&x);
+    rustsecp256k1_v0_11_scalar_clear(&s);
+    memset(seed, 0, sizeof(seed));
+
+    /* Check that sum(a_i*P_i) - s*G is infinity. */
+    data.points = points;
+    data.scalars = scalars;
+    if (!rustsecp256k1_v0_11_ecmult_multi_var(&ctx->error_callback, &scratch, &pj, &rustsecp256k1_v0_11_scalar_zero, rustsecp256k1_v0_11_ext_batch_callback, &data, n)) {
+        rustsecp256k1_v0_11_gej_clear(&sj);
+        return 0;
+    }
+    rustsecp256k1_v0_11_gej_neg(&sj, &sj);
+    rustsecp256k1_v0_11_gej_add_var(&pj, &pj, &sj, NULL);
+    ret &= rustsecp256k1_v0_11_gej_is_infinity(&pj);
+    rustsecp256k1_v0_11_gej_clear(&sj);
+    return ret;
+}
+
+#endif /* SECP256K1_MODULE_EXTRAKEYS_BATCH_MAIN_H */
@@ -0,0 +1,346 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_MODULE_FIXED_BASE_MAIN_H
+#define SECP256K1_MODULE_FIXED_BASE_MAIN_H
+
+#include "../../include/secp256k1_fixed_base.h"
+
+/* The tables use the signed-digit multi-comb of ecmult_gen, with the comb
+ * parameters chosen at runtime instead of by COMB_TEETH and COMB_BLOCKS. See
+ * ecmult_gen_impl.h for the algorithm; the notation here follows it.
+ *
+ * The parameter checks bound the number of bits covered by the comb to less
+ * than 256 + 136, well within FIXED_BASE_MAX_BITS. */
+#define FIXED_BASE_MAX_TEETH 8
+#define FIXED_BASE_MAX_BLOCKS 256
+#define FIXED_BASE_MAX_BITS 512
+
+/* Returns the spacing of the comb, or 0 if the parameters are not supported. */
+static unsigned int rustsecp256k1_v0_11_fixed_base_spacing(unsigned int teeth, unsigned int blocks) {
+    unsigned int spacing;
+
+    if (teeth < 1 || teeth > FIXED_BASE_MAX_TEETH || blocks < 1 || blocks > FIXED_BASE_MAX_BLOCKS) {
+        return 0;
+    }
+    spacing = CEIL_DIV(256, blocks * teeth);
+    /* As the "can be reduced" checks in ecmult_gen.h. */
+    if ((blocks - 1) * teeth * spacing >= 256 || blocks * (teeth - 1) * spacing >= 256) {
+        return 0;
+    }
+    VERIFY_CHECK(blocks * teeth * spacing <= FIXED_BASE_MAX_BITS);
+    return spacing;
+}
+
+/* Sets diff to (2^bits - 1)/2, the offset between the scalar and the comb digits. */
+static void rustsecp256k1_v0_11_fixed_base_scalar_diff(rustsecp256k1_v0_11_scalar *diff, unsigned int bits) {
+    rustsecp256k1_v0_11_scalar neghalf;
+    unsigned char b32[32] = {0};
+    unsigned int i;
+
+    rustsecp256k1_v0_11_scalar_half(&neghalf, &rustsecp256k1_v0_11_scalar_one);
+    rustsecp256k1_v0_11_scalar_negate(&neghalf, &neghalf);
+
+    /* 2^(bits - 1), starting from a power of two below the group order. */
+    i = bits - 1 < 255 ? bits - 1 : 255;
+    b32[31 - i / 8] = 1 << (i % 8);
+    rustsecp256k1_v0_11_scalar_set_b32(diff, b32, NULL);
+    for (; i < bits - 1; ++i) {
+        rustsecp256k1_v0_11_scalar_add(diff, diff, diff);
+    }
+    rustsecp256k1_v0_11_scalar_add(diff, diff, &neghalf);
+}
+
+/* Loads the scalar, replaced by one if it is zero or overflows, and encodes the comb digits
+ * of scalar + diff into recoded. Returns whether the scalar was valid. */
+static int rustsecp256k1_v0_11_fixed_base_recode(uint32_t *recoded, const unsigned char *scalar32, unsigned int bits) {
+    rustsecp256k1_v0_11_scalar s, diff;
+    int overflow, ret, i;
+
+    rustsecp256k1_v0_11_scalar_set_b32(&s, scalar32, &overflow);
+    ret = !overflow & !rustsecp256k1_v0_11_scalar_is_zero(&s);
+    rustsecp256k1_v0_11_scalar_cmov(&s, &rustsecp256k1_v0_11_scalar_one, !ret);
+
+    rustsecp256k1_v0_11_fixed_base_scalar_diff(&diff, bits);
+    rustsecp256k1_v0_11_scalar_add(&s, &s, &diff);
+    memset(recoded, 0, FIXED_BASE_MAX_BITS / 8);
+    for (i = 0; i < 8; ++i) {
+        recoded[i] = rustsecp256k1_v0_11_scalar_get_bits_limb32(&s, 32 * i, 32);
+    }
+    rustsecp256k1_v0_11_scalar_clear(&s);
+    return ret;
+}
+
+/* Sets u to point/2, the multiple of the point that the first tooth of the first block adds. */
+static void rustsecp256k1_v0_11_fixed_base_start(rustsecp256k1_v0_11_gej *u, const rustsecp256k1_v0_11_ge *p) {
+    rustsecp256k1_v0_11_scalar half;
+
+    rustsecp256k1_v0_11_scalar_half(&half, &rustsecp256k1_v0_11_scalar_one);
+    rustsecp256k1_v0_11_gej_set_ge(u, p);
+    rustsecp256k1_v0_11_ecmult(u, u, &half, &rustsecp256k1_v0_11_scalar_zero);
+}
+
+/* Computes the 2^(teeth-1) entries of the next block in vs, as ecmult_gen_compute_table, and
+ * advances u, the running power of two times the point, to the next block. */
+static void rustsecp256k1_v0_11_fixed_base_block(rustsecp256k1_v0_11_gej *vs, rustsecp256k1_v0_11_gej *u, unsigned int teeth, unsigned int spacing) {
+    rustsecp256k1_v0_11_gej ds[FIXED_BASE_MAX_TEETH];
+    rustsecp256k1_v0_11_gej sum;
+    size_t index, stride, pos;
+    unsigned int tooth, bit_off;
+
+    rustsecp256k1_v0_11_gej_set_infinity(&sum);
+    for (tooth = 0; tooth < teeth; ++tooth) {
+        rustsecp256k1_v0_11_gej_add_var(&sum, &sum, u, NULL);
+        rustsecp256k1_v0_11_gej_double_var(u, u, NULL);
+        ds[tooth] = *u;
+        for (bit_off = 1; bit_off < spacing; ++bit_off) {
+            rustsecp256k1_v0_11_gej_double_var(u, u, NULL);
+        }
+    }
+    pos = 0;
+    rustsecp256k1_v0_11_gej_neg(&vs[pos++], &sum);
+    for (tooth = 0; tooth < teeth - 1; ++tooth) {
+        stride = (size_t)1 << tooth;
+        for (index = 0; index < stride; ++index, ++pos) {
+            rustsecp256k1_v0_11_gej_add_var(&vs[pos], &vs[pos - stride], &ds[tooth], NULL);
+        }
+    }
+    VERIFY_CHECK(pos == (size_t)1 << (teeth - 1));
+}
+
+size_t rustsecp256k1_v0_11_fixed_base_table_size(unsigned int teeth, unsigned int blocks) {
+    if (rustsecp256k1_v0_11_fixed_base_spacing(teeth, blocks) == 0) {
+        return 0;
+    }
+    return ((size_t)blocks << (teeth - 1)) * sizeof(rustsecp256k1_v0_11_ge_storage);
+}
+
+int rustsecp256k1_v0_11_fixed_base_table_build(const rustsecp256k1_v0_11_context *ctx, void *table, const rustsecp256k1_v0_11_pubkey *point, unsigned int teeth, unsigned int blocks) {
+    rustsecp256k1_v0_11_ge_storage *entries = (rustsecp256k1_v0_11_ge_storage *)table;
+    rustsecp256k1_v0_11_gej vs[1 << (FIXED_BASE_MAX_TEETH - 1)];
+    rustsecp256k1_v0_11_ge prec[1 << (FIXED_BASE_MAX_TEETH - 1)];
+    rustsecp256k1_v0_11_gej u;
+    rustsecp256k1_v0_11_ge p;
+    size_t points, index;
+    unsigned int spacing, block;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(table != NULL);
+    ARG_CHECK(point != NULL);
+
+    spacing = rustsecp256k1_v0_11_fixed_base_spacing(teeth, blocks);
+    if (spacing == 0 || !rustsecp256k1_v0_11_pubkey_load(ctx, &p, point)) {
+        return 0;
+    }
+    points = (size_t)1 << (teeth - 1);
+
+    /* Normalizing one block at a time. */
+    rustsecp256k1_v0_11_fixed_base_start(&u, &p);
+    for (block = 0; block < blocks; ++block) {
+        rustsecp256k1_v0_11_fixed_base_block(vs, &u, teeth, spacing);
+        rustsecp256k1_v0_11_ge_set_all_gej_var(prec, vs, points);
+        for (index = 0; index < points; ++index) {
+            /* Each entry is a fixed nonzero multiple of the point, which is at infinity only
+             * for parameters where that multiple is divisible by the group order. */
+            if (rustsecp256k1_v0_11_ge_is_infinity(&prec[index])) {
+                return 0;
+            }
+            rustsecp256k1_v0_11_ge_to_storage(&entries[block * points + index], &prec[index]);
+        }
+    }
+
+    return 1;
+}
+
+int rustsecp256k1_v0_11_fixed_base_mul(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_pubkey *result, const void *table, unsigned int teeth, unsigned int blocks, const unsigned char *scalar32) {
+    const rustsecp256k1_v0_11_ge_storage *entries = (const rustsecp256k1_v0_11_ge_storage *)table;
+    uint32_t recoded[FIXED_BASE_MAX_BITS / 32];
+    rustsecp256k1_v0_11_gej r;
+    rustsecp256k1_v0_11_ge add;
+    rustsecp256k1_v0_11_ge_storage adds;
+    rustsecp256k1_v0_11_fe neg;
+    unsigned int spacing, comb_off, points;
+    int first = 1, ret;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(result != NULL);
+    memset(result, 0, sizeof(*result));
+    ARG_CHECK(table != NULL);
+    ARG_CHECK(scalar32 != NULL);
+    spacing = rustsecp256k1_v0_11_fixed_base_spacing(teeth, blocks);
+    ARG_CHECK(spacing != 0);
+    points = 1U << (teeth - 1);
+
+    ret = rustsecp256k1_v0_11_fixed_base_recode(recoded, scalar32, blocks * teeth * spacing);
+    memset(&adds, 0, sizeof(adds));
+
+    /* The comb loop of ecmult_gen. */
+    comb_off = spacing - 1;
+    while (1) {
+        unsigned int block;
+        uint32_t bit_pos = comb_off;
+        for (block = 0; block < blocks; ++block) {
+            uint32_t bits = 0, sign, abs, index, tooth;
+            for (tooth = 0; tooth < teeth; ++tooth) {
+                uint32_t bitdata = rustsecp256k1_v0_11_rotr32(recoded[bit_pos >> 5], bit_pos & 0x1f);
+                uint32_t volatile vmask = ~(1 << tooth);
+                bits &= vmask;
+                bits ^= bitdata << tooth;
+                bit_pos += spacing;
+            }
+
+            sign = (bits >> (teeth - 1)) & 1;
+            abs = (bits ^ -sign) & (points - 1);
+            VERIFY_CHECK(sign == 0 || sign == 1);
+            VERIFY_CHECK(abs < points);
+
+            for (index = 0; index < points; ++index) {
+                rustsecp256k1_v0_11_ge_storage_cmov(&adds, &entries[block * points + index], index == abs);
+            }
+
+            rustsecp256k1_v0_11_ge_from_storage(&add, &adds);
+            rustsecp256k1_v0_11_fe_negate(&neg, &add.y, 1);
+            rustsecp256k1_v0_11_fe_cmov(&add.y, &neg, sign);
+
+            if (EXPECT(first, 0)) {
+                rustsecp256k1_v0_11_gej_set_ge(&r, &add);
+                if (rustsecp256k1_v0_11_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx)) {
+                    rustsecp256k1_v0_11_gej_rescale(&r, &ctx->ecmult_gen_ctx.proj_blind);
+                }
+                first = 0;
+            } else {
+                rustsecp256k1_v0_11_gej_add_ge(&r, &r, &add);
+            }
+        }
+
+        if (comb_off-- == 0) break;
+        rustsecp256k1_v0_11_gej_double(&r, &r);
+    }
+
+    /* The product of a nonzero scalar and a point of prime order is never at infinity. */
+    rustsecp256k1_v0_11_ge_set_gej(&add, &r);
+    rustsecp256k1_v0_11_pubkey_save(result, &add);
+    rustsecp256k1_v0_11_memczero(result, sizeof(*result), !ret);
+
+    rustsecp256k1_v0_11_gej_clear(&r);
+    rustsecp256k1_v0_11_ge_clear(&add);
+    rustsecp256k1_v0_11_fe_clear(&neg);
+    rustsecp256k1_v0_11_memclear(&adds, sizeof(adds));
+    rustsecp256k1_v0_11_memclear(recoded, sizeof(recoded));
+    return ret;
+}
+
+int rustsecp256k1_v0_11_fixed_base_mul_var(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_pubkey *result, const void *table, unsigned int teeth, unsigned int blocks, const unsigned char *scalar32) {
+    const rustsecp256k1_v0_11_ge_storage *entries = (const rustsecp256k1_v0_11_ge_storage *)table;
+    uint32_t recoded[FIXED_BASE_MAX_BITS / 32];
+    rustsecp256k1_v0_11_gej r;
+    rustsecp256k1_v0_11_ge add;
+    unsigned int spacing, comb_off, points;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(result != NULL);
+    memset(result, 0, sizeof(*result));
+    ARG_CHECK(table != NULL);
+    ARG_CHECK(scalar32 != NULL);
+    spacing = rustsecp256k1_v0_11_fixed_base_spacing(teeth, blocks);
+    ARG_CHECK(spacing != 0);
+    points = 1U << (teeth - 1);
+
+    if (!rustsecp256k1_v0_11_fixed_base_recode(recoded, scalar32, blocks * teeth * spacing)) {
+        return 0;
+    }
+
+    /* The same comb, indexing the table directly. */
+    rustsecp256k1_v0_11_gej_set_infinity(&r);
+    comb_off = spacing - 1;
+    while (1) {
+        unsigned int block;
+        uint32_t bit_pos = comb_off;
+        for (block = 0; block < blocks; ++block) {
+            uint32_t bits = 0, sign, tooth;
+            for (tooth = 0; tooth < teeth; ++tooth) {
+                bits |= ((recoded[bit_pos >> 5] >> (bit_pos & 0x1f)) & 1) << tooth;
+                bit_pos += spacing;
+            }
+            sign = bits >> (teeth - 1);
+            rustsecp256k1_v0_11_ge_from_storage(&add, &entries[block * points + ((bits ^ -sign) & (points - 1))]);
+            if (sign) {
+                rustsecp256k1_v0_11_ge_neg(&add, &add);
+            }
+            rustsecp256k1_v0_11_gej_add_ge_var(&r, &r, &add, NULL);
+        }
+
+        if (comb_off-- == 0) break;
+        rustsecp256k1_v0_11_gej_double_var(&r, &r, NULL);
+    }
+
+    rustsecp256k1_v0_11_ge_set_gej_var(&add, &r);
+    if (rustsecp256k1_v0_11_ge_is_infinity(&add)) {
+        return 0;
+    }
+    rustsecp256k1_v0_11_pubkey_save(result, &add);
+    return 1;
+}
+
+int rustsecp256k1_v0_11_fixed_base_table_serialize(const rustsecp256k1_v0_11_context *ctx, unsigned char *output, const void *table, unsigned int teeth, unsigned int blocks) {
+    const rustsecp256k1_v0_11_ge_storage *entries = (const rustsecp256k1_v0_11_ge_storage *)table;
+    rustsecp256k1_v0_11_ge p;
+    size_t i, n;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(output != NULL);
+    ARG_CHECK(table != NULL);
+
+    if (rustsecp256k1_v0_11_fixed_base_spacing(teeth, blocks) == 0) {
+        return 0;
+    }
+    n = (size_t)blocks << (teeth - 1);
+    for (i = 0; i < n; ++i) {
+        rustsecp256k1_v0_11_ge_from_storage(&p, &entries[i]);
+        rustsecp256k1_v0_11_fe_get_b32(output + 64 * i, &p.x);
+        rustsecp256k1_v0_11_fe_get_b32(output + 64 * i + 32, &p.y);
+    }
+    return 1;
+}
+
+int rustsecp256k1_v0_11_fixed_base_table_parse(const rustsecp256k1_v0_11_context *ctx, void *table, const unsigned char *input, const rustsecp256k1_v0_11_pubkey *point, unsigned int teeth, unsigned int blocks) {
+    rustsecp256k1_v0_11_ge_storage *entries = (rustsecp256k1_v0_11_ge_storage *)table;
+    rustsecp256k1_v0_11_gej vs[1 << (FIXED_BASE_MAX_TEETH - 1)];
+    rustsecp256k1_v0_11_gej u;
+    rustsecp256k1_v0_11_fe x, y;
+    rustsecp256k1_v0_11_ge p;
+    size_t i, n;
+    unsigned int spacing;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(table != NULL);
+    ARG_CHECK(input != NULL);
+    ARG_CHECK(point != NULL);
+
+    spacing = rustsecp256k1_v0_11_fixed_base_spacing(teeth, blocks);
+    if (spacing == 0 || !rustsecp256k1_v0_11_pubkey_load(ctx, &p, point)) {
+        return 0;
+    }
+
+    /* Recompute the first block, which costs one multiplication and about 256 / blocks
+     * doublings, and compare it with the input. */
+    rustsecp256k1_v0_11_fixed_base_start(&u, &p);
+    rustsecp256k1_v0_11_fixed_base_block(vs, &u, teeth, spacing);
+    n = (size_t)blocks << (teeth - 1);
+    for (i = 0; i < n; ++i) {
+        if (!rustsecp256k1_v0_11_fe_set_b32_limit(&x, input + 64 * i)
+            || !rustsecp256k1_v0_11_fe_set_b32_limit(&y, input + 64 * i + 32)) {
+            return 0;
+        }
+        rustsecp256k1_v0_11_ge_set_xy(&p, &x, &y);
+        if (!rustsecp256k1_v0_11_ge_is_valid_var(&p)) {
+            return 0;
+        }
+        if (i < ((size_t)1 << (teeth - 1)) && !rustsecp256k1_v0_11_gej_eq_ge_var(&vs[i], &p)) {
+            return 0;
+        }
+        rustsecp256k1_v0_11_ge_to_storage(&entries[i], &p);
+    }
+    return 1;
+}
+
+#endif /* SECP256K1_MODULE_FIXED_BASE_MAIN_H */
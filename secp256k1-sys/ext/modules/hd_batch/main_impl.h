@@ -0,0 +1,57 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_MODULE_HD_BATCH_MAIN_H
+#define SECP256K1_MODULE_HD_BATCH_MAIN_H
+
+#include "../../include/secp256k1_hd_batch.h"
+
+/* Number of children normalized with a single field inversion. */
+#define HD_BATCH_CHUNK 16
+
+int rustsecp256k1_v0_11_ec_pubkey_derive_batch(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_pubkey *children, const rustsecp256k1_v0_11_pubkey *parent, const unsigned char *tweaks32, size_t n) {
+    rustsecp256k1_v0_11_gej rj[HD_BATCH_CHUNK];
+    rustsecp256k1_v0_11_ge r[HD_BATCH_CHUNK];
+    int valid[HD_BATCH_CHUNK];
+    rustsecp256k1_v0_11_ge p;
+    rustsecp256k1_v0_11_scalar t;
+    size_t i, j, chunk;
+    int overflow;
+    int ret = 1;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(children != NULL || n == 0);
+    if (n > 0) {
+        memset(children, 0, n * sizeof(*children));
+    }
+    ARG_CHECK(rustsecp256k1_v0_11_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(parent != NULL);
+    ARG_CHECK(tweaks32 != NULL || n == 0);
+
+    /* The parent's affine point is shared by all children. */
+    if (!rustsecp256k1_v0_11_pubkey_load(ctx, &p, parent)) {
+        return 0;
+    }
+
+    for (i = 0; i < n; i += chunk) {
+        chunk = n - i < HD_BATCH_CHUNK ? n - i : HD_BATCH_CHUNK;
+        for (j = 0; j < chunk; j++) {
+            rustsecp256k1_v0_11_scalar_set_b32(&t, tweaks32 + 32 * (i + j), &overflow);
+            valid[j] = !overflow;
+            rustsecp256k1_v0_11_ecmult_gen(&ctx->ecmult_gen_ctx, &rj[j], &t);
+            rustsecp256k1_v0_11_gej_add_ge_var(&rj[j], &rj[j], &p, NULL);
+        }
+        rustsecp256k1_v0_11_ge_set_all_gej_var(r, rj, chunk);
+
+        for (j = 0; j < chunk; j++) {
+            if (valid[j] && !rustsecp256k1_v0_11_ge_is_infinity(&r[j])) {
+                rustsecp256k1_v0_11_pubkey_save(&children[i + j], &r[j]);
+            } else {
+                ret = 0;
+            }
+        }
+    }
+
+    return ret;
+}
+
+#endif /* SECP256K1_MODULE_HD_BATCH_MAIN_H */
@@ -0,0 +1,37 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_MODULE_INSTRUMENTATION_MAIN_H
+#define SECP256K1_MODULE_INSTRUMENTATION_MAIN_H
+
+#include "../../include/secp256k1_instrumentation.h"
+
+int rustsecp256k1_v0_11_stats_snapshot(uint64_t *counts, uint64_t *cycles, size_t n) {
+    size_t i;
+
+    if (n > SECP256K1_STATS_NUM) {
+        n = SECP256K1_STATS_NUM;
+    }
+    for (i = 0; i < n; i++) {
+        counts[i] = rustsecp256k1_v0_11_stats_counts[i];
+    }
+#if SECP256K1_STATS_HAVE_CYCLES
+    if (cycles != NULL) {
+        for (i = 0; i < n; i++) {
+            cycles[i] = rustsecp256k1_v0_11_stats_cycles[i];
+        }
+    }
+    return 1;
+#else
+    (void)cycles;
+    return 0;
+#endif
+}
+
+void rustsecp256k1_v0_11_stats_reset(void) {
+    memset(rustsecp256k1_v0_11_stats_counts, 0, sizeof(rustsecp256k1_v0_11_stats_counts));
+#if SECP256K1_STATS_HAVE_CYCLES
+    memset(rustsecp256k1_v0_11_stats_cycles, 0, sizeof(rustsecp256k1_v0_11_stats_cycles));
+#endif
+}
+
+#endif /* SECP256K1_MODULE_INSTRUMENTATION_MAIN_H */
@@ -0,0 +1,56 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_MODULE_PUBKEY_BATCH_MAIN_H
+#define SECP256K1_MODULE_PUBKEY_BATCH_MAIN_H
+
+#include "../../include/secp256k1_pubkey_batch.h"
+
+/* Lifts the x coordinate x32 to the point with the given y parity. */
+static int rustsecp256k1_v0_11_pubkey_batch_lift(rustsecp256k1_v0_11_ge *p, const unsigned char *x32, int odd) {
+    rustsecp256k1_v0_11_fe x;
+    return rustsecp256k1_v0_11_fe_set_b32_limit(&x, x32) && rustsecp256k1_v0_11_ge_set_xo_var(p, &x, odd);
+}
+
+int rustsecp256k1_v0_11_ec_pubkey_decompress_batch(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_pubkey *pubkeys, const unsigned char *x32s, const unsigned char *odd_bitmap, size_t offset, size_t n) {
+    rustsecp256k1_v0_11_ge p;
+    size_t i, bit;
+    int ret = 1;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(pubkeys != NULL || n == 0);
+    ARG_CHECK(x32s != NULL || n == 0);
+    ARG_CHECK(odd_bitmap != NULL || n == 0);
+
+    for (i = 0; i < n; i++) {
+        bit = offset + i;
+        if (rustsecp256k1_v0_11_pubkey_batch_lift(&p, &x32s[32 * i], (odd_bitmap[bit / 8] >> (bit % 8)) & 1)) {
+            rustsecp256k1_v0_11_pubkey_save(&pubkeys[i], &p);
+        } else {
+            memset(&pubkeys[i], 0, sizeof(pubkeys[i]));
+            ret = 0;
+        }
+    }
+    return ret;
+}
+
+int rustsecp256k1_v0_11_xonly_pubkey_parse_batch(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_xonly_pubkey *pubkeys, const unsigned char *x32s, size_t n) {
+    rustsecp256k1_v0_11_ge p;
+    size_t i;
+    int ret = 1;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(pubkeys != NULL || n == 0);
+    ARG_CHECK(x32s != NULL || n == 0);
+
+    for (i = 0; i < n; i++) {
+        if (rustsecp256k1_v0_11_pubkey_batch_lift(&p, &x32s[32 * i], 0)) {
+            rustsecp256k1_v0_11_xonly_pubkey_save(&pubkeys[i], &p);
+        } else {
+            memset(&pubkeys[i], 0, sizeof(pubkeys[i]));
+            ret = 0;
+        }
+    }
+    return ret;
+}
+
+#endif /* SECP256K1_MODULE_PUBKEY_BATCH_MAIN_H */
@@ -0,0 +1,101 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_MODULE_PUBKEY_SORT_MAIN_H
+#define SECP256K1_MODULE_PUBKEY_SORT_MAIN_H
+
+#include "../../include/secp256k1_pubkey_sort.h"
+
+/* Keys are distributed by the parity byte and the first byte of x. */
+#define PUBKEY_SORT_BUCKETS 512
+
+/* Buckets up to this size are sorted by insertion, larger ones with hsort. */
+#define PUBKEY_SORT_INSERTION_MAX 16
+
+typedef struct {
+    unsigned char ser[33];
+    const rustsecp256k1_v0_11_pubkey *pubkey;
+} rustsecp256k1_v0_11_pubkey_sort_record;
+
+static size_t rustsecp256k1_v0_11_pubkey_sort_bucket(const rustsecp256k1_v0_11_pubkey_sort_record *r) {
+    /* Invalid keys serialize as all zeros and land in bucket 0 with the keys starting
+     * with 0x02 0x00, which they precede. */
+    return ((size_t)(r->ser[0] & 1) << 8) | r->ser[1];
+}
+
+static int rustsecp256k1_v0_11_pubkey_sort_record_cmp(const void *a, const void *b, void *data) {
+    (void)data;
+    return rustsecp256k1_v0_11_memcmp_var(((const rustsecp256k1_v0_11_pubkey_sort_record *)a)->ser,
+                                      ((const rustsecp256k1_v0_11_pubkey_sort_record *)b)->ser, 33);
+}
+
+static void rustsecp256k1_v0_11_pubkey_sort_insertion(rustsecp256k1_v0_11_pubkey_sort_record *r, size_t n) {
+    rustsecp256k1_v0_11_pubkey_sort_record tmp;
+    size_t i, j;
+
+    for (i = 1; i < n; i++) {
+        tmp = r[i];
+        for (j = i; j > 0 && rustsecp256k1_v0_11_memcmp_var(r[j - 1].ser, tmp.ser, 33) > 0; j--) {
+            r[j] = r[j - 1];
+        }
+        r[j] = tmp;
+    }
+}
+
+size_t rustsecp256k1_v0_11_ec_pubkey_sort_scratch_size(size_t n_pubkeys) {
+    return 2 * n_pubkeys * sizeof(rustsecp256k1_v0_11_pubkey_sort_record);
+}
+
+int rustsecp256k1_v0_11_ec_pubkey_sort_scratch(const rustsecp256k1_v0_11_context *ctx, const rustsecp256k1_v0_11_pubkey **pubkeys, size_t n_pubkeys, void *scratch, size_t scratch_size) {
+    rustsecp256k1_v0_11_pubkey_sort_record *records, *sorted;
+    size_t offsets[PUBKEY_SORT_BUCKETS];
+    size_t i, b, start, end, len;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(pubkeys != NULL);
+    ARG_CHECK(scratch != NULL || n_pubkeys == 0);
+    ARG_CHECK(scratch_size >= rustsecp256k1_v0_11_ec_pubkey_sort_scratch_size(n_pubkeys));
+    if (n_pubkeys == 0) {
+        return 1;
+    }
+    records = (rustsecp256k1_v0_11_pubkey_sort_record *)scratch;
+    sorted = records + n_pubkeys;
+
+    /* Serialize every key once, as ec_pubkey_cmp would. */
+    memset(offsets, 0, sizeof(offsets));
+    for (i = 0; i < n_pubkeys; i++) {
+        len = sizeof(records[i].ser);
+        if (!rustsecp256k1_v0_11_ec_pubkey_serialize(ctx, records[i].ser, &len, pubkeys[i], SECP256K1_EC_COMPRESSED)) {
+            memset(records[i].ser, 0, sizeof(records[i].ser));
+        }
+        records[i].pubkey = pubkeys[i];
+        offsets[rustsecp256k1_v0_11_pubkey_sort_bucket(&records[i])]++;
+    }
+
+    /* Counting sort by bucket, then sort within the buckets. */
+    start = 0;
+    for (b = 0; b < PUBKEY_SORT_BUCKETS; b++) {
+        len = offsets[b];
+        offsets[b] = start;
+        start += len;
+    }
+    for (i = 0; i < n_pubkeys; i++) {
+        sorted[offsets[rustsecp256k1_v0_11_pubkey_sort_bucket(&records[i])]++] = records[i];
+    }
+    start = 0;
+    for (b = 0; b < PUBKEY_SORT_BUCKETS; b++) {
+        end = offsets[b];
+        if (end - start <= PUBKEY_SORT_INSERTION_MAX) {
+            rustsecp256k1_v0_11_pubkey_sort_insertion(&sorted[start], end - start);
+        } else {
+            rustsecp256k1_v0_11_hsort(&sorted[start], end - start, sizeof(*sorted), rustsecp256k1_v0_11_pubkey_sort_record_cmp, NULL);
+        }
+        start = end;
+    }
+
+    for (i = 0; i < n_pubkeys; i++) {
+        pubkeys[i] = sorted[i].pubkey;
+    }
+    return 1;
+}
+
+#endif /* SECP256K1_MODULE_PUBKEY_SORT_MAIN_H */
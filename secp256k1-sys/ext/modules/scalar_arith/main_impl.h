@@ -0,0 +1,126 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_MODULE_SCALAR_ARITH_MAIN_H
+#define SECP256K1_MODULE_SCALAR_ARITH_MAIN_H
+
+#include "../../include/secp256k1_scalar_arith.h"
+
+/* The unpacked scalars hold the limbs of rustsecp256k1_v0_11_scalar as they are in memory;
+ * both the 4x64 and the 8x32 representation are 32 bytes and always reduced. */
+static void rustsecp256k1_v0_11_unpacked_scalar_load(rustsecp256k1_v0_11_scalar *r, const rustsecp256k1_v0_11_unpacked_scalar *a) {
+    STATIC_ASSERT(sizeof(rustsecp256k1_v0_11_scalar) == sizeof(a->data));
+    memcpy(r, a->data, sizeof(*r));
+    SECP256K1_SCALAR_VERIFY(r);
+}
+
+static void rustsecp256k1_v0_11_unpacked_scalar_save(rustsecp256k1_v0_11_unpacked_scalar *r, const rustsecp256k1_v0_11_scalar *a) {
+    memcpy(r->data, a, sizeof(*a));
+}
+
+int rustsecp256k1_v0_11_unpacked_scalar_parse(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_unpacked_scalar *scalar, const unsigned char *input32) {
+    rustsecp256k1_v0_11_scalar s;
+    int overflow;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(scalar != NULL);
+    ARG_CHECK(input32 != NULL);
+
+    rustsecp256k1_v0_11_scalar_set_b32(&s, input32, &overflow);
+    rustsecp256k1_v0_11_scalar_cmov(&s, &rustsecp256k1_v0_11_scalar_zero, overflow);
+    rustsecp256k1_v0_11_unpacked_scalar_save(scalar, &s);
+    rustsecp256k1_v0_11_scalar_clear(&s);
+    return !overflow;
+}
+
+void rustsecp256k1_v0_11_unpacked_scalar_serialize(const rustsecp256k1_v0_11_context *ctx, unsigned char *output32, const rustsecp256k1_v0_11_unpacked_scalar *scalar) {
+    rustsecp256k1_v0_11_scalar s;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK_VOID(output32 != NULL);
+    ARG_CHECK_VOID(scalar != NULL);
+
+    rustsecp256k1_v0_11_unpacked_scalar_load(&s, scalar);
+    rustsecp256k1_v0_11_scalar_get_b32(output32, &s);
+    rustsecp256k1_v0_11_scalar_clear(&s);
+}
+
+void rustsecp256k1_v0_11_unpacked_scalar_add(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_unpacked_scalar *r, const rustsecp256k1_v0_11_unpacked_scalar *a, const rustsecp256k1_v0_11_unpacked_scalar *b) {
+    rustsecp256k1_v0_11_scalar sa, sb;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK_VOID(r != NULL);
+    ARG_CHECK_VOID(a != NULL);
+    ARG_CHECK_VOID(b != NULL);
+
+    rustsecp256k1_v0_11_unpacked_scalar_load(&sa, a);
+    rustsecp256k1_v0_11_unpacked_scalar_load(&sb, b);
+    rustsecp256k1_v0_11_scalar_add(&sa, &sa, &sb);
+    rustsecp256k1_v0_11_unpacked_scalar_save(r, &sa);
+    rustsecp256k1_v0_11_scalar_clear(&sa);
+    rustsecp256k1_v0_11_scalar_clear(&sb);
+}
+
+void rustsecp256k1_v0_11_unpacked_scalar_mul(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_unpacked_scalar *r, const rustsecp256k1_v0_11_unpacked_scalar *a, const rustsecp256k1_v0_11_unpacked_scalar *b) {
+    rustsecp256k1_v0_11_scalar sa, sb;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK_VOID(r != NULL);
+    ARG_CHECK_VOID(a != NULL);
+    ARG_CHECK_VOID(b != NULL);
+
+    rustsecp256k1_v0_11_unpacked_scalar_load(&sa, a);
+    rustsecp256k1_v0_11_unpacked_scalar_load(&sb, b);
+    rustsecp256k1_v0_11_scalar_mul(&sa, &sa, &sb);
+    rustsecp256k1_v0_11_unpacked_scalar_save(r, &sa);
+    rustsecp256k1_v0_11_scalar_clear(&sa);
+    rustsecp256k1_v0_11_scalar_clear(&sb);
+}
+
+void rustsecp256k1_v0_11_unpacked_scalar_negate(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_unpacked_scalar *r, const rustsecp256k1_v0_11_unpacked_scalar *a) {
+    rustsecp256k1_v0_11_scalar s;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK_VOID(r != NULL);
+    ARG_CHECK_VOID(a != NULL);
+
+    rustsecp256k1_v0_11_unpacked_scalar_load(&s, a);
+    rustsecp256k1_v0_11_scalar_negate(&s, &s);
+    rustsecp256k1_v0_11_unpacked_scalar_save(r, &s);
+    rustsecp256k1_v0_11_scalar_clear(&s);
+}
+
+int rustsecp256k1_v0_11_unpacked_scalar_inverse(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_unpacked_scalar *r, const rustsecp256k1_v0_11_unpacked_scalar *a) {
+    rustsecp256k1_v0_11_scalar s, inv;
+    int ret;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(r != NULL);
+    ARG_CHECK(a != NULL);
+
+    rustsecp256k1_v0_11_unpacked_scalar_load(&s, a);
+    ret = !rustsecp256k1_v0_11_scalar_is_zero(&s);
+    rustsecp256k1_v0_11_scalar_inverse(&inv, &s);
+    rustsecp256k1_v0_11_unpacked_scalar_save(r, &inv);
+    rustsecp256k1_v0_11_scalar_clear(&s);
+    rustsecp256k1_v0_11_scalar_clear(&inv);
+    return ret;
+}
+
+int rustsecp256k1_v0_11_unpacked_scalar_inverse_var(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_unpacked_scalar *r, const rustsecp256k1_v0_11_unpacked_scalar *a) {
+    rustsecp256k1_v0_11_scalar s, inv;
+    int ret;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(r != NULL);
+    ARG_CHECK(a != NULL);
+
+    rustsecp256k1_v0_11_unpacked_scalar_load(&s, a);
+    ret = !rustsecp256k1_v0_11_scalar_is_zero(&s);
+    rustsecp256k1_v0_11_scalar_inverse_var(&inv, &s);
+    rustsecp256k1_v0_11_unpacked_scalar_save(r, &inv);
+    rustsecp256k1_v0_11_scalar_clear(&s);
+    rustsecp256k1_v0_11_scalar_clear(&inv);
+    return ret;
+}
+
+#endif /* SECP256K1_MODULE_SCALAR_ARITH_MAIN_H */
@@ -0,0 +1,90 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_MODULE_SCHNORRSIG_BATCH_MAIN_H
+#define SECP256K1_MODULE_SCHNORRSIG_BATCH_MAIN_H
+
+#include "../../include/secp256k1_schnorrsig_batch.h"
+
+size_t rustsecp256k1_v0_11_schnorrsig_verify_batch_scratch_size(size_t n) {
+    return 2 * n * (sizeof(rustsecp256k1_v0_11_ge) + sizeof(rustsecp256k1_v0_11_scalar)) + 2 * ALIGNMENT
+        + rustsecp256k1_v0_11_ext_ecmult_multi_scratch_size(2 * n);
+}
+
+int rustsecp256k1_v0_11_schnorrsig_verify_batch(const rustsecp256k1_v0_11_context *ctx, void *scratch_mem, size_t scratch_size, const unsigned char *sig64s, const unsigned char * const *msgs, const size_t *msglens, const rustsecp256k1_v0_11_xonly_pubkey *pubkeys, size_t n) {
+    rustsecp256k1_v0_11_scratch scratch;
+    rustsecp256k1_v0_11_ext_batch_data data;
+    rustsecp256k1_v0_11_ge *points;
+    rustsecp256k1_v0_11_scalar *scalars;
+    rustsecp256k1_v0_11_scalar a, s, e, g_scalar;
+    rustsecp256k1_v0_11_sha256 sha;
+    rustsecp256k1_v0_11_gej rj;
+    rustsecp256k1_v0_11_fe rx;
+    unsigned char seed[32], buf[32];
+    size_t i;
+    int overflow;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(scratch_mem != NULL);
+    ARG_CHECK(sig64s != NULL || n == 0);
+    ARG_CHECK(msgs != NULL || n == 0);
+    ARG_CHECK(msglens != NULL || n == 0);
+    ARG_CHECK(pubkeys != NULL || n == 0);
+
+    rustsecp256k1_v0_11_ext_scratch_init(&scratch, scratch_mem, scratch_size);
+    points = (rustsecp256k1_v0_11_ge *)rustsecp256k1_v0_11_scratch_alloc(&ctx->error_callback, &scratch, 2 * n * sizeof(*points));
+    scalars = (rustsecp256k1_v0_11_scalar *)rustsecp256k1_v0_11_scratch_alloc(&ctx->error_callback, &scratch, 2 * n * sizeof(*scalars));
+    if (points == NULL || scalars == NULL) {
+        return 0;
+    }
+
+    /* Hash all inputs into the seed of the randomizers, see batch_impl.h. */
+    rustsecp256k1_v0_11_sha256_initialize(&sha);
+    for (i = 0; i < n; i++) {
+        ARG_CHECK(msgs[i] != NULL || msglens[i] == 0);
+        if (!rustsecp256k1_v0_11_xonly_pubkey_load(ctx, &points[n + i], &pubkeys[i])) {
+            return 0;
+        }
+        rustsecp256k1_v0_11_fe_get_b32(buf, &points[n + i].x);
+        rustsecp256k1_v0_11_sha256_write(&sha, &sig64s[64 * i], 64);
+        rustsecp256k1_v0_11_sha256_write(&sha, buf, 32);
+        rustsecp256k1_v0_11_ext_batch_write_le64(&sha, msglens[i]);
+        rustsecp256k1_v0_11_sha256_write(&sha, msgs[i], msglens[i]);
+    }
+    rustsecp256k1_v0_11_sha256_finalize(&sha, seed);
+
+    /* Each signature (r, s) on key P satisfies s*G = R + e*P with R the point with x
+     * coordinate r and even y. Check that sum(a_i*s_i)*G - sum(a_i*R_i) - sum(a_i*e_i*P_i)
+     * is infinity, with a_0 = 1. */
+    rustsecp256k1_v0_11_scalar_clear(&g_scalar);
+    for (i = 0; i < n; i++) {
+        const unsigned char *sig64 = &sig64s[64 * i];
+
+        if (!rustsecp256k1_v0_11_fe_set_b32_limit(&rx, &sig64[0])) {
+            return 0;
+        }
+        if (!rustsecp256k1_v0_11_ge_set_xo_var(&points[i], &rx, 0)) {
+            return 0;
+        }
+        rustsecp256k1_v0_11_scalar_set_b32(&s, &sig64[32], &overflow);
+        if (overflow) {
+            return 0;
+        }
+        rustsecp256k1_v0_11_fe_get_b32(buf, &points[n + i].x);
+        rustsecp256k1_v0_11_schnorrsig_challenge(&e, &sig64[0], msgs[i], msglens[i], buf);
+
+        rustsecp256k1_v0_11_ext_batch_randomizer(&a, seed, i);
+        rustsecp256k1_v0_11_scalar_mul(&s, &s, &a);
+        rustsecp256k1_v0_11_scalar_add(&g_scalar, &g_scalar, &s);
+        rustsecp256k1_v0_11_scalar_negate(&scalars[i], &a);
+        rustsecp256k1_v0_11_scalar_mul(&scalars[n + i], &scalars[i], &e);
+    }
+
+    data.points = points;
+    data.scalars = scalars;
+    if (!rustsecp256k1_v0_11_ecmult_multi_var(&ctx->error_callback, &scratch, &rj, &g_scalar, rustsecp256k1_v0_11_ext_batch_callback, &data, 2 * n)) {
+        return 0;
+    }
+    return rustsecp256k1_v0_11_gej_is_infinity(&rj);
+}
+
+#endif /* SECP256K1_MODULE_SCHNORRSIG_BATCH_MAIN_H */
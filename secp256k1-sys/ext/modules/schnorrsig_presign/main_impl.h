@@ -0,0 +1,76 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_MODULE_SCHNORRSIG_PRESIGN_MAIN_H
+#define SECP256K1_MODULE_SCHNORRSIG_PRESIGN_MAIN_H
+
+#include "../../include/secp256k1_schnorrsig_presign.h"
+
+int rustsecp256k1_v0_11_schnorrsig_presignature_create(const rustsecp256k1_v0_11_context *ctx, unsigned char *presig64, const unsigned char *nonce32) {
+    rustsecp256k1_v0_11_scalar k;
+    rustsecp256k1_v0_11_gej rj;
+    rustsecp256k1_v0_11_ge r;
+    int ret;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(rustsecp256k1_v0_11_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(presig64 != NULL);
+    ARG_CHECK(nonce32 != NULL);
+
+    ret = rustsecp256k1_v0_11_scalar_set_b32_seckey(&k, nonce32);
+    rustsecp256k1_v0_11_scalar_cmov(&k, &rustsecp256k1_v0_11_scalar_one, !ret);
+    rustsecp256k1_v0_11_ecmult_gen(&ctx->ecmult_gen_ctx, &rj, &k);
+    rustsecp256k1_v0_11_ge_set_gej(&r, &rj);
+
+    /* R is not secret, as in schnorrsig_sign_internal. */
+    rustsecp256k1_v0_11_declassify(ctx, &r, sizeof(r));
+    rustsecp256k1_v0_11_fe_normalize_var(&r.y);
+    if (rustsecp256k1_v0_11_fe_is_odd(&r.y)) {
+        rustsecp256k1_v0_11_scalar_negate(&k, &k);
+    }
+    rustsecp256k1_v0_11_fe_normalize_var(&r.x);
+    rustsecp256k1_v0_11_fe_get_b32(presig64, &r.x);
+    rustsecp256k1_v0_11_scalar_get_b32(presig64 + 32, &k);
+    rustsecp256k1_v0_11_memczero(presig64, 64, !ret);
+
+    rustsecp256k1_v0_11_scalar_clear(&k);
+    rustsecp256k1_v0_11_gej_clear(&rj);
+    return ret;
+}
+
+int rustsecp256k1_v0_11_schnorrsig_presignature_sign(const rustsecp256k1_v0_11_context *ctx, unsigned char *sig64, unsigned char *presig64, const unsigned char *msg, size_t msglen, const rustsecp256k1_v0_11_keypair *keypair) {
+    rustsecp256k1_v0_11_scalar sk, e, k;
+    rustsecp256k1_v0_11_ge pk;
+    unsigned char pk_buf[32];
+    int overflow;
+    int ret;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(sig64 != NULL);
+    ARG_CHECK(presig64 != NULL);
+    ARG_CHECK(msg != NULL || msglen == 0);
+    ARG_CHECK(keypair != NULL);
+
+    memcpy(sig64, presig64, 32);
+    rustsecp256k1_v0_11_scalar_set_b32(&k, presig64 + 32, &overflow);
+    rustsecp256k1_v0_11_memclear(presig64, 64);
+    ret = !overflow & !rustsecp256k1_v0_11_scalar_is_zero(&k);
+
+    ret &= rustsecp256k1_v0_11_keypair_load(ctx, &sk, &pk, keypair);
+    /* Sign for the x-only key, as in schnorrsig_sign_internal. */
+    if (rustsecp256k1_v0_11_fe_is_odd(&pk.y)) {
+        rustsecp256k1_v0_11_scalar_negate(&sk, &sk);
+    }
+    rustsecp256k1_v0_11_fe_get_b32(pk_buf, &pk.x);
+
+    rustsecp256k1_v0_11_schnorrsig_challenge(&e, sig64, msg, msglen, pk_buf);
+    rustsecp256k1_v0_11_scalar_mul(&e, &e, &sk);
+    rustsecp256k1_v0_11_scalar_add(&e, &e, &k);
+    rustsecp256k1_v0_11_scalar_get_b32(sig64 + 32, &e);
+    rustsecp256k1_v0_11_memczero(sig64, 64, !ret);
+
+    rustsecp256k1_v0_11_scalar_clear(&k);
+    rustsecp256k1_v0_11_scalar_clear(&sk);
+    return ret;
+}
+
+#endif /* SECP256K1_MODULE_SCHNORRSIG_PRESIGN_MAIN_H */
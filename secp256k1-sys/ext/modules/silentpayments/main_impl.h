@@ -0,0 +1,376 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_MODULE_SILENTPAYMENTS_MAIN_H
+#define SECP256K1_MODULE_SILENTPAYMENTS_MAIN_H
+
+#include "../../include/secp256k1_silentpayments.h"
+
+/* Number of transaction outputs whose label candidates are normalized together. */
+#define SILENTPAYMENTS_LABEL_CHUNK 16
+
+/* Initializes SHA256 with fixed midstate. This midstate was computed by applying
+ * SHA256 to SHA256("BIP0352/Inputs")||SHA256("BIP0352/Inputs"). */
+static void rustsecp256k1_v0_11_silentpayments_sha256_tagged_inputs(rustsecp256k1_v0_11_sha256 *sha) {
+    rustsecp256k1_v0_11_sha256_initialize(sha);
+    sha->s[0] = 0xd4143ffcul;
+    sha->s[1] = 0x012ea4b5ul;
+    sha->s[2] = 0x36e21c8ful;
+    sha->s[3] = 0xf7ec7b54ul;
+    sha->s[4] = 0x4dd4e2acul;
+    sha->s[5] = 0x9bcaa0a4ul;
+    sha->s[6] = 0xe244899bul;
+    sha->s[7] = 0xcd06903eul;
+
+    sha->bytes = 64;
+}
+
+/* Initializes SHA256 with fixed midstate. This midstate was computed by applying
+ * SHA256 to SHA256("BIP0352/SharedSecret")||SHA256("BIP0352/SharedSecret"). */
+static void rustsecp256k1_v0_11_silentpayments_sha256_tagged_shared_secret(rustsecp256k1_v0_11_sha256 *sha) {
+    rustsecp256k1_v0_11_sha256_initialize(sha);
+    sha->s[0] = 0x88831537ul;
+    sha->s[1] = 0x5127079bul;
+    sha->s[2] = 0x69c2137bul;
+    sha->s[3] = 0xab0303e6ul;
+    sha->s[4] = 0x98fa21faul;
+    sha->s[5] = 0x4a888523ul;
+    sha->s[6] = 0xbd99daabul;
+    sha->s[7] = 0xf25e5e0aul;
+
+    sha->bytes = 64;
+}
+
+/* Initializes SHA256 with fixed midstate. This midstate was computed by applying
+ * SHA256 to SHA256("BIP0352/Label")||SHA256("BIP0352/Label"). */
+static void rustsecp256k1_v0_11_silentpayments_sha256_tagged_label(rustsecp256k1_v0_11_sha256 *sha) {
+    rustsecp256k1_v0_11_sha256_initialize(sha);
+    sha->s[0] = 0x26b95d63ul;
+    sha->s[1] = 0x8bf1b740ul;
+    sha->s[2] = 0x10a5986ful;
+    sha->s[3] = 0x06a387a5ul;
+    sha->s[4] = 0x2d1c1c30ul;
+    sha->s[5] = 0xd035951aul;
+    sha->s[6] = 0x2d7f0f96ul;
+    sha->s[7] = 0x29e3e0dbul;
+
+    sha->bytes = 64;
+}
+
+/* Sum the input public keys into A. Returns 0 if a key fails to load or the sum is infinity. */
+static int rustsecp256k1_v0_11_silentpayments_sum_inputs(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_ge *a, const rustsecp256k1_v0_11_xonly_pubkey *xonly_inputs, size_t n_xonly_inputs, const rustsecp256k1_v0_11_pubkey *plain_inputs, size_t n_plain_inputs) {
+    rustsecp256k1_v0_11_gej aj;
+    rustsecp256k1_v0_11_ge pt;
+    size_t i;
+
+    rustsecp256k1_v0_11_gej_set_infinity(&aj);
+    for (i = 0; i < n_xonly_inputs; i++) {
+        if (!rustsecp256k1_v0_11_xonly_pubkey_load(ctx, &pt, &xonly_inputs[i])) {
+            return 0;
+        }
+        rustsecp256k1_v0_11_gej_add_ge_var(&aj, &aj, &pt, NULL);
+    }
+    for (i = 0; i < n_plain_inputs; i++) {
+        if (!rustsecp256k1_v0_11_pubkey_load(ctx, &pt, &plain_inputs[i])) {
+            return 0;
+        }
+        rustsecp256k1_v0_11_gej_add_ge_var(&aj, &aj, &pt, NULL);
+    }
+    if (rustsecp256k1_v0_11_gej_is_infinity(&aj)) {
+        return 0;
+    }
+    rustsecp256k1_v0_11_ge_set_gej_var(a, &aj);
+    return 1;
+}
+
+/* input_hash = hash_BIP0352/Inputs(outpoint_smallest36 || ser_P(A)). Returns 0 if it is not a valid scalar. */
+static int rustsecp256k1_v0_11_silentpayments_input_hash(rustsecp256k1_v0_11_scalar *input_hash, const unsigned char *outpoint_smallest36, rustsecp256k1_v0_11_ge *a) {
+    rustsecp256k1_v0_11_sha256 hash;
+    unsigned char ser[33];
+    unsigned char buf[32];
+    size_t len;
+    int overflow;
+
+    rustsecp256k1_v0_11_silentpayments_sha256_tagged_inputs(&hash);
+    rustsecp256k1_v0_11_sha256_write(&hash, outpoint_smallest36, 36);
+    rustsecp256k1_v0_11_eckey_pubkey_serialize(a, ser, &len, 1);
+    rustsecp256k1_v0_11_sha256_write(&hash, ser, sizeof(ser));
+    rustsecp256k1_v0_11_sha256_finalize(&hash, buf);
+    rustsecp256k1_v0_11_scalar_set_b32(input_hash, buf, &overflow);
+    return !overflow & !rustsecp256k1_v0_11_scalar_is_zero(input_hash);
+}
+
+/* Computes the constant-time shared secret s*P and initializes hash with
+ * hash_BIP0352/SharedSecret(ser_P(s*P) || ...), ready for ser_32(k). */
+static void rustsecp256k1_v0_11_silentpayments_shared_secret_hash(rustsecp256k1_v0_11_sha256 *hash, const rustsecp256k1_v0_11_ge *p, const rustsecp256k1_v0_11_scalar *s) {
+    rustsecp256k1_v0_11_gej rj;
+    rustsecp256k1_v0_11_ge r;
+    unsigned char ser[33];
+
+    rustsecp256k1_v0_11_ecmult_const(&rj, p, s);
+    rustsecp256k1_v0_11_ge_set_gej(&r, &rj);
+    rustsecp256k1_v0_11_fe_normalize(&r.x);
+    rustsecp256k1_v0_11_fe_normalize(&r.y);
+    ser[0] = 0x02 | rustsecp256k1_v0_11_fe_is_odd(&r.y);
+    rustsecp256k1_v0_11_fe_get_b32(&ser[1], &r.x);
+
+    rustsecp256k1_v0_11_silentpayments_sha256_tagged_shared_secret(hash);
+    rustsecp256k1_v0_11_sha256_write(hash, ser, sizeof(ser));
+
+    rustsecp256k1_v0_11_memclear(ser, sizeof(ser));
+    rustsecp256k1_v0_11_ge_clear(&r);
+    rustsecp256k1_v0_11_gej_clear(&rj);
+}
+
+/* t_k = hash_BIP0352/SharedSecret(ser_P(shared secret) || ser_32(k)). Returns 0 on overflow. */
+static int rustsecp256k1_v0_11_silentpayments_t_k(rustsecp256k1_v0_11_scalar *t_k, const rustsecp256k1_v0_11_sha256 *shared_secret_hash, uint32_t k) {
+    rustsecp256k1_v0_11_sha256 hash = *shared_secret_hash;
+    unsigned char k_ser[4];
+    unsigned char buf[32];
+    int overflow;
+
+    rustsecp256k1_v0_11_write_be32(k_ser, k);
+    rustsecp256k1_v0_11_sha256_write(&hash, k_ser, sizeof(k_ser));
+    rustsecp256k1_v0_11_sha256_finalize(&hash, buf);
+    rustsecp256k1_v0_11_scalar_set_b32(t_k, buf, &overflow);
+
+    rustsecp256k1_v0_11_memclear(buf, sizeof(buf));
+    rustsecp256k1_v0_11_sha256_clear(&hash);
+    return !overflow;
+}
+
+static void rustsecp256k1_v0_11_silentpayments_found_output_set(rustsecp256k1_v0_11_silentpayments_found_output *found, const rustsecp256k1_v0_11_xonly_pubkey *output, const rustsecp256k1_v0_11_scalar *tweak, rustsecp256k1_v0_11_ge *label) {
+    found->output = *output;
+    rustsecp256k1_v0_11_scalar_get_b32(found->tweak, tweak);
+    found->found_with_label = label != NULL;
+    if (label != NULL) {
+        rustsecp256k1_v0_11_pubkey_save(&found->label, label);
+    } else {
+        memset(&found->label, 0, sizeof(found->label));
+    }
+}
+
+int rustsecp256k1_v0_11_silentpayments_recipient_create_label(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_pubkey *label, unsigned char *label_tweak32, const unsigned char *scan_key32, uint32_t m) {
+    rustsecp256k1_v0_11_sha256 hash;
+    rustsecp256k1_v0_11_scalar t;
+    rustsecp256k1_v0_11_gej lj;
+    rustsecp256k1_v0_11_ge l;
+    unsigned char m_ser[4];
+    int overflow;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(rustsecp256k1_v0_11_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(label != NULL);
+    memset(label, 0, sizeof(*label));
+    ARG_CHECK(label_tweak32 != NULL);
+    ARG_CHECK(scan_key32 != NULL);
+
+    rustsecp256k1_v0_11_silentpayments_sha256_tagged_label(&hash);
+    rustsecp256k1_v0_11_sha256_write(&hash, scan_key32, 32);
+    rustsecp256k1_v0_11_write_be32(m_ser, m);
+    rustsecp256k1_v0_11_sha256_write(&hash, m_ser, sizeof(m_ser));
+    rustsecp256k1_v0_11_sha256_finalize(&hash, label_tweak32);
+    rustsecp256k1_v0_11_sha256_clear(&hash);
+
+    rustsecp256k1_v0_11_scalar_set_b32(&t, label_tweak32, &overflow);
+    if (overflow || rustsecp256k1_v0_11_scalar_is_zero(&t)) {
+        rustsecp256k1_v0_11_memclear(label_tweak32, 32);
+        return 0;
+    }
+    rustsecp256k1_v0_11_ecmult_gen(&ctx->ecmult_gen_ctx, &lj, &t);
+    rustsecp256k1_v0_11_ge_set_gej(&l, &lj);
+    rustsecp256k1_v0_11_pubkey_save(label, &l);
+
+    rustsecp256k1_v0_11_scalar_clear(&t);
+    rustsecp256k1_v0_11_gej_clear(&lj);
+    return 1;
+}
+
+int rustsecp256k1_v0_11_silentpayments_recipient_scan_outputs(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_silentpayments_found_output *found_outputs, size_t *n_found_outputs, const rustsecp256k1_v0_11_xonly_pubkey *tx_outputs, size_t n_tx_outputs, const unsigned char *scan_key32, const rustsecp256k1_v0_11_xonly_pubkey *xonly_inputs, size_t n_xonly_inputs, const rustsecp256k1_v0_11_pubkey *plain_inputs, size_t n_plain_inputs, const unsigned char *outpoint_smallest36, const rustsecp256k1_v0_11_pubkey *spend_pubkey, rustsecp256k1_v0_11_silentpayments_label_lookup label_lookup, const void *label_context) {
+    rustsecp256k1_v0_11_scalar s, t_k, tweak;
+    rustsecp256k1_v0_11_ge a, spend, p, neg_p, pt;
+    rustsecp256k1_v0_11_gej spendj, pj;
+    rustsecp256k1_v0_11_gej candj[2 * SILENTPAYMENTS_LABEL_CHUNK];
+    rustsecp256k1_v0_11_ge cand[2 * SILENTPAYMENTS_LABEL_CHUNK];
+    rustsecp256k1_v0_11_sha256 shared_secret_hash;
+    unsigned char ser[33];
+    size_t i, j, chunk, len;
+    uint32_t k;
+    int ret = 1;
+    int found;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(found_outputs != NULL);
+    ARG_CHECK(n_found_outputs != NULL);
+    *n_found_outputs = 0;
+    ARG_CHECK(tx_outputs != NULL || n_tx_outputs == 0);
+    ARG_CHECK(scan_key32 != NULL);
+    ARG_CHECK(xonly_inputs != NULL || n_xonly_inputs == 0);
+    ARG_CHECK(plain_inputs != NULL || n_plain_inputs == 0);
+    ARG_CHECK(n_xonly_inputs + n_plain_inputs > 0);
+    ARG_CHECK(outpoint_smallest36 != NULL);
+    ARG_CHECK(spend_pubkey != NULL);
+
+    for (i = 0; i < n_tx_outputs; i++) {
+        if (!rustsecp256k1_v0_11_xonly_pubkey_load(ctx, &pt, &tx_outputs[i])) {
+            return 0;
+        }
+    }
+    if (!rustsecp256k1_v0_11_pubkey_load(ctx, &spend, spend_pubkey)) {
+        return 0;
+    }
+    if (!rustsecp256k1_v0_11_silentpayments_sum_inputs(ctx, &a, xonly_inputs, n_xonly_inputs, plain_inputs, n_plain_inputs)) {
+        return 0;
+    }
+    if (!rustsecp256k1_v0_11_silentpayments_input_hash(&tweak, outpoint_smallest36, &a)) {
+        return 0;
+    }
+    if (!rustsecp256k1_v0_11_scalar_set_b32_seckey(&s, scan_key32)) {
+        rustsecp256k1_v0_11_scalar_clear(&s);
+        return 0;
+    }
+    /* input_hash * b_scan * A with one multiplication. */
+    rustsecp256k1_v0_11_scalar_mul(&s, &s, &tweak);
+    rustsecp256k1_v0_11_silentpayments_shared_secret_hash(&shared_secret_hash, &a, &s);
+    rustsecp256k1_v0_11_scalar_clear(&s);
+
+    rustsecp256k1_v0_11_gej_set_ge(&spendj, &spend);
+    for (k = 0; *n_found_outputs < n_tx_outputs; k++) {
+        if (!rustsecp256k1_v0_11_silentpayments_t_k(&t_k, &shared_secret_hash, k)) {
+            ret = 0;
+            break;
+        }
+        /* P_k = B_spend + t_k*G, as in ec_pubkey_tweak_add. */
+        rustsecp256k1_v0_11_ecmult(&pj, &spendj, &rustsecp256k1_v0_11_scalar_one, &t_k);
+        if (rustsecp256k1_v0_11_gej_is_infinity(&pj)) {
+            ret = 0;
+            break;
+        }
+        rustsecp256k1_v0_11_ge_set_gej_var(&p, &pj);
+        rustsecp256k1_v0_11_fe_normalize_var(&p.x);
+        rustsecp256k1_v0_11_fe_normalize_var(&p.y);
+
+        found = 0;
+        for (i = 0; i < n_tx_outputs; i++) {
+            rustsecp256k1_v0_11_xonly_pubkey_load(ctx, &pt, &tx_outputs[i]);
+            if (rustsecp256k1_v0_11_fe_equal(&pt.x, &p.x)) {
+                rustsecp256k1_v0_11_silentpayments_found_output_set(&found_outputs[*n_found_outputs], &tx_outputs[i], &t_k, NULL);
+                found = 1;
+                break;
+            }
+        }
+
+        if (!found && label_lookup != NULL) {
+            /* For every output, output - P_k and -output - P_k are candidate labels. They are
+             * computed in Jacobian coordinates and normalized in batches before the lookup. */
+            rustsecp256k1_v0_11_ge_neg(&neg_p, &p);
+            for (i = 0; i < n_tx_outputs && !found; i += chunk) {
+                chunk = n_tx_outputs - i < SILENTPAYMENTS_LABEL_CHUNK ? n_tx_outputs - i : SILENTPAYMENTS_LABEL_CHUNK;
+                for (j = 0; j < chunk; j++) {
+                    rustsecp256k1_v0_11_xonly_pubkey_load(ctx, &pt, &tx_outputs[i + j]);
+                    rustsecp256k1_v0_11_gej_set_ge(&candj[2 * j], &pt);
+                    rustsecp256k1_v0_11_gej_add_ge_var(&candj[2 * j], &candj[2 * j], &neg_p, NULL);
+                    rustsecp256k1_v0_11_gej_set_ge(&candj[2 * j + 1], &pt);
+                    rustsecp256k1_v0_11_gej_add_ge_var(&candj[2 * j + 1], &candj[2 * j + 1], &p, NULL);
+                    rustsecp256k1_v0_11_gej_neg(&candj[2 * j + 1], &candj[2 * j + 1]);
+                }
+                rustsecp256k1_v0_11_ge_set_all_gej_var(cand, candj, 2 * chunk);
+
+                for (j = 0; j < 2 * chunk; j++) {
+                    const unsigned char *label_tweak32;
+                    if (rustsecp256k1_v0_11_ge_is_infinity(&cand[j])) {
+                        continue;
+                    }
+                    rustsecp256k1_v0_11_eckey_pubkey_serialize(&cand[j], ser, &len, 1);
+                    label_tweak32 = label_lookup(ser, label_context);
+                    if (label_tweak32 != NULL) {
+                        rustsecp256k1_v0_11_scalar_set_b32(&tweak, label_tweak32, NULL);
+                        rustsecp256k1_v0_11_scalar_add(&tweak, &tweak, &t_k);
+                        rustsecp256k1_v0_11_silentpayments_found_output_set(&found_outputs[*n_found_outputs], &tx_outputs[i + j / 2], &tweak, &cand[j]);
+                        found = 1;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (!found) {
+            break;
+        }
+        (*n_found_outputs)++;
+    }
+
+    if (!ret) {
+        *n_found_outputs = 0;
+    }
+    rustsecp256k1_v0_11_sha256_clear(&shared_secret_hash);
+    rustsecp256k1_v0_11_scalar_clear(&t_k);
+    rustsecp256k1_v0_11_scalar_clear(&tweak);
+    return ret;
+}
+
+int rustsecp256k1_v0_11_silentpayments_sender_create_output(const rustsecp256k1_v0_11_context *ctx, rustsecp256k1_v0_11_xonly_pubkey *output, const unsigned char *input_seckeys32, size_t n_input_seckeys, const unsigned char *outpoint_smallest36, const rustsecp256k1_v0_11_pubkey *scan_pubkey, const rustsecp256k1_v0_11_pubkey *spend_pubkey, uint32_t k) {
+    rustsecp256k1_v0_11_scalar a_sum, a_i, input_hash, t_k;
+    rustsecp256k1_v0_11_gej aj, pj;
+    rustsecp256k1_v0_11_ge a, scan, spend, p;
+    rustsecp256k1_v0_11_sha256 shared_secret_hash;
+    size_t i;
+    int ret = 1;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(rustsecp256k1_v0_11_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(output != NULL);
+    memset(output, 0, sizeof(*output));
+    ARG_CHECK(input_seckeys32 != NULL);
+    ARG_CHECK(n_input_seckeys > 0);
+    ARG_CHECK(outpoint_smallest36 != NULL);
+    ARG_CHECK(scan_pubkey != NULL);
+    ARG_CHECK(spend_pubkey != NULL);
+
+    if (!rustsecp256k1_v0_11_pubkey_load(ctx, &scan, scan_pubkey) || !rustsecp256k1_v0_11_pubkey_load(ctx, &spend, spend_pubkey)) {
+        return 0;
+    }
+
+    rustsecp256k1_v0_11_scalar_set_int(&a_sum, 0);
+    for (i = 0; i < n_input_seckeys; i++) {
+        ret &= rustsecp256k1_v0_11_scalar_set_b32_seckey(&a_i, &input_seckeys32[32 * i]);
+        rustsecp256k1_v0_11_scalar_add(&a_sum, &a_sum, &a_i);
+    }
+    rustsecp256k1_v0_11_scalar_clear(&a_i);
+    ret &= !rustsecp256k1_v0_11_scalar_is_zero(&a_sum);
+    rustsecp256k1_v0_11_declassify(ctx, &ret, sizeof(ret));
+    if (!ret) {
+        rustsecp256k1_v0_11_scalar_clear(&a_sum);
+        return 0;
+    }
+
+    rustsecp256k1_v0_11_ecmult_gen(&ctx->ecmult_gen_ctx, &aj, &a_sum);
+    rustsecp256k1_v0_11_ge_set_gej(&a, &aj);
+    rustsecp256k1_v0_11_declassify(ctx, &a, sizeof(a));
+    if (!rustsecp256k1_v0_11_silentpayments_input_hash(&input_hash, outpoint_smallest36, &a)) {
+        rustsecp256k1_v0_11_scalar_clear(&a_sum);
+        return 0;
+    }
+    rustsecp256k1_v0_11_scalar_mul(&a_sum, &a_sum, &input_hash);
+    rustsecp256k1_v0_11_silentpayments_shared_secret_hash(&shared_secret_hash, &scan, &a_sum);
+    rustsecp256k1_v0_11_scalar_clear(&a_sum);
+
+    ret = rustsecp256k1_v0_11_silentpayments_t_k(&t_k, &shared_secret_hash, k);
+    rustsecp256k1_v0_11_sha256_clear(&shared_secret_hash);
+    if (ret) {
+        rustsecp256k1_v0_11_ecmult_gen(&ctx->ecmult_gen_ctx, &pj, &t_k);
+        rustsecp256k1_v0_11_gej_add_ge(&pj, &pj, &spend);
+        ret = !rustsecp256k1_v0_11_gej_is_infinity(&pj);
+    }
+    if (ret) {
+        rustsecp256k1_v0_11_ge_set_gej(&p, &pj);
+        rustsecp256k1_v0_11_fe_normalize_var(&p.y);
+        rustsecp256k1_v0_11_extrakeys_ge_even_y(&p);
+        rustsecp256k1_v0_11_xonly_pubkey_save(output, &p);
+    }
+
+    rustsecp256k1_v0_11_scalar_clear(&t_k);
+    rustsecp256k1_v0_11_gej_clear(&pj);
+    return ret;
+}
+
+#endif /* SECP256K1_MODULE_SILENTPAYMENTS_MAIN_H */
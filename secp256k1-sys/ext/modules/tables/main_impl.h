@@ -0,0 +1,34 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#ifndef SECP256K1_MODULE_TABLES_MAIN_H
+#define SECP256K1_MODULE_TABLES_MAIN_H
+
+#include "../../include/secp256k1_tables.h"
+
+size_t rustsecp256k1_v0_11_tables_size(void) {
+    return 2 * SECP256K1_TABLES_PRE_G_SIZE + SECP256K1_TABLES_GEN_SIZE;
+}
+
+int rustsecp256k1_v0_11_tables_copy(void *mem, size_t size) {
+    unsigned char *out = (unsigned char *)mem;
+
+    if (size < rustsecp256k1_v0_11_tables_size()) {
+        return 0;
+    }
+    memcpy(out, rustsecp256k1_v0_11_pre_g, SECP256K1_TABLES_PRE_G_SIZE);
+    memcpy(out + SECP256K1_TABLES_PRE_G_SIZE, rustsecp256k1_v0_11_pre_g_128, SECP256K1_TABLES_PRE_G_SIZE);
+    memcpy(out + 2 * SECP256K1_TABLES_PRE_G_SIZE, rustsecp256k1_v0_11_ecmult_gen_prec_table, SECP256K1_TABLES_GEN_SIZE);
+    return 1;
+}
+
+void rustsecp256k1_v0_11_tables_set_default(const void *tables) {
+    rustsecp256k1_v0_11_tables_default = (const unsigned char *)tables;
+}
+
+#ifdef ENABLE_THREAD_LOCAL_TABLES
+void rustsecp256k1_v0_11_tables_set_thread(const void *tables) {
+    rustsecp256k1_v0_11_tables_thread = (const unsigned char *)tables;
+}
+#endif
+
+#endif /* SECP256K1_MODULE_TABLES_MAIN_H */
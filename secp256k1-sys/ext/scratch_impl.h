@@ -0,0 +1,28 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+/* Scratch spaces for the extension modules. The library is built without
+ * malloc, so rustsecp256k1_v0_11_scratch_space_create is unavailable and the
+ * modules which run ecmult_multi put a scratch space over memory provided by
+ * the caller instead. Included after the library. */
+
+#ifndef SECP256K1_EXT_SCRATCH_IMPL_H
+#define SECP256K1_EXT_SCRATCH_IMPL_H
+
+/* Sets up scratch to hand out the size bytes at mem. */
+static void rustsecp256k1_v0_11_ext_scratch_init(rustsecp256k1_v0_11_scratch *scratch, void *mem, size_t size) {
+    memset(scratch, 0, sizeof(*scratch));
+    memcpy(scratch->magic, "scratch", 8);
+    scratch->data = mem;
+    scratch->max_size = size;
+}
+
+/* Returns the scratch memory with which rustsecp256k1_v0_11_ecmult_multi_var handles n points
+ * in a single batch with the algorithm it picks for n. */
+static size_t rustsecp256k1_v0_11_ext_ecmult_multi_scratch_size(size_t n) {
+    if (n < ECMULT_PIPPENGER_THRESHOLD) {
+        return rustsecp256k1_v0_11_strauss_scratch_size(n) + STRAUSS_SCRATCH_OBJECTS * ALIGNMENT;
+    }
+    return rustsecp256k1_v0_11_pippenger_scratch_size(n, rustsecp256k1_v0_11_pippenger_bucket_window(n)) + PIPPENGER_SCRATCH_OBJECTS * ALIGNMENT;
+}
+
+#endif /* SECP256K1_EXT_SCRATCH_IMPL_H */
@@ -0,0 +1,42 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+/* Rust-specific extensions to libsecp256k1.
+ *
+ * The vendored library in depend/secp256k1 is replaced wholesale every time
+ * vendor-libsecp.sh is run, so anything we add on top of it lives here instead.
+ * This file is compiled in place of depend/secp256k1/src/secp256k1.c: it
+ * includes that translation unit verbatim and then the extension modules,
+ * which gives the modules access to the library internals (field, group and
+ * scalar arithmetic, ecmult) exactly like upstream modules have. */
+
+/* These must come first so that the library does not define the hooks away. */
+#ifdef ENABLE_INSTRUMENTATION
+#include "instrumentation.h"
+#endif
+#include "tables.h"
+
+#include "../depend/secp256k1/src/secp256k1.c"
+#include "scratch_impl.h"
+#include "batch_impl.h"
+
+#include "modules/ecdh_batch/main_impl.h"
+#include "modules/silentpayments/main_impl.h"
+#include "modules/ellswift_batch/main_impl.h"
+#include "modules/hd_batch/main_impl.h"
+#ifdef ENABLE_MODULE_ECMULT_TUNE
+#include "modules/ecmult_tune/main_impl.h"
+#endif
+#include "modules/der_batch/main_impl.h"
+#include "modules/schnorrsig_batch/main_impl.h"
+#include "modules/extrakeys_batch/main_impl.h"
+#include "modules/pubkey_sort/main_impl.h"
+#include "modules/pubkey_batch/main_impl.h"
+#include "modules/ecdsa_presign/main_impl.h"
+#include "modules/schnorrsig_presign/main_impl.h"
+#include "modules/fixed_base/main_impl.h"
+#include "modules/scalar_arith/main_impl.h"
+#include "modules/tables/main_impl.h"
+
+#ifdef ENABLE_INSTRUMENTATION
+#include "modules/instrumentation/main_impl.h"
+#endif
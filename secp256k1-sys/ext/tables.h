@@ -0,0 +1,53 @@
+/* SPDX-License-Identifier: CC0-1.0 */
+
+/* Relocatable precomputed tables.
+ *
+ * ecmult reads the multiples of G from pre_g and pre_g_128, and ecmult_gen
+ * reads its comb table from ecmult_gen_prec_table. These are static arrays
+ * shared by every context in the process. The hooks defined here make both
+ * read from a copy in caller-supplied memory instead (for instance on huge
+ * pages, or on the local NUMA node) once one has been installed with
+ * rustsecp256k1_v0_11_tables_set_default or, per thread,
+ * rustsecp256k1_v0_11_tables_set_thread.
+ *
+ * A copy holds pre_g, pre_g_128 and ecmult_gen_prec_table, in this order and
+ * without padding (see modules/tables/main_impl.h). */
+
+#ifndef SECP256K1_EXT_TABLES_H
+#define SECP256K1_EXT_TABLES_H
+
+#include <stddef.h>
+
+#include "ext_util.h"
+
+static const unsigned char *rustsecp256k1_v0_11_tables_default = NULL;
+
+#ifdef ENABLE_THREAD_LOCAL_TABLES
+static SECP256K1_EXT_THREAD_LOCAL const unsigned char *rustsecp256k1_v0_11_tables_thread = NULL;
+#endif
+
+/* Returns the copy in use by the calling thread, or NULL for the static tables. */
+static const unsigned char *rustsecp256k1_v0_11_tables_active(void) {
+#ifdef ENABLE_THREAD_LOCAL_TABLES
+    if (rustsecp256k1_v0_11_tables_thread != NULL) {
+        return rustsecp256k1_v0_11_tables_thread;
+    }
+#endif
+    return rustsecp256k1_v0_11_tables_default;
+}
+
+/* These expand where the library types are known. */
+#define SECP256K1_TABLES_PRE_G_SIZE (ECMULT_TABLE_SIZE(WINDOW_G) * sizeof(rustsecp256k1_v0_11_ge_storage))
+#define SECP256K1_TABLES_GEN_SIZE (COMB_BLOCKS * COMB_POINTS * sizeof(rustsecp256k1_v0_11_ge_storage))
+#define SECP256K1_TABLES_GET(type, offset, fallback) \
+    (rustsecp256k1_v0_11_tables_active() == NULL ? (fallback) \
+        : (type)(const void *)(rustsecp256k1_v0_11_tables_active() + (offset)))
+
+#define SECP256K1_ECMULT_PRE_G \
+    SECP256K1_TABLES_GET(const rustsecp256k1_v0_11_ge_storage *, 0, rustsecp256k1_v0_11_pre_g)
+#define SECP256K1_ECMULT_PRE_G_128 \
+    SECP256K1_TABLES_GET(const rustsecp256k1_v0_11_ge_storage *, SECP256K1_TABLES_PRE_G_SIZE, rustsecp256k1_v0_11_pre_g_128)
+#define SECP256K1_ECMULT_GEN_PREC_TABLE \
+    SECP256K1_TABLES_GET(const rustsecp256k1_v0_11_ge_storage (*)[COMB_POINTS], 2 * SECP256K1_TABLES_PRE_G_SIZE, rustsecp256k1_v0_11_ecmult_gen_prec_table)
+
+#endif /* SECP256K1_EXT_TABLES_H */
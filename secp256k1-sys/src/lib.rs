@@ -96,6 +96,14 @@ pub type EllswiftEcdhHashFn = Option<unsafe extern "C" fn(
     data: *mut c_void,
 ) -> c_int>;
 
+/// A function used by `silentpayments_recipient_scan_outputs` to look up a
+/// candidate label. Returns a pointer to the 32-byte label tweak, or NULL if the
+/// label is unknown.
+pub type SilentpaymentsLabelLookupFn = Option<unsafe extern "C" fn(
+    label33: *const c_uchar,
+    label_context: *const c_void,
+) -> *const c_uchar>;
+
 /// Data structure that contains additional arguments for schnorrsig_sign_custom.
 #[repr(C)]
 pub struct SchnorrSigExtraParams {
@@ -557,6 +565,52 @@ impl ElligatorSwift {
 impl_array_newtype!(ElligatorSwift, u8, 64);
 impl_raw_debug!(ElligatorSwift);
 
+/// An output found by `silentpayments_recipient_scan_outputs`.
+#[repr(C)]
+#[derive(Copy, Clone, Debug)]
+pub struct SilentpaymentsFoundOutput {
+    /// The x-only output key found in the transaction.
+    pub output: XOnlyPublicKey,
+    /// The tweak to add to the spend secret key to spend the output.
+    pub tweak: [c_uchar; 32],
+    /// Whether the output was paid to a labeled spend key.
+    pub found_with_label: c_int,
+    /// The label point, if `found_with_label` is nonzero.
+    pub label: PublicKey,
+}
+
+impl SilentpaymentsFoundOutput {
+    /// Creates an "uninitialized" found output which is zeroed out.
+    ///
+    /// # Safety
+    ///
+    /// This may only be passed to the FFI as an out-pointer.
+    pub unsafe fn new() -> Self {
+        SilentpaymentsFoundOutput {
+            output: XOnlyPublicKey::new(),
+            tweak: [0; 32],
+            found_with_label: 0,
+            label: PublicKey::new(),
+        }
+    }
+}
+
+/// Library-internal representation of a scalar modulo the group order.
+///
+/// The layout depends on the platform, but it is always reduced, so two scalars are equal if and
+/// only if their bytes are.
+#[repr(C)]
+#[derive(Copy, Clone, PartialEq, Eq, Hash)]
+pub struct UnpackedScalar([c_uchar; 32]);
+
+impl UnpackedScalar {
+    /// The scalar zero, which is represented by zero bytes on every platform.
+    pub const ZERO: UnpackedScalar = UnpackedScalar([0; 32]);
+}
+
+impl_array_newtype!(UnpackedScalar, c_uchar, 32);
+impl_raw_debug!(UnpackedScalar);
+
 extern "C" {
     /// Default ECDH hash function
     #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_ecdh_hash_function_default")]
@@ -672,6 +726,362 @@ extern "C" {
                                   hashfp: EllswiftEcdhHashFn,
                                   data: *mut c_void)
                                   -> c_int;
+
+    // Batch ElligatorSwift (extension module, see `ext/`)
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_ellswift_decode_batch")]
+    pub fn secp256k1_ellswift_decode_batch(ctx: *const Context,
+                                           pubkeys: *mut PublicKey,
+                                           ell64s: *const c_uchar,
+                                           n: size_t)
+                                           -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_ellswift_create_batch")]
+    pub fn secp256k1_ellswift_create_batch(ctx: *const Context,
+                                           ell64s: *mut c_uchar,
+                                           seckeys32: *const c_uchar,
+                                           auxrnd32s: *const c_uchar,
+                                           n: size_t)
+                                           -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_ellswift_xdh_batch")]
+    pub fn secp256k1_ellswift_xdh_batch(ctx: *const Context,
+                                        output: *mut c_uchar,
+                                        ell_a64s: *const c_uchar,
+                                        ell_b64s: *const c_uchar,
+                                        seckeys32: *const c_uchar,
+                                        parties: *const c_int,
+                                        n: size_t,
+                                        hashfp: EllswiftEcdhHashFn,
+                                        data: *mut c_void)
+                                        -> c_int;
+
+    // Batch ECDH (extension module, see `ext/`)
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_ecdh_batch")]
+    pub fn secp256k1_ecdh_batch(cx: *const Context,
+                                output: *mut c_uchar,
+                                output_len: size_t,
+                                pubkeys: *const PublicKey,
+                                n_pubkeys: size_t,
+                                seckey: *const c_uchar,
+                                hashfp: EcdhHashFn,
+                                data: *mut c_void)
+                                -> c_int;
+
+    // Silent Payments (extension module, see `ext/`)
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_silentpayments_recipient_create_label")]
+    pub fn secp256k1_silentpayments_recipient_create_label(cx: *const Context,
+                                                          label: *mut PublicKey,
+                                                          label_tweak32: *mut c_uchar,
+                                                          scan_key32: *const c_uchar,
+                                                          m: u32)
+                                                          -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_silentpayments_recipient_scan_outputs")]
+    pub fn secp256k1_silentpayments_recipient_scan_outputs(cx: *const Context,
+                                                          found_outputs: *mut SilentpaymentsFoundOutput,
+                                                          n_found_outputs: *mut size_t,
+                                                          tx_outputs: *const XOnlyPublicKey,
+                                                          n_tx_outputs: size_t,
+                                                          scan_key32: *const c_uchar,
+                                                          xonly_inputs: *const XOnlyPublicKey,
+                                                          n_xonly_inputs: size_t,
+                                                          plain_inputs: *const PublicKey,
+                                                          n_plain_inputs: size_t,
+                                                          outpoint_smallest36: *const c_uchar,
+                                                          spend_pubkey: *const PublicKey,
+                                                          label_lookup: SilentpaymentsLabelLookupFn,
+                                                          label_context: *const c_void)
+                                                          -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_silentpayments_sender_create_output")]
+    pub fn secp256k1_silentpayments_sender_create_output(cx: *const Context,
+                                                        output: *mut XOnlyPublicKey,
+                                                        input_seckeys32: *const c_uchar,
+                                                        n_input_seckeys: size_t,
+                                                        outpoint_smallest36: *const c_uchar,
+                                                        scan_pubkey: *const PublicKey,
+                                                        spend_pubkey: *const PublicKey,
+                                                        k: u32)
+                                                        -> c_int;
+
+    // Batch HD derivation (extension module, see `ext/`)
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_ec_pubkey_derive_batch")]
+    pub fn secp256k1_ec_pubkey_derive_batch(cx: *const Context,
+                                            children: *mut PublicKey,
+                                            parent: *const PublicKey,
+                                            tweaks32: *const c_uchar,
+                                            n: size_t)
+                                            -> c_int;
+
+    // Table placement (extension module, see `ext/tables.h`)
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_tables_size")]
+    pub fn secp256k1_tables_size() -> size_t;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_tables_copy")]
+    pub fn secp256k1_tables_copy(mem: *mut c_void, size: size_t) -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_tables_set_default")]
+    pub fn secp256k1_tables_set_default(tables: *const c_void);
+
+    #[cfg(feature = "std")]
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_tables_set_thread")]
+    pub fn secp256k1_tables_set_thread(tables: *const c_void);
+
+    // Bulk DER (extension module, see `ext/`)
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_ecdsa_signature_parse_der_batch")]
+    pub fn secp256k1_ecdsa_signature_parse_der_batch(cx: *const Context,
+                                                     sigs: *mut Signature,
+                                                     valid: *mut c_uchar,
+                                                     input: *const c_uchar,
+                                                     offsets: *const size_t,
+                                                     lengths: *const size_t,
+                                                     n: size_t,
+                                                     lax: c_int)
+                                                     -> size_t;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_ecdsa_signature_serialize_der_batch")]
+    pub fn secp256k1_ecdsa_signature_serialize_der_batch(cx: *const Context,
+                                                         output: *mut c_uchar,
+                                                         out_len: *mut size_t,
+                                                         offsets: *mut size_t,
+                                                         sigs: *const Signature,
+                                                         n: size_t)
+                                                         -> c_int;
+
+    // Batch Schnorr verification (extension module, see `ext/`)
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_schnorrsig_verify_batch_scratch_size")]
+    pub fn secp256k1_schnorrsig_verify_batch_scratch_size(n: size_t) -> size_t;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_schnorrsig_verify_batch")]
+    pub fn secp256k1_schnorrsig_verify_batch(cx: *const Context,
+                                             scratch: *mut c_void,
+                                             scratch_size: size_t,
+                                             sig64s: *const c_uchar,
+                                             msgs: *const *const c_uchar,
+                                             msglens: *const size_t,
+                                             pubkeys: *const XOnlyPublicKey,
+                                             n: size_t)
+                                             -> c_int;
+
+    // Batch x-only tweaks (extension module, see `ext/`)
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_xonly_pubkey_tweak_add_check_batch_scratch_size")]
+    pub fn secp256k1_xonly_pubkey_tweak_add_check_batch_scratch_size(n: size_t) -> size_t;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_xonly_pubkey_tweak_add_check_batch")]
+    pub fn secp256k1_xonly_pubkey_tweak_add_check_batch(cx: *const Context,
+                                                        scratch: *mut c_void,
+                                                        scratch_size: size_t,
+                                                        tweaked_pubkey32s: *const c_uchar,
+                                                        tweaked_pk_parities: *const c_int,
+                                                        internal_pubkeys: *const XOnlyPublicKey,
+                                                        tweak32s: *const c_uchar,
+                                                        n: size_t)
+                                                        -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_xonly_pubkey_tweak_add_batch")]
+    pub fn secp256k1_xonly_pubkey_tweak_add_batch(cx: *const Context,
+                                                  output_pubkeys: *mut XOnlyPublicKey,
+                                                  pk_parities: *mut c_int,
+                                                  internal_pubkeys: *const XOnlyPublicKey,
+                                                  tweaks32: *const c_uchar,
+                                                  n: size_t)
+                                                  -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_xonly_pubkey_taptweak_add_batch")]
+    pub fn secp256k1_xonly_pubkey_taptweak_add_batch(cx: *const Context,
+                                                     output_pubkeys: *mut XOnlyPublicKey,
+                                                     pk_parities: *mut c_int,
+                                                     internal_pubkeys: *const XOnlyPublicKey,
+                                                     merkle_roots32: *const c_uchar,
+                                                     n: size_t)
+                                                     -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_keypair_import_check_batch_scratch_size")]
+    pub fn secp256k1_keypair_import_check_batch_scratch_size(n: size_t) -> size_t;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_keypair_import_check_batch")]
+    pub fn secp256k1_keypair_import_check_batch(cx: *const Context,
+                                                scratch: *mut c_void,
+                                                scratch_size: size_t,
+                                                seckeys32: *const c_uchar,
+                                                pubkeys: *const PublicKey,
+                                                n: size_t)
+                                                -> c_int;
+
+    // Public key sorting (extension module, see `ext/`)
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_ec_pubkey_sort_scratch_size")]
+    pub fn secp256k1_ec_pubkey_sort_scratch_size(n_pubkeys: size_t) -> size_t;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_ec_pubkey_sort_scratch")]
+    pub fn secp256k1_ec_pubkey_sort_scratch(cx: *const Context,
+                                            pubkeys: *mut *const PublicKey,
+                                            n_pubkeys: size_t,
+                                            scratch: *mut c_void,
+                                            scratch_size: size_t)
+                                            -> c_int;
+
+    // Batch public key decompression (extension module, see `ext/`)
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_ec_pubkey_decompress_batch")]
+    pub fn secp256k1_ec_pubkey_decompress_batch(cx: *const Context,
+                                                pubkeys: *mut PublicKey,
+                                                x32s: *const c_uchar,
+                                                odd_bitmap: *const c_uchar,
+                                                offset: size_t,
+                                                n: size_t)
+                                                -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_xonly_pubkey_parse_batch")]
+    pub fn secp256k1_xonly_pubkey_parse_batch(cx: *const Context,
+                                              pubkeys: *mut XOnlyPublicKey,
+                                              x32s: *const c_uchar,
+                                              n: size_t)
+                                              -> c_int;
+
+    // ECDSA and schnorr presignatures (extension modules, see `ext/`)
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_ecdsa_presignature_create")]
+    pub fn secp256k1_ecdsa_presignature_create(cx: *const Context,
+                                               presig64: *mut c_uchar,
+                                               nonce32: *const c_uchar)
+                                               -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_ecdsa_presignature_sign")]
+    pub fn secp256k1_ecdsa_presignature_sign(cx: *const Context,
+                                             sig: *mut Signature,
+                                             presig64: *mut c_uchar,
+                                             msghash32: *const c_uchar,
+                                             seckey: *const c_uchar)
+                                             -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_schnorrsig_presignature_create")]
+    pub fn secp256k1_schnorrsig_presignature_create(cx: *const Context,
+                                                    presig64: *mut c_uchar,
+                                                    nonce32: *const c_uchar)
+                                                    -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_schnorrsig_presignature_sign")]
+    pub fn secp256k1_schnorrsig_presignature_sign(cx: *const Context,
+                                                  sig64: *mut c_uchar,
+                                                  presig64: *mut c_uchar,
+                                                  msg: *const c_uchar,
+                                                  msg_len: size_t,
+                                                  keypair: *const Keypair)
+                                                  -> c_int;
+
+    // Fixed-base comb tables (extension module, see `ext/`)
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_fixed_base_table_size")]
+    pub fn secp256k1_fixed_base_table_size(teeth: c_uint, blocks: c_uint) -> size_t;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_fixed_base_table_build")]
+    pub fn secp256k1_fixed_base_table_build(cx: *const Context,
+                                            table: *mut c_void,
+                                            point: *const PublicKey,
+                                            teeth: c_uint,
+                                            blocks: c_uint)
+                                            -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_fixed_base_mul")]
+    pub fn secp256k1_fixed_base_mul(cx: *const Context,
+                                    result: *mut PublicKey,
+                                    table: *const c_void,
+                                    teeth: c_uint,
+                                    blocks: c_uint,
+                                    scalar32: *const c_uchar)
+                                    -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_fixed_base_mul_var")]
+    pub fn secp256k1_fixed_base_mul_var(cx: *const Context,
+                                        result: *mut PublicKey,
+                                        table: *const c_void,
+                                        teeth: c_uint,
+                                        blocks: c_uint,
+                                        scalar32: *const c_uchar)
+                                        -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_fixed_base_table_serialize")]
+    pub fn secp256k1_fixed_base_table_serialize(cx: *const Context,
+                                                output: *mut c_uchar,
+                                                table: *const c_void,
+                                                teeth: c_uint,
+                                                blocks: c_uint)
+                                                -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_fixed_base_table_parse")]
+    pub fn secp256k1_fixed_base_table_parse(cx: *const Context,
+                                            table: *mut c_void,
+                                            input: *const c_uchar,
+                                            point: *const PublicKey,
+                                            teeth: c_uint,
+                                            blocks: c_uint)
+                                            -> c_int;
+
+    // Scalar arithmetic (extension module, see `ext/`)
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_unpacked_scalar_parse")]
+    pub fn secp256k1_unpacked_scalar_parse(cx: *const Context,
+                                           scalar: *mut UnpackedScalar,
+                                           input32: *const c_uchar)
+                                           -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_unpacked_scalar_serialize")]
+    pub fn secp256k1_unpacked_scalar_serialize(cx: *const Context,
+                                               output32: *mut c_uchar,
+                                               scalar: *const UnpackedScalar);
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_unpacked_scalar_add")]
+    pub fn secp256k1_unpacked_scalar_add(cx: *const Context,
+                                         r: *mut UnpackedScalar,
+                                         a: *const UnpackedScalar,
+                                         b: *const UnpackedScalar);
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_unpacked_scalar_mul")]
+    pub fn secp256k1_unpacked_scalar_mul(cx: *const Context,
+                                         r: *mut UnpackedScalar,
+                                         a: *const UnpackedScalar,
+                                         b: *const UnpackedScalar);
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_unpacked_scalar_negate")]
+    pub fn secp256k1_unpacked_scalar_negate(cx: *const Context,
+                                            r: *mut UnpackedScalar,
+                                            a: *const UnpackedScalar);
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_unpacked_scalar_inverse")]
+    pub fn secp256k1_unpacked_scalar_inverse(cx: *const Context,
+                                             r: *mut UnpackedScalar,
+                                             a: *const UnpackedScalar)
+                                             -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_unpacked_scalar_inverse_var")]
+    pub fn secp256k1_unpacked_scalar_inverse_var(cx: *const Context,
+                                                 r: *mut UnpackedScalar,
+                                                 a: *const UnpackedScalar)
+                                                 -> c_int;
+}
+
+#[cfg(feature = "ecmult-tune")]
+extern "C" {
+    // Multi-scalar multiplication tuning (extension module, see `ext/`)
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_ecmult_multi_tune_scratch_size")]
+    pub fn secp256k1_ecmult_multi_tune_scratch_size(n: size_t, bucket_window: c_int) -> size_t;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_ecmult_multi_tune")]
+    pub fn secp256k1_ecmult_multi_tune(cx: *const Context,
+                                       result: *mut PublicKey,
+                                       scratch_mem: *mut c_void,
+                                       scratch_size: size_t,
+                                       bucket_window: c_int,
+                                       scalars32: *const c_uchar,
+                                       points: *const PublicKey,
+                                       n: size_t)
+                                       -> c_int;
+}
+
+#[cfg(feature = "instrumentation")]
+extern "C" {
+    // Operation counters (extension module, see `ext/instrumentation.h`)
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_stats_snapshot")]
+    pub fn secp256k1_stats_snapshot(counts: *mut u64, cycles: *mut u64, n: size_t) -> c_int;
+
+    #[cfg_attr(not(rust_secp_no_symbol_renaming), link_name = "rustsecp256k1_v0_11_stats_reset")]
+    pub fn secp256k1_stats_reset();
 }
 
 #[cfg(not(secp256k1_fuzz))]
@@ -100,6 +100,18 @@ patch "$DIR/src/scratch.h" "./scratch.h.patch"
 patch "$DIR/src/scratch_impl.h" "./scratch_impl.h.patch"
 patch "$DIR/src/util.h" "./util.h.patch"
 
+# Hooks for the operation counters of the `instrumentation` feature (see ext/instrumentation.h).
+# util.h.patch above defines them away by default. ecmult_impl.h.patch also lets the build
+# override the Strauss/Pippenger crossovers (see RUST_SECP_ECMULT_TUNING in build.rs), and both
+# ecmult patches read the precomputed tables through hooks that ext/tables.h can redirect.
+patch "$DIR/src/ecmult_impl.h" "./ecmult_impl.h.patch"
+patch "$DIR/src/ecmult_gen_impl.h" "./ecmult_gen_impl.h.patch"
+patch "$DIR/src/ecmult_const_impl.h" "./ecmult_const_impl.h.patch"
+patch "$DIR/src/field_impl.h" "./field_impl.h.patch"
+patch "$DIR/src/field_5x52_impl.h" "./field_5x52_impl.h.patch"
+patch "$DIR/src/field_10x26_impl.h" "./field_10x26_impl.h.patch"
+patch "$DIR/src/hash_impl.h" "./hash_impl.h.patch"
+
 # Fix a linking error while cross-compiling to windowns with mingw
 patch "$DIR/contrib/lax_der_parsing.c" "./lax_der_parsing.c.patch"
 
@@ -116,6 +128,10 @@ find "$DIR" \
     -print0 | xargs -0 sed -i "/^#include/! s/ecdsa_signature_parse_der_lax/rustsecp256k1_v${SECP_VENDOR_VERSION_CODE}_ecdsa_signature_parse_der_lax/g"
 
 cd "$SECP_SYS"
+# Update the symbol prefix used by our own extension modules.
+find "./ext/" \
+    -type f \
+    -print0 | xargs -0 sed -i -r "s/rustsecp256k1_v[0-9]+_[0-9]+_/rustsecp256k1_v${SECP_VENDOR_VERSION_CODE}_/g"
 # Update the `links = ` in the manifest file.
 sed -i -r "s/^links = \".*\"$/links = \"rustsecp256k1_v${SECP_VENDOR_VERSION_CODE}\"/" Cargo.toml
 # Update the extern references in the Rust FFI source files.
@@ -55,6 +55,53 @@ impl SharedSecret {
         SharedSecret(buf)
     }
 
+    /// Creates the shared secrets of `scalar` with each of `points`.
+    ///
+    /// The result is identical to calling [`SharedSecret::new`] once per point, but the secret
+    /// scalar is recoded only once and the resulting points are normalized together, which is
+    /// considerably faster when one secret key is combined with many public keys (e.g. when
+    /// scanning for silent payments). Like [`SharedSecret::new`] this is constant time in `scalar`.
+    ///
+    /// # Examples
+    ///
+    /// ```
+    /// # #[cfg(all(feature = "rand", feature = "std"))] {
+    /// # use secp256k1::{rand, Secp256k1};
+    /// # use secp256k1::ecdh::SharedSecret;
+    /// let s = Secp256k1::new();
+    /// let (sk, _) = s.generate_keypair(&mut rand::thread_rng());
+    /// let points = [
+    ///     s.generate_keypair(&mut rand::thread_rng()).1,
+    ///     s.generate_keypair(&mut rand::thread_rng()).1,
+    /// ];
+    /// let secrets = SharedSecret::new_batch(&points, &sk);
+    /// # #[cfg(not(secp256k1_fuzz))]
+    /// assert_eq!(secrets[1], SharedSecret::new(&points[1], &sk));
+    /// # }
+    /// ```
+    #[cfg(feature = "alloc")]
+    pub fn new_batch(points: &[PublicKey], scalar: &SecretKey) -> alloc::vec::Vec<SharedSecret> {
+        let mut buf = alloc::vec![0u8; points.len() * SHARED_SECRET_SIZE];
+        let res = unsafe {
+            ffi::secp256k1_ecdh_batch(
+                ffi::secp256k1_context_no_precomp,
+                buf.as_mut_c_ptr(),
+                SHARED_SECRET_SIZE,
+                points.as_c_ptr() as *const ffi::PublicKey,
+                points.len(),
+                scalar.as_c_ptr(),
+                ffi::secp256k1_ecdh_hash_function_default,
+                ptr::null_mut(),
+            )
+        };
+        // The scalar was verified to be valid via the type system and the default hash function
+        // always returns 1.
+        debug_assert_eq!(res, 1);
+        buf.chunks_exact(SHARED_SECRET_SIZE)
+            .map(|chunk| SharedSecret(chunk.try_into().expect("chunks have the right size")))
+            .collect()
+    }
+
     /// Returns the shared secret as a byte value.
     #[inline]
     pub fn secret_bytes(&self) -> [u8; SHARED_SECRET_SIZE] { self.0 }
@@ -207,6 +254,25 @@ mod tests {
         assert!(sec_odd != sec2);
     }
 
+    #[test]
+    #[cfg(all(feature = "rand", feature = "std", not(secp256k1_fuzz)))]
+    fn ecdh_batch() {
+        let s = Secp256k1::signing_only();
+        let (sk, _) = s.generate_keypair(&mut rand::thread_rng());
+        // Cover more than one internal chunk of points.
+        let points = (0..37)
+            .map(|_| s.generate_keypair(&mut rand::thread_rng()).1)
+            .collect::<Vec<_>>();
+
+        let batch = SharedSecret::new_batch(&points, &sk);
+        assert_eq!(batch.len(), points.len());
+        for (point, secret) in points.iter().zip(batch.iter()) {
+            assert_eq!(*secret, SharedSecret::new(point, &sk));
+        }
+
+        assert!(SharedSecret::new_batch(&[], &sk).is_empty());
+    }
+
     #[test]
     fn test_c_callback() {
         let x = [5u8; 32];
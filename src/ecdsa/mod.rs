@@ -3,12 +3,18 @@
 //! Structs and functionality related to the ECDSA signature algorithm.
 //!
 
+#[cfg(all(feature = "std", feature = "rand"))]
+mod presign;
 #[cfg(feature = "recovery")]
 mod recovery;
 pub mod serialized_signature;
 
+#[cfg(feature = "alloc")]
+use core::ops::Range;
 use core::{fmt, ptr, str};
 
+#[cfg(all(feature = "std", feature = "rand"))]
+pub use self::presign::PresignaturePool;
 #[cfg(feature = "recovery")]
 pub use self::recovery::{RecoverableSignature, RecoveryId};
 pub use self::serialized_signature::SerializedSignature;
@@ -16,11 +22,13 @@ use crate::ffi::CPtr;
 #[cfg(feature = "global-context")]
 use crate::SECP256K1;
 use crate::{
-    ffi, from_hex, Error, Message, PublicKey, Secp256k1, SecretKey, Signing, Verification,
+    ffi, from_hex, Error, Message, PublicKey, PublicKeyBytes, Secp256k1, SecretKey, Signing,
+    Verification,
 };
 
 /// An ECDSA signature
 #[derive(Copy, Clone, PartialOrd, Ord, PartialEq, Eq, Hash)]
+#[repr(transparent)]
 pub struct Signature(pub(crate) ffi::Signature);
 impl_fast_comparisons!(Signature);
 
@@ -116,6 +124,112 @@ impl Signature {
         }
     }
 
+    /// Parses many DER-encoded signatures stored in one buffer, such as a block.
+    ///
+    /// `ranges` holds the position of each signature in `buf`. The results are identical to
+    /// calling [`Signature::from_der`] on each range, but the whole batch is parsed in one call
+    /// into the C library, with a fast path for signatures in the canonical shape that every
+    /// DER encoder produces.
+    ///
+    /// # Panics
+    ///
+    /// If a range is out of the bounds of `buf`.
+    #[cfg(feature = "alloc")]
+    pub fn from_der_batch(
+        buf: &[u8],
+        ranges: &[Range<usize>],
+    ) -> alloc::vec::Vec<Result<Signature, Error>> {
+        Signature::parse_der_batch(buf, ranges, false)
+    }
+
+    /// Parses many "lax DER"-encoded signatures stored in one buffer, see
+    /// [`Signature::from_der_batch`] and [`Signature::from_der_lax`].
+    ///
+    /// # Panics
+    ///
+    /// If a range is out of the bounds of `buf`.
+    #[cfg(feature = "alloc")]
+    pub fn from_der_lax_batch(
+        buf: &[u8],
+        ranges: &[Range<usize>],
+    ) -> alloc::vec::Vec<Result<Signature, Error>> {
+        Signature::parse_der_batch(buf, ranges, true)
+    }
+
+    #[cfg(feature = "alloc")]
+    fn parse_der_batch(
+        buf: &[u8],
+        ranges: &[Range<usize>],
+        lax: bool,
+    ) -> alloc::vec::Vec<Result<Signature, Error>> {
+        use alloc::vec::Vec;
+
+        let mut offsets = Vec::with_capacity(ranges.len());
+        let mut lengths = Vec::with_capacity(ranges.len());
+        for range in ranges {
+            assert!(
+                range.start <= range.end && range.end <= buf.len(),
+                "signature range {:?} out of bounds of a buffer of length {}",
+                range,
+                buf.len()
+            );
+            offsets.push(range.start);
+            lengths.push(range.end - range.start);
+        }
+
+        let mut sigs = alloc::vec![unsafe { ffi::Signature::new() }; ranges.len()];
+        let mut valid = alloc::vec![0u8; ranges.len()];
+        unsafe {
+            ffi::secp256k1_ecdsa_signature_parse_der_batch(
+                ffi::secp256k1_context_no_precomp,
+                sigs.as_mut_c_ptr(),
+                valid.as_mut_c_ptr(),
+                // Not `as_c_ptr`, which is null for an empty buffer of empty signatures.
+                buf.as_ptr(),
+                offsets.as_c_ptr(),
+                lengths.as_c_ptr(),
+                ranges.len(),
+                lax.into(),
+            );
+        }
+        sigs.into_iter()
+            .zip(valid)
+            .map(|(sig, valid)| match valid {
+                1 => Ok(Signature(sig)),
+                _ => Err(Error::InvalidSignature),
+            })
+            .collect()
+    }
+
+    /// Serializes many signatures in DER format, appending them to `out` back to back, and
+    /// returns the range of each signature in `out`.
+    ///
+    /// Unlike [`SerializedSignature`], which always reserves 72 bytes, the encodings are packed.
+    #[cfg(feature = "alloc")]
+    pub fn serialize_der_batch(
+        sigs: &[Signature],
+        out: &mut alloc::vec::Vec<u8>,
+    ) -> alloc::vec::Vec<Range<usize>> {
+        let start = out.len();
+        let mut len = sigs.len() * serialized_signature::MAX_LEN;
+        let mut offsets = alloc::vec![0usize; sigs.len() + 1];
+        out.resize(start + len, 0);
+        unsafe {
+            let ret = ffi::secp256k1_ecdsa_signature_serialize_der_batch(
+                ffi::secp256k1_context_no_precomp,
+                out[start..].as_mut_c_ptr(),
+                &mut len,
+                offsets.as_mut_c_ptr(),
+                sigs.as_c_ptr() as *const ffi::Signature,
+                sigs.len(),
+            );
+            // The output has room for the longest possible encodings.
+            debug_assert_eq!(ret, 1);
+        }
+        out.truncate(start + len);
+        offsets.windows(2).map(|w| start + w[0]..start + w[1]).collect()
+    }
+
     /// Normalizes a signature to a "low S" form. In ECDSA, signatures are
     /// of the form (r, s) where r and s are numbers lying in some finite
     /// field. The verification equation will pass for (r, s) iff it passes
@@ -240,6 +354,55 @@ impl<'de> serde::Deserialize<'de> for Signature {
     }
 }
 
+/// A DER-encoded ECDSA signature borrowed from a larger buffer, such as a transaction input.
+///
+/// The encoding is not checked until the signature is used, for instance by
+/// [`Secp256k1::verify_ecdsa_ref`], so signatures which are only inspected or copied elsewhere
+/// are never parsed.
+#[derive(Copy, Clone, PartialEq, Eq, Hash)]
+pub struct SignatureRef<'a> {
+    der: &'a [u8],
+    lax: bool,
+}
+
+impl<'a> SignatureRef<'a> {
+    /// Borrows a signature which is parsed as strict DER, see [`Signature::from_der`].
+    #[inline]
+    pub fn from_der(der: &'a [u8]) -> SignatureRef<'a> { SignatureRef { der, lax: false } }
+
+    /// Borrows a signature which is parsed as "lax DER", see [`Signature::from_der_lax`].
+    #[inline]
+    pub fn from_der_lax(der: &'a [u8]) -> SignatureRef<'a> { SignatureRef { der, lax: true } }
+
+    /// Returns the borrowed bytes.
+    #[inline]
+    pub fn as_bytes(&self) -> &'a [u8] { self.der }
+
+    /// Parses the signature.
+    ///
+    /// # Errors
+    ///
+    /// Returns [`Error::InvalidSignature`] if the bytes are not a valid encoding.
+    #[inline]
+    pub fn to_signature(&self) -> Result<Signature, Error> {
+        if self.lax {
+            Signature::from_der_lax(self.der)
+        } else {
+            Signature::from_der(self.der)
+        }
+    }
+}
+
+impl fmt::Debug for SignatureRef<'_> {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        f.write_str(if self.lax { "SignatureRef(lax " } else { "SignatureRef(" })?;
+        for byte in self.der {
+            write!(f, "{:02x}", byte)?;
+        }
+        f.write_str(")")
+    }
+}
+
 impl<C: Signing> Secp256k1<C> {
     fn sign_ecdsa_with_noncedata_pointer(
         &self,
@@ -403,6 +566,29 @@ impl<C: Verification> Secp256k1<C> {
             }
         }
     }
+
+    /// Checks an ECDSA signature given as borrowed bytes, for instance straight from a
+    /// transaction, see [`Secp256k1::verify_ecdsa`].
+    ///
+    /// Signatures parsed as "lax DER" often have a high S value, which this function rejects
+    /// like [`Secp256k1::verify_ecdsa`] does; use [`SignatureRef::to_signature`] and
+    /// [`Signature::normalize_s`] to accept them.
+    ///
+    /// # Errors
+    ///
+    /// Returns [`Error::InvalidSignature`] or [`Error::InvalidPublicKey`] if `sig` or `pk` cannot
+    /// be parsed and [`Error::IncorrectSignature`] if the signature does not verify.
+    #[inline]
+    pub fn verify_ecdsa_ref(
+        &self,
+        msg: impl Into<Message>,
+        sig: SignatureRef,
+        pk: PublicKeyBytes,
+    ) -> Result<(), Error> {
+        let sig = sig.to_signature()?;
+        let pk = pk.to_public_key()?;
+        self.verify_ecdsa(msg, &sig, &pk)
+    }
 }
 
 pub(crate) fn compact_sig_has_zero_first_bit(sig: &ffi::Signature) -> bool {
@@ -486,4 +672,106 @@ mod tests {
 
         assert!(Signature::from_compact(&bytes).is_err())
     }
+
+    #[test]
+    #[cfg(all(feature = "alloc", not(secp256k1_fuzz)))]
+    fn verify_ref() {
+        use crate::ecdsa::SignatureRef;
+        use crate::{Error, Message, PublicKeyBytes, Secp256k1, SecretKey};
+
+        let secp = Secp256k1::new();
+        let sk = SecretKey::from_slice(&[0x17; 32]).unwrap();
+        let msg = Message::from_digest([0x2b; 32]);
+        let sig = secp.sign_ecdsa(msg, &sk);
+
+        // A scriptSig-like buffer: the signature followed by the key.
+        let der = sig.serialize_der();
+        let mut buf = der.to_vec();
+        buf.extend_from_slice(&sk.public_key(&secp).serialize_uncompressed());
+        let (sig_bytes, pk_bytes) = buf.split_at(der.len());
+
+        let pk = PublicKeyBytes::from_slice(pk_bytes).unwrap();
+        assert!(secp.verify_ecdsa_ref(msg, SignatureRef::from_der(sig_bytes), pk).is_ok());
+        assert!(secp.verify_ecdsa_ref(msg, SignatureRef::from_der_lax(sig_bytes), pk).is_ok());
+        assert_eq!(SignatureRef::from_der(sig_bytes).to_signature(), Ok(sig));
+        assert_eq!(
+            secp.verify_ecdsa_ref(Message::from_digest([0; 32]), SignatureRef::from_der(sig_bytes), pk),
+            Err(Error::IncorrectSignature)
+        );
+        // Structure is only checked on use.
+        let truncated = SignatureRef::from_der(&sig_bytes[1..]);
+        assert_eq!(secp.verify_ecdsa_ref(msg, truncated, pk), Err(Error::InvalidSignature));
+        let x_only = PublicKeyBytes::from_slice(&pk_bytes[1..33]).unwrap();
+        assert_eq!(
+            secp.verify_ecdsa_ref(msg, SignatureRef::from_der(sig_bytes), x_only),
+            Err(Error::InvalidPublicKey)
+        );
+        assert_eq!(PublicKeyBytes::from_slice(&pk_bytes[..33]), Err(Error::InvalidPublicKey));
+    }
+
+    #[test]
+    #[cfg(feature = "alloc")]
+    fn der_batch() {
+        use crate::{Error, Message, Secp256k1, SecretKey};
+
+        let secp = Secp256k1::new();
+        let mut sigs = vec![];
+        for i in 1..=40u8 {
+            let sk = SecretKey::from_slice(&[i; 32]).unwrap();
+            sigs.push(secp.sign_ecdsa(Message::from_digest([i; 32]), &sk));
+        }
+        // Short integers and integers with a leading zero.
+        let mut compact = [0u8; 64];
+        compact[31] = 1;
+        compact[32] = 0x80;
+        compact[63] = 0x7f;
+        sigs.push(Signature::from_compact(&compact).unwrap());
+
+        let mut buf = vec![0xaa];
+        let ranges = Signature::serialize_der_batch(&sigs, &mut buf);
+        assert_eq!(buf[0], 0xaa);
+        for (sig, range) in sigs.iter().zip(&ranges) {
+            assert_eq!(sig.serialize_der(), buf[range.clone()]);
+        }
+        assert_eq!(ranges.last().unwrap().end, buf.len());
+        let parsed = Signature::from_der_batch(&buf, &ranges);
+        assert_eq!(parsed, sigs.iter().copied().map(Ok).collect::<Vec<_>>());
+
+        // Encodings off the fast path: a negative and an out of range integer (which parse to
+        // the zero signature), padding, long-form lengths and garbage.
+        let mut cases: Vec<Vec<u8>> = vec![
+            vec![0x30, 0x06, 0x02, 0x01, 0x81, 0x02, 0x01, 0x01],
+            [&[0x30, 0x26, 0x02, 0x21, 0x01][..], &[0xff; 32], &[0x02, 0x01, 0x01]].concat(),
+            vec![0x30, 0x07, 0x02, 0x02, 0x00, 0x01, 0x02, 0x01, 0x01],
+            vec![0x30, 0x81, 0x06, 0x02, 0x01, 0x01, 0x02, 0x01, 0x01],
+            vec![0x30, 0x06, 0x02, 0x01, 0x01, 0x02, 0x01, 0x01, 0x00],
+            vec![0x30, 0x06, 0x02, 0x00, 0x02, 0x02, 0x01, 0x01],
+            vec![0x30],
+            vec![],
+        ];
+        cases.extend(sigs.iter().take(5).map(|sig| {
+            let mut der = sig.serialize_der().to_vec();
+            der[0] = 0x31;
+            der
+        }));
+        let mut buf = vec![];
+        let mut ranges = vec![];
+        for case in &cases {
+            ranges.push(buf.len()..buf.len() + case.len());
+            buf.extend_from_slice(case);
+        }
+        let strict = Signature::from_der_batch(&buf, &ranges);
+        let lax = Signature::from_der_lax_batch(&buf, &ranges);
+        for (i, case) in cases.iter().enumerate() {
+            assert_eq!(strict[i], Signature::from_der(case), "case {}", i);
+            assert_eq!(lax[i], Signature::from_der_lax(case), "case {}", i);
+        }
+        assert!(strict[0].is_ok() && strict[1].is_ok() && strict[4].is_err());
+        assert!(lax[2].is_ok() && lax[3].is_ok());
+        assert_eq!(strict[6], Err(Error::InvalidSignature));
+
+        let empty = Signature::from_der_batch(&[], &[0..0, 0..0]);
+        assert_eq!(empty, vec![Err(Error::InvalidSignature); 2]);
+        assert!(Signature::from_der_lax_batch(&[], &[]).is_empty());
+    }
 }
@@ -0,0 +1,212 @@
+// SPDX-License-Identifier: CC0-1.0
+
+//! ECDSA signing with precomputed nonces.
+
+use rand::{CryptoRng, Rng};
+
+use super::Signature;
+use crate::ffi::CPtr;
+use crate::presign::{Pool, Presign};
+use crate::{ffi, Message, Secp256k1, SecretKey, Signing};
+
+/// A precomputed nonce: `r` followed by the inverse of the nonce.
+struct Presignature([u8; 64]);
+
+impl Presign for Presignature {
+    fn create<C: Signing, R: Rng + CryptoRng + ?Sized>(
+        secp: &Secp256k1<C>,
+        rng: &mut R,
+    ) -> Presignature {
+        let mut presig = Presignature([0; 64]);
+        loop {
+            let mut nonce = crate::random_32_bytes(rng);
+            let ret = unsafe {
+                ffi::secp256k1_ecdsa_presignature_create(
+                    secp.ctx.as_ptr(),
+                    presig.0.as_mut_c_ptr(),
+                    nonce.as_c_ptr(),
+                )
+            };
+            ffi::non_secure_erase_impl(&mut nonce, [0; 32]);
+            // Fails only for nonces which are not valid scalars.
+            if ret == 1 {
+                return presig;
+            }
+        }
+    }
+
+    fn zeroed() -> Presignature { Presignature([0; 64]) }
+}
+
+impl Drop for Presignature {
+    fn drop(&mut self) { ffi::non_secure_erase_impl(&mut self.0, [0; 64]); }
+}
+
+/// A pool of single-use ECDSA presignatures.
+///
+/// Most of the time of [`Secp256k1::sign_ecdsa`] goes into the multiplication of the nonce with
+/// the generator and the inversion of the nonce, neither of which depends on the message or the
+/// key. A [`PresignaturePool`] does this work ahead of time, for random nonces, so that signing
+/// only takes a few scalar operations.
+///
+/// Every presignature is used for exactly one signature: two signatures made with the same
+/// presignature reveal the secret key. The pool hands each one out once, erases it when it is
+/// used or dropped, and never exposes it, so it cannot be copied, serialized or restored.
+/// Processes which fork must not use the same pool in both the parent and the child.
+///
+/// ```
+/// use secp256k1::ecdsa::PresignaturePool;
+/// use secp256k1::{Message, Secp256k1, SecretKey};
+///
+/// let secp = Secp256k1::new();
+/// let sk = SecretKey::from_slice(&[7; 32]).unwrap();
+/// let msg = Message::from_digest([1; 32]);
+///
+/// let pool = PresignaturePool::new(16);
+/// pool.fill(&secp, &mut secp256k1::rand::thread_rng());
+///
+/// let sig = pool.sign_ecdsa(msg, &sk).expect("the pool is not empty");
+/// # #[cfg(not(secp256k1_fuzz))]
+/// assert!(secp.verify_ecdsa(msg, &sig, &sk.public_key(&secp)).is_ok());
+/// assert_eq!(pool.len(), 15);
+/// ```
+pub struct PresignaturePool(Pool<Presignature>);
+
+impl PresignaturePool {
+    /// Creates an empty pool holding up to `capacity` presignatures, to be filled with
+    /// [`PresignaturePool::fill`].
+    pub fn new(capacity: usize) -> PresignaturePool { PresignaturePool(Pool::new(capacity)) }
+
+    /// Creates a pool holding up to `capacity` presignatures which a background thread fills up
+    /// whenever fewer than `low_water` are left, with nonces from [`rand::thread_rng`].
+    ///
+    /// Dropping the pool stops the thread.
+    ///
+    /// # Panics
+    ///
+    /// If `low_water` is greater than `capacity` or the thread cannot be spawned.
+    pub fn with_refill(capacity: usize, low_water: usize) -> PresignaturePool {
+        PresignaturePool(Pool::with_refill(capacity, low_water))
+    }
+
+    /// Returns the number of presignatures left.
+    pub fn len(&self) -> usize { self.0.len() }
+
+    /// Returns whether no presignatures are left.
+    pub fn is_empty(&self) -> bool { self.len() == 0 }
+
+    /// Fills the pool up to its capacity, with nonces drawn from `rng`.
+    ///
+    /// The presignatures are computed without holding the lock of the pool, so signing is not
+    /// held up.
+    pub fn fill<C: Signing, R: Rng + CryptoRng + ?Sized>(
+        &self,
+        secp: &Secp256k1<C>,
+        rng: &mut R,
+    ) {
+        self.0.fill(secp, rng)
+    }
+
+    /// Signs `msg` with `sk`, using up one presignature.
+    ///
+    /// The result is a valid low-S signature like that of [`Secp256k1::sign_ecdsa`], but with a
+    /// random nonce. Returns `None` if the pool is empty; callers can then fall back to
+    /// [`Secp256k1::sign_ecdsa`].
+    pub fn sign_ecdsa(&self, msg: impl Into<Message>, sk: &SecretKey) -> Option<Signature> {
+        let mut presig = self.0.take()?;
+        let msg = msg.into();
+        unsafe {
+            let mut sig = ffi::Signature::new();
+            let ret = ffi::secp256k1_ecdsa_presignature_sign(
+                ffi::secp256k1_context_no_precomp,
+                &mut sig,
+                presig.0.as_mut_c_ptr(),
+                msg.as_c_ptr(),
+                sk.as_c_ptr(),
+            );
+            // Presignatures in the pool and secret keys are valid.
+            assert_eq!(ret, 1);
+            Some(Signature::from(sig))
+        }
+    }
+}
+
+impl core::fmt::Debug for PresignaturePool {
+    fn fmt(&self, f: &mut core::fmt::Formatter) -> core::fmt::Result {
+        f.debug_struct("PresignaturePool").field("len", &self.len()).finish()
+    }
+}
+
+#[cfg(all(test, not(secp256k1_fuzz)))]
+mod tests {
+    use std::thread;
+    use std::vec::Vec;
+
+    use super::*;
+
+    #[test]
+    fn presignatures() {
+        let secp = Secp256k1::new();
+        let sk = SecretKey::from_slice(&[3; 32]).unwrap();
+        let pk = sk.public_key(&secp);
+
+        let pool = PresignaturePool::new(8);
+        assert!(pool.sign_ecdsa(Message::from_digest([1; 32]), &sk).is_none());
+        pool.fill(&secp, &mut rand::thread_rng());
+        assert_eq!(pool.len(), 8);
+        let mut sigs = Vec::new();
+        for i in 0..8u8 {
+            let msg = Message::from_digest([i; 32]);
+            let sig = pool.sign_ecdsa(msg, &sk).unwrap();
+            assert!(secp.verify_ecdsa(msg, &sig, &pk).is_ok());
+            let mut normalized = sig;
+            normalized.normalize_s();
+            assert_eq!(normalized, sig);
+            sigs.push(sig);
+        }
+        assert!(pool.is_empty());
+        assert!(pool.sign_ecdsa(Message::from_digest([1; 32]), &sk).is_none());
+        // Every signature has its own nonce.
+        let mut rs: Vec<_> = sigs.iter().map(|sig| sig.serialize_compact()[..32].to_vec()).collect();
+        rs.sort();
+        rs.dedup();
+        assert_eq!(rs.len(), 8);
+
+        // The presignature is used up even if signing fails.
+        let mut presig = Presignature::create(&secp, &mut rand::thread_rng());
+        let mut sig = unsafe { ffi::Signature::new() };
+        let msg = [1; 32];
+        unsafe {
+            let zero = [0u8; 32];
+            let ret = ffi::secp256k1_ecdsa_presignature_sign(
+                ffi::secp256k1_context_no_precomp,
+                &mut sig,
+                presig.0.as_mut_c_ptr(),
+                msg.as_c_ptr(),
+                zero.as_c_ptr(),
+            );
+            assert_eq!(ret, 0);
+            assert_eq!(presig.0, [0; 64]);
+            let ret = ffi::secp256k1_ecdsa_presignature_sign(
+                ffi::secp256k1_context_no_precomp,
+                &mut sig,
+                presig.0.as_mut_c_ptr(),
+                msg.as_c_ptr(),
+                sk.as_c_ptr(),
+            );
+            assert_eq!(ret, 0);
+        }
+
+        let pool = PresignaturePool::with_refill(32, 16);
+        for i in 0..100u8 {
+            let msg = Message::from_digest([i; 32]);
+            let sig = loop {
+                match pool.sign_ecdsa(msg, &sk) {
+                    Some(sig) => break sig,
+                    None => thread::yield_now(),
+                }
+            };
+            assert!(secp.verify_ecdsa(msg, &sig, &pk).is_ok());
+        }
+    }
+}
@@ -42,6 +42,8 @@ use core::str::FromStr;
 use ffi::CPtr;
 use secp256k1_sys::types::{c_int, c_uchar, c_void};
 
+#[cfg(feature = "alloc")]
+use crate::Signing;
 use crate::{constants, ffi, from_hex, Error, PublicKey, Secp256k1, SecretKey, Verification};
 
 unsafe extern "C" fn hash_callback<F>(
@@ -77,6 +79,7 @@ where
 /// This object holds two field elements u and t, which are the inputs to
 /// the `ElligatorSwift` encoding function.
 #[derive(Copy, Clone, Debug, PartialEq, Eq, PartialOrd, Ord, Hash)]
+#[repr(transparent)]
 pub struct ElligatorSwift(ffi::ElligatorSwift);
 
 impl ElligatorSwift {
@@ -232,6 +235,93 @@ impl ElligatorSwift {
         ElligatorSwiftSharedSecret(shared_secret)
     }
 
+    /// Creates the Elligator Swift encodings of many secret keys at once.
+    ///
+    /// Equivalent to calling [`ElligatorSwift::from_seckey`] for each key (using the `i`-th
+    /// element of `aux_rand` for the `i`-th key, if given), but the public keys are computed
+    /// together, sharing one field inversion between up to 16 keys.
+    ///
+    /// # Panics
+    ///
+    /// If `aux_rand` is given and its length differs from the length of `sks`.
+    #[cfg(feature = "alloc")]
+    pub fn from_seckeys<C: Signing>(
+        secp: &Secp256k1<C>,
+        sks: &[SecretKey],
+        aux_rand: Option<&[[u8; 32]]>,
+    ) -> alloc::vec::Vec<ElligatorSwift> {
+        if let Some(aux_rand) = aux_rand {
+            assert_eq!(aux_rand.len(), sks.len(), "need one aux_rand per secret key");
+        }
+        let mut ells = alloc::vec![ElligatorSwift::from_array([0; 64]); sks.len()];
+        unsafe {
+            let ret = ffi::secp256k1_ellswift_create_batch(
+                secp.ctx().as_ptr(),
+                ells.as_mut_c_ptr() as *mut c_uchar,
+                sks.as_c_ptr() as *const c_uchar,
+                aux_rand.map_or(ptr::null(), |a| a.as_c_ptr() as *const c_uchar),
+                sks.len(),
+            );
+            debug_assert_eq!(ret, 1);
+        }
+        ells
+    }
+
+    /// Decodes many `ElligatorSwift` encodings into [`PublicKey`]s at once.
+    ///
+    /// Equivalent to calling [`PublicKey::from_ellswift`] for each encoding, but the field
+    /// inversions of up to 16 encodings are shared.
+    #[cfg(feature = "alloc")]
+    pub fn decode_batch(ells: &[ElligatorSwift]) -> alloc::vec::Vec<PublicKey> {
+        let mut pks = alloc::vec![unsafe { ffi::PublicKey::new() }; ells.len()];
+        unsafe {
+            let ret = ffi::secp256k1_ellswift_decode_batch(
+                ffi::secp256k1_context_no_precomp,
+                pks.as_mut_c_ptr(),
+                ells.as_c_ptr() as *const c_uchar,
+                ells.len(),
+            );
+            debug_assert_eq!(ret, 1);
+        }
+        pks.into_iter().map(PublicKey::from).collect()
+    }
+
+    /// Computes many BIP324 shared secrets at once.
+    ///
+    /// Each element of `exchanges` holds the arguments of one [`ElligatorSwift::shared_secret`]
+    /// call: the encodings of the initiator and the responder, our secret key and our role.
+    /// The results are identical, but the final inversions of up to 16 exchanges are shared,
+    /// which helps nodes that accept many connections at once.
+    #[cfg(feature = "alloc")]
+    pub fn shared_secret_batch(
+        exchanges: &[(ElligatorSwift, ElligatorSwift, SecretKey, Party)],
+        data: Option<&[u8]>,
+    ) -> alloc::vec::Vec<ElligatorSwiftSharedSecret> {
+        use alloc::vec::Vec;
+
+        let ell_a: Vec<ElligatorSwift> = exchanges.iter().map(|e| e.0).collect();
+        let ell_b: Vec<ElligatorSwift> = exchanges.iter().map(|e| e.1).collect();
+        let mut sks: Vec<SecretKey> = exchanges.iter().map(|e| e.2).collect();
+        let parties: Vec<c_int> = exchanges.iter().map(|e| e.3.to_ffi_int()).collect();
+        let mut out = alloc::vec![ElligatorSwiftSharedSecret([0; 32]); exchanges.len()];
+        unsafe {
+            let ret = ffi::secp256k1_ellswift_xdh_batch(
+                ffi::secp256k1_context_no_precomp,
+                out.as_mut_c_ptr() as *mut c_uchar,
+                ell_a.as_c_ptr() as *const c_uchar,
+                ell_b.as_c_ptr() as *const c_uchar,
+                sks.as_c_ptr() as *const c_uchar,
+                parties.as_c_ptr(),
+                exchanges.len(),
+                ffi::secp256k1_ellswift_xdh_hash_function_bip324,
+                data.as_c_ptr() as *mut c_void,
+            );
+            debug_assert_eq!(ret, 1);
+        }
+        sks.iter_mut().for_each(SecretKey::non_secure_erase);
+        out
+    }
+
     /// Encodes a public key into an `ElligatorSwift` encoding
     fn encode(pk: PublicKey) -> ElligatorSwift {
         let mut ell_out = [0u8; constants::ELLSWIFT_ENCODING_SIZE];
@@ -267,6 +357,7 @@ impl ElligatorSwift {
 /// computed from the x-only ECDH using both parties' public keys (`ElligatorSwift` encoded) and our own
 /// private key.
 #[derive(Copy, Clone, Debug, PartialEq, Eq, PartialOrd, Ord, Hash)]
+#[repr(transparent)]
 pub struct ElligatorSwiftSharedSecret([u8; 32]);
 
 impl ElligatorSwiftSharedSecret {
@@ -361,6 +452,246 @@ impl ffi::CPtr for ElligatorSwift {
     fn as_c_ptr(&self) -> *const Self::Target { self.0.as_c_ptr() }
 }
 
+/// Number of keys generated per call into the batch encoder when refilling a pool.
+#[cfg(all(feature = "std", feature = "rand"))]
+const POOL_REFILL_CHUNK: usize = 16;
+
+/// A pool of precomputed ephemeral ElligatorSwift keys.
+///
+/// Creating an `ElligatorSwift` encoding from a secret key requires a full generator
+/// multiplication followed by a rejection-sampling loop, which is too slow for the critical
+/// path of a BIP324 handshake under load. The pool generates `(SecretKey, ElligatorSwift)` pairs
+/// ahead of time, so that starting a handshake only needs to [`pop`] one.
+///
+/// The pool is refilled either by a background thread (see [`EllSwiftKeyPool::with_worker`]),
+/// which tops it up to its capacity whenever it falls to half of it, or by the caller during
+/// idle time (see [`EllSwiftKeyPool::refill`]).
+///
+/// Keys still in the pool are erased when it is dropped, and a key's slot is erased when it is
+/// popped. See [`SecretKey::non_secure_erase`] for the limits of this erasure.
+///
+/// [`pop`]: EllSwiftKeyPool::pop
+#[cfg(all(feature = "std", feature = "rand"))]
+pub struct EllSwiftKeyPool {
+    shared: std::sync::Arc<PoolShared>,
+    worker: Option<std::thread::JoinHandle<()>>,
+}
+
+#[cfg(all(feature = "std", feature = "rand"))]
+struct PoolShared {
+    state: std::sync::Mutex<PoolState>,
+    /// Signalled when the pool falls to its low-water mark, or when it is shutting down.
+    low: std::sync::Condvar,
+    capacity: usize,
+}
+
+#[cfg(all(feature = "std", feature = "rand"))]
+struct PoolState {
+    keys: alloc::vec::Vec<(SecretKey, ElligatorSwift)>,
+    shutdown: bool,
+}
+
+#[cfg(all(feature = "std", feature = "rand"))]
+impl PoolShared {
+    fn lock(&self) -> std::sync::MutexGuard<'_, PoolState> {
+        // Nothing panics while the lock is held, but never let poisoning wedge the handshake path.
+        self.state.lock().unwrap_or_else(std::sync::PoisonError::into_inner)
+    }
+
+    fn low_water(&self) -> usize { self.capacity / 2 }
+
+    /// Number of keys needed to fill the pool, at most one refill chunk.
+    fn wanted(&self, state: &PoolState) -> usize {
+        core::cmp::min(self.capacity - state.keys.len(), POOL_REFILL_CHUNK)
+    }
+
+    /// Moves `fresh` into the pool, erasing whatever does not fit.
+    fn push(&self, fresh: &mut [(SecretKey, ElligatorSwift)]) -> usize {
+        let mut state = self.lock();
+        let mut added = 0;
+        for entry in fresh.iter_mut() {
+            if state.keys.len() < self.capacity {
+                state.keys.push(*entry);
+                added += 1;
+            }
+            entry.0.non_secure_erase();
+        }
+        added
+    }
+
+    /// Body of the background refill thread.
+    fn run_worker(&self) {
+        let secp = crate::Secp256k1::signing_only();
+        let mut rng = rand::thread_rng();
+        let mut filling = false;
+        loop {
+            let want = {
+                let mut state = self.lock();
+                if state.keys.len() >= self.capacity {
+                    filling = false;
+                }
+                while !state.shutdown && !filling && state.keys.len() > self.low_water() {
+                    state = self.low.wait(state).unwrap_or_else(std::sync::PoisonError::into_inner);
+                }
+                if state.shutdown {
+                    return;
+                }
+                filling = true;
+                self.wanted(&state)
+            };
+            let mut fresh = generate_pool_keys(&secp, &mut rng, want);
+            self.push(&mut fresh);
+        }
+    }
+}
+
+/// Generates `n` random secret keys together with their `ElligatorSwift` encodings.
+#[cfg(all(feature = "std", feature = "rand"))]
+fn generate_pool_keys<C: Signing, R: rand::Rng + ?Sized>(
+    secp: &Secp256k1<C>,
+    rng: &mut R,
+    n: usize,
+) -> alloc::vec::Vec<(SecretKey, ElligatorSwift)> {
+    let mut sks: alloc::vec::Vec<SecretKey> = (0..n).map(|_| SecretKey::new(rng)).collect();
+    let aux: alloc::vec::Vec<[u8; 32]> = (0..n).map(|_| crate::random_32_bytes(rng)).collect();
+    let ells = ElligatorSwift::from_seckeys(secp, &sks, Some(&aux));
+    let keys = sks.iter().copied().zip(ells).collect();
+    sks.iter_mut().for_each(SecretKey::non_secure_erase);
+    keys
+}
+
+#[cfg(all(feature = "std", feature = "rand"))]
+impl EllSwiftKeyPool {
+    /// Creates an empty pool holding at most `capacity` keys, refilled only by [`refill`].
+    ///
+    /// # Panics
+    ///
+    /// If `capacity` is zero.
+    ///
+    /// [`refill`]: EllSwiftKeyPool::refill
+    pub fn new(capacity: usize) -> EllSwiftKeyPool {
+        assert!(capacity > 0, "pool capacity must be positive");
+        let shared = PoolShared {
+            // Allocate everything up front so secret keys are never left behind by a reallocation.
+            state: std::sync::Mutex::new(PoolState {
+                keys: alloc::vec::Vec::with_capacity(capacity),
+                shutdown: false,
+            }),
+            low: std::sync::Condvar::new(),
+            capacity,
+        };
+        EllSwiftKeyPool { shared: std::sync::Arc::new(shared), worker: None }
+    }
+
+    /// Creates a pool holding at most `capacity` keys, filled by a background thread.
+    ///
+    /// The thread owns its own randomized signing context and uses `rand::thread_rng`. It
+    /// starts filling the pool immediately, and afterwards refills it to `capacity` whenever it
+    /// drops to half of it. The thread is stopped and joined when the pool is dropped.
+    ///
+    /// # Panics
+    ///
+    /// If `capacity` is zero, or if the thread cannot be spawned.
+    pub fn with_worker(capacity: usize) -> EllSwiftKeyPool {
+        let mut pool = EllSwiftKeyPool::new(capacity);
+        let shared = std::sync::Arc::clone(&pool.shared);
+        let worker = std::thread::Builder::new()
+            .name("ellswift-key-pool".into())
+            .spawn(move || shared.run_worker())
+            .expect("failed to spawn ElligatorSwift key pool thread");
+        pool.worker = Some(worker);
+        pool
+    }
+
+    /// Returns the maximum number of keys held by the pool.
+    pub fn capacity(&self) -> usize { self.shared.capacity }
+
+    /// Returns the number of keys currently in the pool.
+    pub fn len(&self) -> usize { self.shared.lock().keys.len() }
+
+    /// Returns whether the pool is currently empty.
+    pub fn is_empty(&self) -> bool { self.len() == 0 }
+
+    /// Takes a precomputed key out of the pool, if there is one.
+    ///
+    /// The returned secret key must only be used for a single key exchange.
+    pub fn pop(&self) -> Option<(SecretKey, ElligatorSwift)> {
+        let mut state = self.shared.lock();
+        let last = state.keys.last_mut()?;
+        let entry = *last;
+        last.0.non_secure_erase();
+        state.keys.pop();
+        if state.keys.len() <= self.shared.low_water() {
+            self.shared.low.notify_one();
+        }
+        Some(entry)
+    }
+
+    /// Takes a precomputed key out of the pool, or generates one on the spot if it is empty.
+    pub fn pop_or_generate<C: Signing, R: rand::Rng + ?Sized>(
+        &self,
+        secp: &Secp256k1<C>,
+        rng: &mut R,
+    ) -> (SecretKey, ElligatorSwift) {
+        match self.pop() {
+            Some(entry) => entry,
+            None => {
+                let mut fresh = generate_pool_keys(secp, rng, 1);
+                let entry = fresh[0];
+                fresh[0].0.non_secure_erase();
+                entry
+            }
+        }
+    }
+
+    /// Fills the pool up to its capacity, returning the number of keys added.
+    ///
+    /// This is meant to be called when the caller is otherwise idle. Keys are generated in
+    /// small batches outside of the pool's lock, so concurrent calls to [`pop`] are not held up.
+    ///
+    /// [`pop`]: EllSwiftKeyPool::pop
+    pub fn refill<C: Signing, R: rand::Rng + ?Sized>(
+        &self,
+        secp: &Secp256k1<C>,
+        rng: &mut R,
+    ) -> usize {
+        let mut added = 0;
+        loop {
+            let want = self.shared.wanted(&self.shared.lock());
+            if want == 0 {
+                return added;
+            }
+            let mut fresh = generate_pool_keys(secp, rng, want);
+            added += self.shared.push(&mut fresh);
+        }
+    }
+}
+
+#[cfg(all(feature = "std", feature = "rand"))]
+impl Drop for EllSwiftKeyPool {
+    fn drop(&mut self) {
+        self.shared.lock().shutdown = true;
+        self.shared.low.notify_all();
+        if let Some(worker) = self.worker.take() {
+            let _ = worker.join();
+        }
+        let mut state = self.shared.lock();
+        state.keys.iter_mut().for_each(|entry| entry.0.non_secure_erase());
+        state.keys.clear();
+    }
+}
+
+#[cfg(all(feature = "std", feature = "rand"))]
+impl fmt::Debug for EllSwiftKeyPool {
+    fn fmt(&self, f: &mut Formatter<'_>) -> fmt::Result {
+        f.debug_struct("EllSwiftKeyPool")
+            .field("capacity", &self.capacity())
+            .field("len", &self.len())
+            .field("worker", &self.worker.is_some())
+            .finish()
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use core::str::FromStr;
@@ -399,6 +730,53 @@ mod tests {
     }
     #[test]
     #[cfg(all(not(secp256k1_fuzz), feature = "alloc"))]
+    fn test_batch_matches_single() {
+        // More than two chunks, the last one partial.
+        let secp = crate::Secp256k1::new();
+        let sks: alloc::vec::Vec<SecretKey> =
+            (1..=37u8).map(|i| SecretKey::from_slice(&[i; 32]).unwrap()).collect();
+        let aux: alloc::vec::Vec<[u8; 32]> = (1..=37u8).map(|i| [i.wrapping_mul(7); 32]).collect();
+
+        let ells = ElligatorSwift::from_seckeys(&secp, &sks, Some(&aux));
+        let ells_no_aux = ElligatorSwift::from_seckeys(&secp, &sks, None);
+        for i in 0..sks.len() {
+            assert_eq!(ells[i], ElligatorSwift::from_seckey(&secp, sks[i], Some(aux[i])));
+            assert_eq!(ells_no_aux[i], ElligatorSwift::from_seckey(&secp, sks[i], None));
+        }
+
+        let pks = ElligatorSwift::decode_batch(&ells);
+        for i in 0..ells.len() {
+            assert_eq!(pks[i], PublicKey::from_ellswift(ells[i]));
+            assert_eq!(pks[i], PublicKey::from_secret_key(&secp, &sks[i]));
+        }
+
+        let exchanges: alloc::vec::Vec<_> = (0..sks.len())
+            .map(|i| {
+                let j = (i + 1) % sks.len();
+                if i % 2 == 0 {
+                    (ells[i], ells_no_aux[j], sks[i], Party::Initiator)
+                } else {
+                    (ells_no_aux[j], ells[i], sks[i], Party::Responder)
+                }
+            })
+            .collect();
+        let secrets = ElligatorSwift::shared_secret_batch(&exchanges, None);
+        for (e, secret) in exchanges.iter().zip(secrets.iter()) {
+            assert_eq!(*secret, ElligatorSwift::shared_secret(e.0, e.1, e.2, e.3, None));
+        }
+        // Both sides of every exchange agree.
+        for i in 0..sks.len() {
+            let j = (i + 1) % sks.len();
+            let (a, b, _, ours) = exchanges[i];
+            let theirs = match ours {
+                Party::Initiator => Party::Responder,
+                Party::Responder => Party::Initiator,
+            };
+            assert_eq!(secrets[i], ElligatorSwift::shared_secret(a, b, sks[j], theirs, None));
+        }
+    }
+    #[test]
+    #[cfg(all(not(secp256k1_fuzz), feature = "alloc"))]
     fn test_xdh_with_custom_hasher() {
         // Test the ECDH with a custom hash function
         let secp = crate::Secp256k1::new();
@@ -741,4 +1119,42 @@ mod tests {
             assert_eq!(pk, test.key);
         }
     }
+
+    #[test]
+    #[cfg(all(not(secp256k1_fuzz), feature = "std", feature = "rand"))]
+    fn key_pool_idle_refill() {
+        use super::EllSwiftKeyPool;
+
+        let secp = crate::Secp256k1::new();
+        let mut rng = rand::thread_rng();
+        let pool = EllSwiftKeyPool::new(20);
+        assert!(pool.is_empty());
+        assert_eq!(pool.refill(&secp, &mut rng), 20);
+        assert_eq!(pool.refill(&secp, &mut rng), 0);
+        assert_eq!(pool.len(), 20);
+
+        for _ in 0..20 {
+            let (sk, ell) = pool.pop().unwrap();
+            assert_eq!(PublicKey::from_ellswift(ell), PublicKey::from_secret_key(&secp, &sk));
+        }
+        assert!(pool.pop().is_none());
+        let (sk, ell) = pool.pop_or_generate(&secp, &mut rng);
+        assert_eq!(PublicKey::from_ellswift(ell), PublicKey::from_secret_key(&secp, &sk));
+    }
+
+    #[test]
+    #[cfg(all(not(secp256k1_fuzz), feature = "std", feature = "rand"))]
+    fn key_pool_worker() {
+        use super::EllSwiftKeyPool;
+
+        let secp = crate::Secp256k1::new();
+        let mut rng = rand::thread_rng();
+        let pool = EllSwiftKeyPool::with_worker(8);
+        for _ in 0..50 {
+            let (sk, ell) = pool.pop_or_generate(&secp, &mut rng);
+            assert_eq!(PublicKey::from_ellswift(ell), PublicKey::from_secret_key(&secp, &sk));
+            assert!(pool.len() <= pool.capacity());
+        }
+        drop(pool);
+    }
 }
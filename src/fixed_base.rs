@@ -0,0 +1,315 @@
+// SPDX-License-Identifier: CC0-1.0
+
+//! Precomputed tables for multiplying a fixed point.
+//!
+//! Multiplying the generator is several times faster than [`PublicKey::mul_tweak`] because the
+//! library ships a table of multiples of the generator. A [`FixedBaseTable`] is the same kind of
+//! table for any other point, built at runtime. It pays off for a point which is multiplied many
+//! times, such as a static ECDH key or a fixed basis point of a commitment scheme.
+//!
+//! ```
+//! # #[cfg(not(secp256k1_fuzz))] {
+//! use secp256k1::fixed_base::FixedBaseTable;
+//! use secp256k1::{PublicKey, Scalar, Secp256k1, SecretKey};
+//!
+//! let secp = Secp256k1::new();
+//! let point = SecretKey::from_slice(&[7; 32]).unwrap().public_key(&secp);
+//! let table = FixedBaseTable::new(&point, 6, 11);
+//!
+//! let tweak = Scalar::from_be_bytes([3; 32]).unwrap();
+//! assert_eq!(table.mul(&secp, &tweak).unwrap(), point.mul_tweak(&secp, &tweak).unwrap());
+//! assert_eq!(table.mul_var(&tweak).unwrap(), point.mul_tweak(&secp, &tweak).unwrap());
+//!
+//! let bytes = table.serialize();
+//! assert_eq!(FixedBaseTable::deserialize(&bytes).unwrap().mul_var(&tweak), table.mul_var(&tweak));
+//! # }
+//! ```
+
+use alloc::vec::Vec;
+use core::fmt;
+
+use crate::ffi::types::{c_uint, c_void, AlignedType};
+use crate::ffi::CPtr;
+use crate::{constants, ffi, Context, Error, PublicKey, Scalar, Secp256k1};
+
+/// Size of the header of a serialized table: the compressed point, the number of teeth and the
+/// number of blocks as a big-endian `u16`.
+const HEADER_SIZE: usize = constants::PUBLIC_KEY_SIZE + 3;
+
+/// A comb table of multiples of a point.
+///
+/// The table uses the signed-digit multi-comb with which the library multiplies the generator.
+/// Its size and speed are set by the number of `teeth` and `blocks`: the table holds
+/// `blocks * 2^(teeth - 1)` points of 64 bytes, and a multiplication takes about
+/// `256 / teeth` point additions. Building a table costs about as much as 10 to 20
+/// multiplications with [`PublicKey::mul_tweak`].
+///
+/// With 6 teeth and 11 blocks (22 kB, the configuration of the generator table of the library),
+/// [`mul`] is as fast as multiplying the generator, about 1.7 times faster than
+/// [`PublicKey::mul_tweak`], and [`mul_var`] is about 2.5 times faster. With 8 teeth and 4 blocks
+/// (32 kB) [`mul_var`] is about 3.3 times faster, but [`mul`] is slower than with 6 teeth because
+/// every lookup scans twice as many entries.
+///
+/// [`mul`]: FixedBaseTable::mul
+/// [`mul_var`]: FixedBaseTable::mul_var
+#[derive(Clone)]
+pub struct FixedBaseTable {
+    point: PublicKey,
+    teeth: u8,
+    blocks: u16,
+    entries: Vec<AlignedType>,
+}
+
+impl FixedBaseTable {
+    /// Returns the size in bytes of a table with `teeth` and `blocks`, or `None` if these are
+    /// not supported.
+    ///
+    /// Teeth must be between 1 and 8 and blocks between 1 and 256. Combinations for which fewer
+    /// teeth or blocks would take the same number of additions are not supported.
+    pub fn size(teeth: usize, blocks: usize) -> Option<usize> {
+        if teeth > 8 || blocks > 256 {
+            return None;
+        }
+        match unsafe { ffi::secp256k1_fixed_base_table_size(teeth as c_uint, blocks as c_uint) } {
+            0 => None,
+            size => Some(size),
+        }
+    }
+
+    /// Builds the table for `point`.
+    ///
+    /// # Panics
+    ///
+    /// If `teeth` and `blocks` are not supported, see [`FixedBaseTable::size`].
+    pub fn new(point: &PublicKey, teeth: usize, blocks: usize) -> FixedBaseTable {
+        let mut table = FixedBaseTable::empty(*point, teeth, blocks)
+            .expect("unsupported number of teeth and blocks");
+        unsafe {
+            let ret = ffi::secp256k1_fixed_base_table_build(
+                ffi::secp256k1_context_no_precomp,
+                table.entries.as_mut_ptr() as *mut c_void,
+                point.as_c_ptr(),
+                teeth as c_uint,
+                blocks as c_uint,
+            );
+            // Public keys are valid and the entries are nonzero multiples of them.
+            assert_eq!(ret, 1);
+        }
+        table
+    }
+
+    /// Returns a table for `point` with zeroed entries, or `None` for unsupported parameters.
+    fn empty(point: PublicKey, teeth: usize, blocks: usize) -> Option<FixedBaseTable> {
+        let size = FixedBaseTable::size(teeth, blocks)?;
+        Some(FixedBaseTable {
+            point,
+            teeth: teeth as u8,
+            blocks: blocks as u16,
+            entries: alloc::vec![AlignedType::zeroed(); (size + 15) / 16],
+        })
+    }
+
+    /// Returns the point whose multiples the table holds.
+    pub fn point(&self) -> PublicKey { self.point }
+
+    /// Returns the number of teeth of the comb.
+    pub fn teeth(&self) -> usize { self.teeth.into() }
+
+    /// Returns the number of blocks of the comb.
+    pub fn blocks(&self) -> usize { self.blocks.into() }
+
+    /// Returns the size in bytes of the table.
+    pub fn memory_usage(&self) -> usize { self.entries.len() * 16 }
+
+    /// Multiplies the point by `tweak`, in constant time.
+    ///
+    /// Gives the same result as [`PublicKey::mul_tweak`], without leaking `tweak` through
+    /// timing or memory access, so it is suitable for secret scalars. With a signing context the
+    /// intermediate points are blinded by the context's randomization, as in signing.
+    ///
+    /// # Errors
+    ///
+    /// If `tweak` is zero.
+    pub fn mul<C: Context>(&self, secp: &Secp256k1<C>, tweak: &Scalar) -> Result<PublicKey, Error> {
+        unsafe {
+            let mut pk = ffi::PublicKey::new();
+            if ffi::secp256k1_fixed_base_mul(
+                secp.ctx.as_ptr(),
+                &mut pk,
+                self.entries.as_ptr() as *const c_void,
+                self.teeth.into(),
+                self.blocks.into(),
+                tweak.as_c_ptr(),
+            ) == 1
+            {
+                Ok(PublicKey::from(pk))
+            } else {
+                Err(Error::InvalidTweak)
+            }
+        }
+    }
+
+    /// Multiplies the point by `tweak`, in variable time.
+    ///
+    /// This is faster than [`FixedBaseTable::mul`], but leaks `tweak` through timing and memory
+    /// access. Use it only for public scalars, as in verification.
+    ///
+    /// # Errors
+    ///
+    /// If `tweak` is zero.
+    pub fn mul_var(&self, tweak: &Scalar) -> Result<PublicKey, Error> {
+        unsafe {
+            let mut pk = ffi::PublicKey::new();
+            if ffi::secp256k1_fixed_base_mul_var(
+                ffi::secp256k1_context_no_precomp,
+                &mut pk,
+                self.entries.as_ptr() as *const c_void,
+                self.teeth.into(),
+                self.blocks.into(),
+                tweak.as_c_ptr(),
+            ) == 1
+            {
+                Ok(PublicKey::from(pk))
+            } else {
+                Err(Error::InvalidTweak)
+            }
+        }
+    }
+
+    /// Serializes the table, so that it can be stored instead of being rebuilt.
+    ///
+    /// The serialization is portable across platforms. It consists of the compressed point, the
+    /// number of teeth as a byte, the number of blocks as a big-endian `u16` and then the
+    /// coordinates of every entry, 64 bytes each.
+    pub fn serialize(&self) -> Vec<u8> {
+        let entries = self.memory_usage() / 64;
+        let mut out = alloc::vec![0u8; HEADER_SIZE + 64 * entries];
+        out[..constants::PUBLIC_KEY_SIZE].copy_from_slice(&self.point.serialize());
+        out[constants::PUBLIC_KEY_SIZE] = self.teeth;
+        out[HEADER_SIZE - 2..HEADER_SIZE].copy_from_slice(&self.blocks.to_be_bytes());
+        unsafe {
+            let ret = ffi::secp256k1_fixed_base_table_serialize(
+                ffi::secp256k1_context_no_precomp,
+                out[HEADER_SIZE..].as_mut_c_ptr(),
+                self.entries.as_ptr() as *const c_void,
+                self.teeth.into(),
+                self.blocks.into(),
+            );
+            // The parameters were checked when the table was made.
+            assert_eq!(ret, 1);
+        }
+        out
+    }
+
+    /// Deserializes a table serialized with [`FixedBaseTable::serialize`].
+    ///
+    /// Every entry is checked to be a point on the curve, and the first block of entries is
+    /// recomputed from the point, which rejects a table of another point and most corruption.
+    /// Checking the other entries would take as long as building the table, so a tampered
+    /// serialization can still give wrong products: only deserialize tables from trusted storage.
+    ///
+    /// # Errors
+    ///
+    /// If the data is not a serialized table.
+    pub fn deserialize(data: &[u8]) -> Result<FixedBaseTable, Error> {
+        if data.len() < HEADER_SIZE {
+            return Err(Error::InvalidPublicKey);
+        }
+        let point = PublicKey::from_slice(&data[..constants::PUBLIC_KEY_SIZE])?;
+        let teeth = usize::from(data[constants::PUBLIC_KEY_SIZE]);
+        let blocks = usize::from(u16::from_be_bytes([
+            data[constants::PUBLIC_KEY_SIZE + 1],
+            data[constants::PUBLIC_KEY_SIZE + 2],
+        ]));
+        let mut table = FixedBaseTable::empty(point, teeth, blocks).ok_or(Error::InvalidPublicKey)?;
+        if data.len() != HEADER_SIZE + table.memory_usage() {
+            return Err(Error::InvalidPublicKey);
+        }
+        unsafe {
+            if ffi::secp256k1_fixed_base_table_parse(
+                ffi::secp256k1_context_no_precomp,
+                table.entries.as_mut_ptr() as *mut c_void,
+                data[HEADER_SIZE..].as_c_ptr(),
+                point.as_c_ptr(),
+                teeth as c_uint,
+                blocks as c_uint,
+            ) != 1
+            {
+                return Err(Error::InvalidPublicKey);
+            }
+        }
+        Ok(table)
+    }
+}
+
+impl fmt::Debug for FixedBaseTable {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        f.debug_struct("FixedBaseTable")
+            .field("point", &self.point)
+            .field("teeth", &self.teeth)
+            .field("blocks", &self.blocks)
+            .finish()
+    }
+}
+
+#[cfg(all(test, not(secp256k1_fuzz)))]
+mod tests {
+    use super::*;
+    use crate::SecretKey;
+
+    #[test]
+    fn fixed_base_table() {
+        let secp = Secp256k1::new();
+        let point = SecretKey::from_slice(&[5; 32]).unwrap().public_key(&secp);
+        let tweaks = [
+            Scalar::ONE,
+            Scalar::from_be_bytes([0x42; 32]).unwrap(),
+            Scalar::from_be_bytes([0x7f; 32]).unwrap(),
+            Scalar::MAX,
+        ];
+
+        assert_eq!(FixedBaseTable::size(6, 11), Some(22528));
+        assert_eq!(FixedBaseTable::size(0, 11), None);
+        assert_eq!(FixedBaseTable::size(9, 4), None);
+        assert_eq!(FixedBaseTable::size(6, 12), None);
+        assert_eq!(FixedBaseTable::size(1, 256), Some(16384));
+        for &(teeth, blocks) in &[(1, 1), (1, 256), (2, 43), (4, 8), (5, 26), (6, 11), (8, 4)] {
+            let table = FixedBaseTable::new(&point, teeth, blocks);
+            assert_eq!(table.memory_usage(), FixedBaseTable::size(teeth, blocks).unwrap());
+            for tweak in &tweaks {
+                let expected = point.mul_tweak(&secp, tweak).unwrap();
+                assert_eq!(table.mul(&secp, tweak).unwrap(), expected);
+                assert_eq!(table.mul_var(tweak).unwrap(), expected);
+            }
+            assert_eq!(table.mul(&secp, &Scalar::ZERO), Err(Error::InvalidTweak));
+            assert_eq!(table.mul_var(&Scalar::ZERO), Err(Error::InvalidTweak));
+
+            let bytes = table.serialize();
+            let parsed = FixedBaseTable::deserialize(&bytes).unwrap();
+            assert_eq!((parsed.point(), parsed.teeth(), parsed.blocks()), (point, teeth, blocks));
+            assert_eq!(parsed.mul_var(&tweaks[1]), table.mul_var(&tweaks[1]));
+            assert_eq!(parsed.serialize(), bytes);
+        }
+
+        let bytes = FixedBaseTable::new(&point, 4, 8).serialize();
+        assert!(FixedBaseTable::deserialize(&bytes[..bytes.len() - 1]).is_err());
+        assert!(FixedBaseTable::deserialize(&bytes[..HEADER_SIZE]).is_err());
+        let mut bad = bytes.clone();
+        bad[constants::PUBLIC_KEY_SIZE] = 5;
+        assert!(FixedBaseTable::deserialize(&bad).is_err());
+        // An entry which is not on the curve.
+        let mut bad = bytes.clone();
+        bad[HEADER_SIZE + 64 * 3 + 63] ^= 1;
+        assert!(FixedBaseTable::deserialize(&bad).is_err());
+        // Entries of the table of another point.
+        let other = SecretKey::from_slice(&[6; 32]).unwrap().public_key(&secp);
+        let mut bad = bytes.clone();
+        bad[..constants::PUBLIC_KEY_SIZE].copy_from_slice(&other.serialize());
+        assert!(FixedBaseTable::deserialize(&bad).is_err());
+        // Two entries of the first block swapped, which are both on the curve.
+        let mut bad = bytes;
+        let (first, second) = bad[HEADER_SIZE..].split_at_mut(64);
+        first.swap_with_slice(&mut second[..64]);
+        assert!(FixedBaseTable::deserialize(&bad).is_err());
+    }
+}
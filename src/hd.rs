@@ -0,0 +1,262 @@
+// SPDX-License-Identifier: CC0-1.0
+
+//! Batched public child key derivation as described in [BIP32].
+//!
+//! Scanning a wallet for used addresses requires deriving many consecutive non-hardened children
+//! of the same extended public key. Doing this one child at a time with
+//! [`PublicKey::add_exp_tweak`] parses the parent, performs a full point addition and normalizes
+//! the result for every child. [`ExtendedPublicKey::derive_children`] parses the parent only once,
+//! reuses its affine point for every child and brings the children to affine coordinates with one
+//! field inversion per chunk of 16.
+//!
+//! This library does not implement SHA512, so the HMAC-SHA512 step of the derivation is supplied
+//! by the caller as a closure. With the `hashes` feature enabled it can be written as
+//!
+//! ```
+//! # #[cfg(feature = "hashes")] {
+//! use secp256k1::hashes::{sha512, Hash, HashEngine, Hmac, HmacEngine};
+//!
+//! fn hmac_sha512(key: &[u8; 32], data: &[u8; 37]) -> [u8; 64] {
+//!     let mut engine = HmacEngine::<sha512::Hash>::new(key);
+//!     engine.input(data);
+//!     Hmac::<sha512::Hash>::from_engine(engine).to_byte_array()
+//! }
+//! # }
+//! ```
+//!
+//! [BIP32]: https://github.com/bitcoin/bips/blob/master/bip-0032.mediawiki
+
+use core::ops::Range;
+
+use crate::ffi::types::{c_int, c_uchar};
+use crate::ffi::{self, CPtr};
+use crate::{constants, Error, PublicKey, Secp256k1, Signing};
+
+/// The size of a BIP32 chain code.
+pub const CHAIN_CODE_SIZE: usize = 32;
+
+/// The first hardened child index. Hardened children cannot be derived from a public key.
+pub const HARDENED_INDEX: u32 = 1 << 31;
+
+/// The size of the HMAC-SHA512 input for a non-hardened child: the compressed parent public key
+/// followed by the big-endian child index.
+pub const HMAC_DATA_SIZE: usize = constants::PUBLIC_KEY_SIZE + 4;
+
+/// A public key together with its BIP32 chain code.
+#[derive(Copy, Clone, Debug, PartialEq, Eq, Hash)]
+pub struct ExtendedPublicKey {
+    /// The public key.
+    pub public_key: PublicKey,
+    /// The chain code.
+    pub chain_code: [u8; CHAIN_CODE_SIZE],
+}
+
+impl ExtendedPublicKey {
+    /// Creates an extended public key from its parts.
+    #[inline]
+    pub fn new(public_key: PublicKey, chain_code: [u8; CHAIN_CODE_SIZE]) -> ExtendedPublicKey {
+        ExtendedPublicKey { public_key, chain_code }
+    }
+
+    /// Derives the non-hardened child with the given index.
+    ///
+    /// `hmac_sha512(key, data)` must return HMAC-SHA512 of `data` keyed with `key`.
+    ///
+    /// # Errors
+    ///
+    /// Returns [`Error::InvalidTweak`] if `index` is a hardened index, or if it does not produce a
+    /// valid child (which happens with probability lower than 2^-127). BIP32 says to proceed with
+    /// the next index in the latter case.
+    pub fn derive_child<C: Signing, F>(
+        &self,
+        secp: &Secp256k1<C>,
+        index: u32,
+        hmac_sha512: F,
+    ) -> Result<ExtendedPublicKey, Error>
+    where
+        F: FnMut(&[u8; CHAIN_CODE_SIZE], &[u8; HMAC_DATA_SIZE]) -> [u8; 64],
+    {
+        if index >= HARDENED_INDEX {
+            return Err(Error::InvalidTweak);
+        }
+        let mut child = unsafe { ffi::PublicKey::new() };
+        let mut chain_code = [0; CHAIN_CODE_SIZE];
+        let ret = self.derive_into(
+            secp,
+            index..index + 1,
+            core::slice::from_mut(&mut child),
+            core::slice::from_mut(&mut chain_code),
+            hmac_sha512,
+        );
+        if ret == 1 {
+            Ok(ExtendedPublicKey::new(PublicKey::from(child), chain_code))
+        } else {
+            Err(Error::InvalidTweak)
+        }
+    }
+
+    /// Derives the non-hardened children with indices in the given range.
+    ///
+    /// The `i`-th element of the result is the child with index `indices.start + i`, or `None`
+    /// if that index does not produce a valid child (see [`ExtendedPublicKey::derive_child`]).
+    /// `hmac_sha512` is called once per child, in order of increasing index.
+    ///
+    /// # Panics
+    ///
+    /// If the range contains a hardened index.
+    #[cfg(feature = "alloc")]
+    pub fn derive_children<C: Signing, F>(
+        &self,
+        secp: &Secp256k1<C>,
+        indices: Range<u32>,
+        hmac_sha512: F,
+    ) -> alloc::vec::Vec<Option<ExtendedPublicKey>>
+    where
+        F: FnMut(&[u8; CHAIN_CODE_SIZE], &[u8; HMAC_DATA_SIZE]) -> [u8; 64],
+    {
+        let n = indices.len();
+        let mut children = alloc::vec![unsafe { ffi::PublicKey::new() }; n];
+        let mut chain_codes = alloc::vec![[0; CHAIN_CODE_SIZE]; n];
+        self.derive_into(secp, indices, &mut children, &mut chain_codes, hmac_sha512);
+
+        // Invalid children are zeroed by the C library.
+        children
+            .into_iter()
+            .zip(chain_codes)
+            .map(|(child, chain_code)| {
+                if child.underlying_bytes() == [0; 64] {
+                    None
+                } else {
+                    Some(ExtendedPublicKey::new(PublicKey::from(child), chain_code))
+                }
+            })
+            .collect()
+    }
+
+    /// Computes the HMACs for `indices` on the stack and hands them to the C library in chunks.
+    ///
+    /// Returns 1 if all children are valid.
+    fn derive_into<C: Signing, F>(
+        &self,
+        secp: &Secp256k1<C>,
+        indices: Range<u32>,
+        children: &mut [ffi::PublicKey],
+        chain_codes: &mut [[u8; CHAIN_CODE_SIZE]],
+        mut hmac_sha512: F,
+    ) -> c_int
+    where
+        F: FnMut(&[u8; CHAIN_CODE_SIZE], &[u8; HMAC_DATA_SIZE]) -> [u8; 64],
+    {
+        const CHUNK: usize = 64;
+
+        assert!(indices.end <= HARDENED_INDEX, "cannot derive hardened children from a public key");
+        debug_assert_eq!(children.len(), indices.len());
+
+        let mut data = [0; HMAC_DATA_SIZE];
+        data[..constants::PUBLIC_KEY_SIZE].copy_from_slice(&self.public_key.serialize());
+
+        let mut tweaks = [[0u8; 32]; CHUNK];
+        let mut ret = 1;
+        let mut index = indices.start;
+        for (children, chain_codes) in children.chunks_mut(CHUNK).zip(chain_codes.chunks_mut(CHUNK)) {
+            for (tweak, chain_code) in tweaks.iter_mut().zip(chain_codes.iter_mut()) {
+                data[constants::PUBLIC_KEY_SIZE..].copy_from_slice(&index.to_be_bytes());
+                let i = hmac_sha512(&self.chain_code, &data);
+                tweak.copy_from_slice(&i[..32]);
+                chain_code.copy_from_slice(&i[32..]);
+                index += 1;
+            }
+            unsafe {
+                ret &= ffi::secp256k1_ec_pubkey_derive_batch(
+                    secp.ctx().as_ptr(),
+                    children.as_mut_c_ptr(),
+                    self.public_key.as_c_ptr(),
+                    tweaks.as_c_ptr() as *const c_uchar,
+                    children.len(),
+                );
+            }
+        }
+        ret
+    }
+}
+
+#[cfg(all(test, feature = "alloc", not(secp256k1_fuzz)))]
+mod tests {
+    use super::*;
+    use crate::{Scalar, SecretKey};
+
+    /// Not an HMAC, but a deterministic stand-in that produces valid tweaks.
+    fn fake_hmac(key: &[u8; 32], data: &[u8; HMAC_DATA_SIZE]) -> [u8; 64] {
+        let mut out = [0u8; 64];
+        for (k, byte) in out.iter_mut().enumerate() {
+            *byte = (key[k % 32] ^ data[k % HMAC_DATA_SIZE]).wrapping_add(data[36].wrapping_mul(k as u8));
+        }
+        out[0] &= 0x7f;
+        out
+    }
+
+    #[test]
+    fn derive_children_matches_single() {
+        let secp = Secp256k1::new();
+        let sk = SecretKey::from_slice(&[0xcd; 32]).unwrap();
+        let xpub = ExtendedPublicKey::new(PublicKey::from_secret_key(&secp, &sk), [0x5a; 32]);
+
+        // Spans more than one chunk and starts at an unaligned index.
+        let children = xpub.derive_children(&secp, 1000..1150, fake_hmac);
+        assert_eq!(children.len(), 150);
+        for (i, child) in (1000..1150).zip(children) {
+            let child = child.unwrap();
+            assert_eq!(child, xpub.derive_child(&secp, i, fake_hmac).unwrap());
+
+            let mut data = [0; HMAC_DATA_SIZE];
+            data[..33].copy_from_slice(&xpub.public_key.serialize());
+            data[33..].copy_from_slice(&u32::to_be_bytes(i));
+            let hmac = fake_hmac(&xpub.chain_code, &data);
+            let tweak = Scalar::from_be_bytes(hmac[..32].try_into().unwrap()).unwrap();
+            assert_eq!(child.public_key, xpub.public_key.add_exp_tweak(&secp, &tweak).unwrap());
+            assert_eq!(child.chain_code[..], hmac[32..]);
+        }
+
+        assert!(xpub.derive_children(&secp, 5..5, fake_hmac).is_empty());
+    }
+
+    #[test]
+    fn derive_children_invalid_tweak() {
+        let secp = Secp256k1::new();
+        let sk = SecretKey::from_slice(&[0xcd; 32]).unwrap();
+        let xpub = ExtendedPublicKey::new(PublicKey::from_secret_key(&secp, &sk), [0x5a; 32]);
+
+        // An out-of-range tweak for even indices only.
+        let hmac = |key: &[u8; 32], data: &[u8; HMAC_DATA_SIZE]| {
+            let mut out = fake_hmac(key, data);
+            if data[36] % 2 == 0 {
+                out[..32].copy_from_slice(&[0xff; 32]);
+            }
+            out
+        };
+        let children = xpub.derive_children(&secp, 0..20, hmac);
+        for (i, child) in children.iter().enumerate() {
+            assert_eq!(child.is_none(), i % 2 == 0);
+        }
+        assert_eq!(xpub.derive_child(&secp, 4, hmac), Err(Error::InvalidTweak));
+    }
+
+    #[test]
+    fn derive_hardened_child() {
+        let secp = Secp256k1::signing_only();
+        let pk = PublicKey::from_secret_key(&secp, &SecretKey::from_slice(&[0xcd; 32]).unwrap());
+        let xpub = ExtendedPublicKey::new(pk, [0; 32]);
+        assert_eq!(xpub.derive_child(&secp, HARDENED_INDEX, fake_hmac), Err(Error::InvalidTweak));
+        assert_eq!(xpub.derive_child(&secp, u32::MAX, fake_hmac), Err(Error::InvalidTweak));
+        assert!(xpub.derive_child(&secp, HARDENED_INDEX - 1, fake_hmac).is_ok());
+    }
+
+    #[test]
+    #[should_panic]
+    fn derive_hardened_children() {
+        let secp = Secp256k1::signing_only();
+        let pk = PublicKey::from_secret_key(&secp, &SecretKey::from_slice(&[0xcd; 32]).unwrap());
+        let xpub = ExtendedPublicKey::new(pk, [0; 32]);
+        let _ = xpub.derive_children(&secp, HARDENED_INDEX - 1..HARDENED_INDEX + 1, fake_hmac);
+    }
+}
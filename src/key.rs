@@ -55,6 +55,7 @@ use crate::{
 /// [`cbor`]: https://docs.rs/cbor
 /// [cryptographically secure pseudorandom number generator]: https://en.wikipedia.org/wiki/Cryptographically_secure_pseudorandom_number_generator
 #[derive(Copy, Clone)]
+#[repr(transparent)]
 pub struct SecretKey([u8; constants::SECRET_KEY_SIZE]);
 impl_display_secret!(SecretKey);
 impl_non_secure_erase!(SecretKey, 0, [1u8; constants::SECRET_KEY_SIZE]);
@@ -715,6 +716,41 @@ impl PublicKey {
         }
     }
 
+    /// Sorts `keys` in the order of [`Ord`], that is by their compressed serialization.
+    ///
+    /// `keys.sort()` serializes both keys in every comparison. This function serializes every key
+    /// once and sorts the serializations, which is much faster for more than a few keys, e.g. in
+    /// MuSig2 key aggregation or for `sortedmulti` descriptors.
+    #[cfg(feature = "alloc")]
+    pub fn sort_slice(keys: &mut [PublicKey]) {
+        #[cfg(secp256k1_fuzz)]
+        {
+            // Fuzzing keys are compared by their bytes.
+            keys.sort_unstable();
+        }
+        #[cfg(not(secp256k1_fuzz))]
+        unsafe {
+            use alloc::vec::Vec;
+
+            use crate::ffi::types::AlignedType;
+
+            let mut ptrs: Vec<*const ffi::PublicKey> = keys.iter().map(|k| k.as_c_ptr()).collect();
+            let size = ffi::secp256k1_ec_pubkey_sort_scratch_size(keys.len());
+            let mut scratch = alloc::vec![AlignedType::zeroed(); (size + 15) / 16];
+            let ret = ffi::secp256k1_ec_pubkey_sort_scratch(
+                ffi::secp256k1_context_no_precomp,
+                ptrs.as_mut_ptr(),
+                keys.len(),
+                scratch.as_mut_ptr() as *mut ffi::types::c_void,
+                scratch.len() * 16,
+            );
+            debug_assert_eq!(ret, 1);
+
+            let sorted: Vec<PublicKey> = ptrs.iter().map(|&pk| PublicKey(*pk)).collect();
+            keys.copy_from_slice(&sorted);
+        }
+    }
+
     /// Returns the [`XOnlyPublicKey`] (and its [`Parity`]) for this [`PublicKey`].
     #[inline]
     pub fn x_only_public_key(&self) -> (XOnlyPublicKey, Parity) {
@@ -919,6 +955,86 @@ impl Keypair {
         Keypair::from_seckey_str(SECP256K1, s)
     }
 
+    /// Creates key pairs from secret keys and their stored public keys, such as the keys of a
+    /// wallet loaded from disk.
+    ///
+    /// Unlike [`Keypair::from_secret_key`], this does not compute any public key. The stored keys
+    /// are checked instead, in chunks of 4096 pairs: one randomized check per
+    /// chunk costs a single constant-time multiplication with G and one multi-scalar
+    /// multiplication of the public keys. Only the pairs of a chunk which fails the check are
+    /// checked one by one.
+    ///
+    /// Returns the key pairs in order, with [`Error::InvalidPublicKey`] for every public key
+    /// which does not belong to its secret key.
+    ///
+    /// ```
+    /// # #[cfg(not(secp256k1_fuzz))] {
+    /// use secp256k1::{Error, Keypair, Secp256k1, SecretKey};
+    ///
+    /// let secp = Secp256k1::new();
+    /// let mut stored: Vec<_> = (1..=10u8)
+    ///     .map(|i| {
+    ///         let sk = SecretKey::from_slice(&[i; 32]).unwrap();
+    ///         (sk, sk.public_key(&secp))
+    ///     })
+    ///     .collect();
+    /// stored[4].1 = stored[5].1;
+    ///
+    /// let keypairs = Keypair::from_keys_batch(&secp, &stored);
+    /// assert_eq!(keypairs[3].unwrap().public_key(), stored[3].1);
+    /// assert_eq!(keypairs[4], Err(Error::InvalidPublicKey));
+    /// # }
+    /// ```
+    #[cfg(feature = "alloc")]
+    pub fn from_keys_batch<C: Signing>(
+        secp: &Secp256k1<C>,
+        items: &[(SecretKey, PublicKey)],
+    ) -> alloc::vec::Vec<Result<Keypair, Error>> {
+        use alloc::vec::Vec;
+
+        use crate::ffi::types::AlignedType;
+
+        let size = unsafe {
+            ffi::secp256k1_keypair_import_check_batch_scratch_size(
+                items.len().min(KEYPAIR_IMPORT_CHUNK),
+            )
+        };
+        let mut scratch = alloc::vec![AlignedType::zeroed(); (size + 15) / 16];
+        let mut out = Vec::with_capacity(items.len());
+        for chunk in items.chunks(KEYPAIR_IMPORT_CHUNK) {
+            let mut sks: Vec<SecretKey> = chunk.iter().map(|(sk, _)| *sk).collect();
+            let pks: Vec<ffi::PublicKey> = chunk.iter().map(|(_, pk)| pk.0).collect();
+            let ret = unsafe {
+                ffi::secp256k1_keypair_import_check_batch(
+                    secp.ctx.as_ptr(),
+                    scratch.as_mut_ptr() as *mut ffi::types::c_void,
+                    scratch.len() * 16,
+                    sks.as_c_ptr() as *const ffi::types::c_uchar,
+                    pks.as_ptr(),
+                    chunk.len(),
+                )
+            };
+            sks.iter_mut().for_each(SecretKey::non_secure_erase);
+            out.extend(chunk.iter().map(|(sk, pk)| {
+                if ret == 1 || sk.public_key(secp) == *pk {
+                    Ok(Keypair::from_keys_unchecked(sk, pk))
+                } else {
+                    Err(InvalidPublicKey)
+                }
+            }));
+        }
+        out
+    }
+
+    /// Assembles a key pair from a secret key and its public key, which is not checked.
+    #[cfg(feature = "alloc")]
+    fn from_keys_unchecked(sk: &SecretKey, pk: &PublicKey) -> Keypair {
+        let mut data = [0; 96];
+        data[..32].copy_from_slice(&sk.0);
+        data[32..].copy_from_slice(&pk.0.underlying_bytes());
+        Keypair(unsafe { ffi::Keypair::from_array_unchecked(data) })
+    }
+
     /// Generates a new random key pair.
     /// # Examples
     ///
@@ -1167,6 +1283,7 @@ impl CPtr for Keypair {
 /// [`bincode`]: https://docs.rs/bincode
 /// [`cbor`]: https://docs.rs/cbor
 #[derive(Copy, Clone, PartialOrd, Ord, PartialEq, Eq, Hash)]
+#[repr(transparent)]
 pub struct XOnlyPublicKey(ffi::XOnlyPublicKey);
 impl_fast_comparisons!(XOnlyPublicKey);
 
@@ -1348,13 +1465,104 @@ impl XOnlyPublicKey {
         }
     }
 
+    /// Tweaks many keys at once, see [`XOnlyPublicKey::add_tweak`].
+    ///
+    /// The tweaked keys are brought to affine coordinates with one field inversion per chunk of
+    /// 16 keys, instead of one per key. The `i`-th element of the result belongs to `items[i]`.
+    #[cfg(feature = "alloc")]
+    pub fn add_tweak_batch<V: Verification>(
+        secp: &Secp256k1<V>,
+        items: &[(XOnlyPublicKey, Scalar)],
+    ) -> alloc::vec::Vec<Result<(XOnlyPublicKey, Parity), Error>> {
+        let internal: alloc::vec::Vec<_> = items.iter().map(|(pk, _)| pk.0).collect();
+        let tweaks: alloc::vec::Vec<_> = items.iter().map(|(_, t)| t.to_be_bytes()).collect();
+        XOnlyPublicKey::tweak_batch(&internal, |outputs, parities| unsafe {
+            ffi::secp256k1_xonly_pubkey_tweak_add_batch(
+                secp.ctx.as_ptr(),
+                outputs,
+                parities,
+                internal.as_ptr(),
+                tweaks.as_ptr() as *const ffi::types::c_uchar,
+                internal.len(),
+            )
+        })
+    }
+
+    /// Computes the [BIP341] Taproot output keys of many internal keys at once.
+    ///
+    /// The output key of `internal_keys[i]` is tweaked with the tagged hash "TapTweak" of the
+    /// internal key and `merkle_roots[i]`, or of the internal key alone if `merkle_roots` is
+    /// `None` (outputs without a script path). The tagged hashes all start from one precomputed
+    /// midstate, and the output keys are computed like in [`XOnlyPublicKey::add_tweak_batch`].
+    ///
+    /// # Panics
+    ///
+    /// If `merkle_roots` and `internal_keys` differ in length.
+    ///
+    /// [BIP341]: https://github.com/bitcoin/bips/blob/master/bip-0341.mediawiki
+    #[cfg(feature = "alloc")]
+    pub fn taproot_output_key_batch<V: Verification>(
+        secp: &Secp256k1<V>,
+        internal_keys: &[XOnlyPublicKey],
+        merkle_roots: Option<&[[u8; 32]]>,
+    ) -> alloc::vec::Vec<Result<(XOnlyPublicKey, Parity), Error>> {
+        if let Some(roots) = merkle_roots {
+            assert_eq!(roots.len(), internal_keys.len(), "one merkle root per internal key");
+        }
+        let roots = merkle_roots.map_or(ptr::null(), |r| r.as_ptr() as *const ffi::types::c_uchar);
+        // `XOnlyPublicKey` is `repr(transparent)` over the FFI type.
+        let internal = unsafe {
+            core::slice::from_raw_parts(
+                internal_keys.as_ptr() as *const ffi::XOnlyPublicKey,
+                internal_keys.len(),
+            )
+        };
+        XOnlyPublicKey::tweak_batch(internal, |outputs, parities| unsafe {
+            ffi::secp256k1_xonly_pubkey_taptweak_add_batch(
+                secp.ctx.as_ptr(),
+                outputs,
+                parities,
+                internal.as_ptr(),
+                roots,
+                internal.len(),
+            )
+        })
+    }
+
+    /// Runs `tweak` on output buffers for `internal.len()` keys and collects the results.
+    #[cfg(feature = "alloc")]
+    fn tweak_batch<F>(
+        internal: &[ffi::XOnlyPublicKey],
+        tweak: F,
+    ) -> alloc::vec::Vec<Result<(XOnlyPublicKey, Parity), Error>>
+    where
+        F: FnOnce(*mut ffi::XOnlyPublicKey, *mut ffi::types::c_int) -> ffi::types::c_int,
+    {
+        let mut outputs = alloc::vec![unsafe { ffi::XOnlyPublicKey::new() }; internal.len()];
+        let mut parities = alloc::vec![0; internal.len()];
+        tweak(outputs.as_mut_ptr(), parities.as_mut_ptr());
+
+        // Failed keys are zeroed by the C library.
+        outputs
+            .into_iter()
+            .zip(parities)
+            .map(|(pk, parity)| {
+                if pk.underlying_bytes() == [0; 64] {
+                    Err(Error::InvalidTweak)
+                } else {
+                    Ok((XOnlyPublicKey(pk), Parity::from_i32(parity)?))
+                }
+            })
+            .collect()
+    }
+
     /// Verifies that a tweak produced by [`XOnlyPublicKey::add_tweak`] was computed correctly.
     ///
     /// Should be called on the original untweaked key. Takes the tweaked key and output parity from
     /// [`XOnlyPublicKey::add_tweak`] as input.
     ///
-    /// Currently this is not much more efficient than just recomputing the tweak and checking
-    /// equality. However, in future this API will support batch verification, which is
+    /// This is not much more efficient than just recomputing the tweak and checking equality, but
+    /// many checks can be batched with [`XOnlyPublicKey::tweak_add_check_batch`], which is
     /// significantly faster, so it is wise to design protocols with this in mind.
     ///
     /// # Returns
@@ -1398,6 +1606,52 @@ impl XOnlyPublicKey {
         }
     }
 
+    /// Checks many tweaks at once, see [`XOnlyPublicKey::tweak_add_check`].
+    ///
+    /// Each item holds an internal key, a tweaked key with its parity and the tweak, as in the
+    /// commitment of a Taproot script path spend. The items are first checked together, with one
+    /// randomized multi-scalar multiplication, and only checked one by one if that fails.
+    ///
+    /// Returns the indices into `items` of the checks which fail, in increasing order; the result
+    /// is empty if all of them succeed.
+    #[cfg(feature = "alloc")]
+    pub fn tweak_add_check_batch<V: Verification>(
+        secp: &Secp256k1<V>,
+        items: &[(XOnlyPublicKey, XOnlyPublicKey, Parity, Scalar)],
+    ) -> alloc::vec::Vec<usize> {
+        use alloc::vec::Vec;
+
+        use crate::ffi::types::AlignedType;
+
+        let tweaked: Vec<[u8; 32]> = items.iter().map(|(_, q, _, _)| q.serialize()).collect();
+        let parities: Vec<i32> = items.iter().map(|(_, _, parity, _)| parity.to_i32()).collect();
+        let internal: Vec<ffi::XOnlyPublicKey> = items.iter().map(|(p, _, _, _)| p.0).collect();
+        let tweaks: Vec<[u8; 32]> = items.iter().map(|(_, _, _, t)| t.to_be_bytes()).collect();
+        let ret = unsafe {
+            let size = ffi::secp256k1_xonly_pubkey_tweak_add_check_batch_scratch_size(items.len());
+            let mut scratch = alloc::vec![AlignedType::zeroed(); (size + 15) / 16];
+            ffi::secp256k1_xonly_pubkey_tweak_add_check_batch(
+                secp.ctx.as_ptr(),
+                scratch.as_mut_ptr() as *mut ffi::types::c_void,
+                scratch.len() * 16,
+                tweaked.as_ptr() as *const ffi::types::c_uchar,
+                parities.as_ptr(),
+                internal.as_ptr(),
+                tweaks.as_ptr() as *const ffi::types::c_uchar,
+                items.len(),
+            )
+        };
+        if ret == 1 {
+            return Vec::new();
+        }
+        items
+            .iter()
+            .enumerate()
+            .filter(|(_, (p, q, parity, t))| !p.tweak_add_check(secp, q, *parity, *t))
+            .map(|(i, _)| i)
+            .collect()
+    }
+
     /// Returns the [`PublicKey`] for this [`XOnlyPublicKey`].
     ///
     /// This is equivalent to using [`PublicKey::from_xonly_and_parity(self, parity)`].
@@ -1616,6 +1870,486 @@ impl<'de> serde::Deserialize<'de> for XOnlyPublicKey {
     }
 }
 
+/// A serialized public key borrowed from a larger buffer, such as a transaction.
+///
+/// Only the length and the leading byte are checked on construction. The point itself is parsed,
+/// straight from the borrowed bytes, when the key is used, for instance by
+/// [`Secp256k1::verify_ecdsa_ref`] or [`Secp256k1::verify_schnorr_ref`]. Keys which are only
+/// compared, hashed or copied elsewhere are never parsed.
+///
+/// Compressed (33 bytes), uncompressed (65 bytes) and x-only (32 bytes) keys are accepted.
+#[derive(Copy, Clone, PartialEq, Eq, PartialOrd, Ord, Hash)]
+pub struct PublicKeyBytes<'a>(&'a [u8]);
+
+impl<'a> PublicKeyBytes<'a> {
+    /// Borrows a serialized public key from `data`.
+    ///
+    /// # Errors
+    ///
+    /// Returns [`Error::InvalidPublicKey`] if `data` has neither the length nor the leading byte
+    /// of a serialized key.
+    #[inline]
+    pub fn from_slice(data: &'a [u8]) -> Result<PublicKeyBytes<'a>, Error> {
+        match (data.len(), data.first()) {
+            (constants::SCHNORR_PUBLIC_KEY_SIZE, _)
+            | (constants::PUBLIC_KEY_SIZE, Some(0x02 | 0x03))
+            | (constants::UNCOMPRESSED_PUBLIC_KEY_SIZE, Some(0x04 | 0x06 | 0x07)) => {
+                Ok(PublicKeyBytes(data))
+            }
+            _ => Err(InvalidPublicKey),
+        }
+    }
+
+    /// Returns the borrowed bytes.
+    #[inline]
+    pub fn as_bytes(&self) -> &'a [u8] { self.0 }
+
+    /// Returns whether this is an x-only key.
+    #[inline]
+    pub fn is_x_only(&self) -> bool { self.0.len() == constants::SCHNORR_PUBLIC_KEY_SIZE }
+
+    /// Parses a compressed or uncompressed key.
+    ///
+    /// # Errors
+    ///
+    /// Returns [`Error::InvalidPublicKey`] if this is an x-only key or the bytes do not encode a
+    /// point on the curve.
+    pub fn to_public_key(&self) -> Result<PublicKey, Error> {
+        if self.is_x_only() {
+            return Err(InvalidPublicKey);
+        }
+        unsafe {
+            let mut pk = ffi::PublicKey::new();
+            if ffi::secp256k1_ec_pubkey_parse(
+                ffi::secp256k1_context_no_precomp,
+                &mut pk,
+                self.0.as_c_ptr(),
+                self.0.len(),
+            ) == 1
+            {
+                Ok(PublicKey(pk))
+            } else {
+                Err(InvalidPublicKey)
+            }
+        }
+    }
+
+    /// Parses the key as an x-only key, dropping the parity of compressed and uncompressed keys.
+    ///
+    /// # Errors
+    ///
+    /// Returns [`Error::InvalidPublicKey`] if the bytes do not encode a point on the curve.
+    pub fn to_x_only_public_key(&self) -> Result<XOnlyPublicKey, Error> {
+        if !self.is_x_only() {
+            return self.to_public_key().map(XOnlyPublicKey::from);
+        }
+        unsafe {
+            let mut pk = ffi::XOnlyPublicKey::new();
+            if ffi::secp256k1_xonly_pubkey_parse(
+                ffi::secp256k1_context_no_precomp,
+                &mut pk,
+                self.0.as_c_ptr(),
+            ) == 1
+            {
+                Ok(XOnlyPublicKey(pk))
+            } else {
+                Err(InvalidPublicKey)
+            }
+        }
+    }
+}
+
+impl fmt::Debug for PublicKeyBytes<'_> {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        f.write_str("PublicKeyBytes(")?;
+        for byte in self.0 {
+            write!(f, "{:02x}", byte)?;
+        }
+        f.write_str(")")
+    }
+}
+
+/// The number of key pairs checked together by [`Keypair::from_keys_batch`].
+#[cfg(feature = "alloc")]
+const KEYPAIR_IMPORT_CHUNK: usize = 4096;
+
+/// The number of keys which arena iterators decompress at once.
+#[cfg(feature = "alloc")]
+const ARENA_CHUNK: usize = 64;
+
+/// Compact storage for many public keys.
+///
+/// A [`PublicKey`] holds its point in 64 bytes. The arena stores the 32-byte x coordinate of every
+/// key and the parity of its y coordinate in a separate bitmap, so it needs about half the memory
+/// of a `Vec<PublicKey>`. Keys are decompressed, which costs one square root each, when they are
+/// read. [`PublicKeyArena::get_range`] and the iterator decompress many keys per call into the
+/// C library.
+///
+/// ```
+/// use secp256k1::{PublicKeyArena, Secp256k1, SecretKey};
+///
+/// let secp = Secp256k1::new();
+/// let keys: Vec<_> =
+///     (1..=10u8).map(|i| SecretKey::from_slice(&[i; 32]).unwrap().public_key(&secp)).collect();
+/// let arena: PublicKeyArena = keys.iter().copied().collect();
+///
+/// assert_eq!(arena.get(3), Some(keys[3]));
+/// assert_eq!(arena.get_range(2..5), &keys[2..5]);
+/// assert!(arena.iter().eq(keys.iter().copied()));
+/// ```
+#[cfg(feature = "alloc")]
+#[derive(Clone, Default, PartialEq, Eq, Hash)]
+pub struct PublicKeyArena {
+    x: alloc::vec::Vec<[u8; 32]>,
+    odd: alloc::vec::Vec<u8>,
+}
+
+#[cfg(feature = "alloc")]
+impl PublicKeyArena {
+    /// Creates an empty arena.
+    #[inline]
+    pub fn new() -> PublicKeyArena { PublicKeyArena::default() }
+
+    /// Creates an empty arena with room for `n` keys.
+    #[inline]
+    pub fn with_capacity(n: usize) -> PublicKeyArena {
+        PublicKeyArena {
+            x: alloc::vec::Vec::with_capacity(n),
+            odd: alloc::vec::Vec::with_capacity((n + 7) / 8),
+        }
+    }
+
+    /// Returns the number of keys.
+    #[inline]
+    pub fn len(&self) -> usize { self.x.len() }
+
+    /// Returns whether the arena holds no keys.
+    #[inline]
+    pub fn is_empty(&self) -> bool { self.x.is_empty() }
+
+    /// Appends a key.
+    pub fn push(&mut self, pk: PublicKey) {
+        let ser = pk.serialize();
+        let i = self.x.len();
+        if i % 8 == 0 {
+            self.odd.push(0);
+        }
+        self.odd[i / 8] |= (ser[0] & 1) << (i % 8);
+        self.x.push(ser[1..].try_into().expect("33-byte serialization"));
+    }
+
+    /// Returns the x coordinate of the `i`-th key, without decompressing it.
+    #[inline]
+    pub fn x_coordinate(&self, i: usize) -> Option<&[u8; 32]> { self.x.get(i) }
+
+    /// Returns the compressed serialization of the `i`-th key, without decompressing it.
+    pub fn serialize(&self, i: usize) -> Option<[u8; constants::PUBLIC_KEY_SIZE]> {
+        let x = self.x.get(i)?;
+        let mut ser = [0; constants::PUBLIC_KEY_SIZE];
+        ser[0] = 0x02 | ((self.odd[i / 8] >> (i % 8)) & 1);
+        ser[1..].copy_from_slice(x);
+        Some(ser)
+    }
+
+    /// Returns the `i`-th key.
+    pub fn get(&self, i: usize) -> Option<PublicKey> {
+        if i >= self.len() {
+            return None;
+        }
+        let mut pk = unsafe { ffi::PublicKey::new() };
+        self.decompress(i, core::slice::from_mut(&mut pk));
+        Some(PublicKey(pk))
+    }
+
+    /// Returns the keys in `range`.
+    ///
+    /// # Panics
+    ///
+    /// If `range` is out of bounds.
+    pub fn get_range(&self, range: ops::Range<usize>) -> alloc::vec::Vec<PublicKey> {
+        let mut pks = alloc::vec![unsafe { ffi::PublicKey::new() }; range.len()];
+        self.decompress(range.start, &mut pks);
+        pks.into_iter().map(PublicKey).collect()
+    }
+
+    /// Returns an iterator over the keys.
+    #[inline]
+    pub fn iter(&self) -> PublicKeyArenaIter<'_> {
+        PublicKeyArenaIter {
+            arena: self,
+            next: 0,
+            buf: [unsafe { ffi::PublicKey::new() }; ARENA_CHUNK],
+            buf_start: 0,
+            buf_len: 0,
+        }
+    }
+
+    /// Decompresses the keys from index `start` on into `out`.
+    fn decompress(&self, start: usize, out: &mut [ffi::PublicKey]) {
+        let x = &self.x[start..start + out.len()];
+        #[cfg(not(secp256k1_fuzz))]
+        unsafe {
+            let ret = ffi::secp256k1_ec_pubkey_decompress_batch(
+                ffi::secp256k1_context_no_precomp,
+                out.as_mut_ptr(),
+                x.as_ptr() as *const ffi::types::c_uchar,
+                self.odd.as_ptr(),
+                start,
+                out.len(),
+            );
+            debug_assert_eq!(ret, 1);
+        }
+        #[cfg(secp256k1_fuzz)]
+        for (i, pk) in out.iter_mut().enumerate() {
+            let ser = self.serialize(start + i).expect("in bounds");
+            *pk = PublicKey::from_byte_array_compressed(ser).expect("stored keys are valid").0;
+            debug_assert_eq!(&ser[1..], &x[i][..]);
+        }
+    }
+}
+
+#[cfg(feature = "alloc")]
+impl Extend<PublicKey> for PublicKeyArena {
+    fn extend<I: IntoIterator<Item = PublicKey>>(&mut self, iter: I) {
+        iter.into_iter().for_each(|pk| self.push(pk))
+    }
+}
+
+#[cfg(feature = "alloc")]
+impl core::iter::FromIterator<PublicKey> for PublicKeyArena {
+    fn from_iter<I: IntoIterator<Item = PublicKey>>(iter: I) -> Self {
+        let mut arena = PublicKeyArena::new();
+        arena.extend(iter);
+        arena
+    }
+}
+
+#[cfg(feature = "alloc")]
+impl<'a> IntoIterator for &'a PublicKeyArena {
+    type Item = PublicKey;
+    type IntoIter = PublicKeyArenaIter<'a>;
+
+    fn into_iter(self) -> Self::IntoIter { self.iter() }
+}
+
+#[cfg(feature = "alloc")]
+impl fmt::Debug for PublicKeyArena {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        f.debug_struct("PublicKeyArena").field("len", &self.len()).finish()
+    }
+}
+
+/// An iterator over the keys of a [`PublicKeyArena`], decompressing them in chunks.
+#[cfg(feature = "alloc")]
+pub struct PublicKeyArenaIter<'a> {
+    arena: &'a PublicKeyArena,
+    next: usize,
+    buf: [ffi::PublicKey; ARENA_CHUNK],
+    buf_start: usize,
+    buf_len: usize,
+}
+
+#[cfg(feature = "alloc")]
+impl Iterator for PublicKeyArenaIter<'_> {
+    type Item = PublicKey;
+
+    fn next(&mut self) -> Option<PublicKey> {
+        if self.next >= self.arena.len() {
+            return None;
+        }
+        if self.next >= self.buf_start + self.buf_len {
+            self.buf_start = self.next;
+            self.buf_len = ARENA_CHUNK.min(self.arena.len() - self.next);
+            self.arena.decompress(self.buf_start, &mut self.buf[..self.buf_len]);
+        }
+        let pk = PublicKey(self.buf[self.next - self.buf_start]);
+        self.next += 1;
+        Some(pk)
+    }
+
+    fn size_hint(&self) -> (usize, Option<usize>) {
+        let n = self.arena.len() - self.next;
+        (n, Some(n))
+    }
+}
+
+#[cfg(feature = "alloc")]
+impl ExactSizeIterator for PublicKeyArenaIter<'_> {}
+
+#[cfg(feature = "alloc")]
+impl fmt::Debug for PublicKeyArenaIter<'_> {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        f.debug_struct("PublicKeyArenaIter").field("next", &self.next).finish()
+    }
+}
+
+/// Compact storage for many x-only public keys.
+///
+/// Like [`PublicKeyArena`], but stores only the 32-byte x coordinates.
+#[cfg(feature = "alloc")]
+#[derive(Clone, Default, PartialEq, Eq, Hash)]
+pub struct XOnlyPublicKeyArena {
+    x: alloc::vec::Vec<[u8; 32]>,
+}
+
+#[cfg(feature = "alloc")]
+impl XOnlyPublicKeyArena {
+    /// Creates an empty arena.
+    #[inline]
+    pub fn new() -> XOnlyPublicKeyArena { XOnlyPublicKeyArena::default() }
+
+    /// Creates an empty arena with room for `n` keys.
+    #[inline]
+    pub fn with_capacity(n: usize) -> XOnlyPublicKeyArena {
+        XOnlyPublicKeyArena { x: alloc::vec::Vec::with_capacity(n) }
+    }
+
+    /// Returns the number of keys.
+    #[inline]
+    pub fn len(&self) -> usize { self.x.len() }
+
+    /// Returns whether the arena holds no keys.
+    #[inline]
+    pub fn is_empty(&self) -> bool { self.x.is_empty() }
+
+    /// Appends a key.
+    #[inline]
+    pub fn push(&mut self, pk: XOnlyPublicKey) { self.x.push(pk.serialize()) }
+
+    /// Returns the serialization of the `i`-th key, without decompressing it.
+    #[inline]
+    pub fn serialize(&self, i: usize) -> Option<&[u8; constants::SCHNORR_PUBLIC_KEY_SIZE]> {
+        self.x.get(i)
+    }
+
+    /// Returns the `i`-th key.
+    pub fn get(&self, i: usize) -> Option<XOnlyPublicKey> {
+        if i >= self.len() {
+            return None;
+        }
+        let mut pk = unsafe { ffi::XOnlyPublicKey::new() };
+        self.decompress(i, core::slice::from_mut(&mut pk));
+        Some(XOnlyPublicKey(pk))
+    }
+
+    /// Returns the keys in `range`.
+    ///
+    /// # Panics
+    ///
+    /// If `range` is out of bounds.
+    pub fn get_range(&self, range: ops::Range<usize>) -> alloc::vec::Vec<XOnlyPublicKey> {
+        let mut pks = alloc::vec![unsafe { ffi::XOnlyPublicKey::new() }; range.len()];
+        self.decompress(range.start, &mut pks);
+        pks.into_iter().map(XOnlyPublicKey).collect()
+    }
+
+    /// Returns an iterator over the keys.
+    #[inline]
+    pub fn iter(&self) -> XOnlyPublicKeyArenaIter<'_> {
+        XOnlyPublicKeyArenaIter {
+            arena: self,
+            next: 0,
+            buf: [unsafe { ffi::XOnlyPublicKey::new() }; ARENA_CHUNK],
+            buf_start: 0,
+            buf_len: 0,
+        }
+    }
+
+    /// Decompresses the keys from index `start` on into `out`.
+    fn decompress(&self, start: usize, out: &mut [ffi::XOnlyPublicKey]) {
+        let x = &self.x[start..start + out.len()];
+        #[cfg(not(secp256k1_fuzz))]
+        unsafe {
+            let ret = ffi::secp256k1_xonly_pubkey_parse_batch(
+                ffi::secp256k1_context_no_precomp,
+                out.as_mut_ptr(),
+                x.as_ptr() as *const ffi::types::c_uchar,
+                out.len(),
+            );
+            debug_assert_eq!(ret, 1);
+        }
+        #[cfg(secp256k1_fuzz)]
+        for (pk, x) in out.iter_mut().zip(x) {
+            *pk = XOnlyPublicKey::from_byte_array(*x).expect("stored keys are valid").0;
+        }
+    }
+}
+
+#[cfg(feature = "alloc")]
+impl Extend<XOnlyPublicKey> for XOnlyPublicKeyArena {
+    fn extend<I: IntoIterator<Item = XOnlyPublicKey>>(&mut self, iter: I) {
+        self.x.extend(iter.into_iter().map(|pk| pk.serialize()))
+    }
+}
+
+#[cfg(feature = "alloc")]
+impl core::iter::FromIterator<XOnlyPublicKey> for XOnlyPublicKeyArena {
+    fn from_iter<I: IntoIterator<Item = XOnlyPublicKey>>(iter: I) -> Self {
+        let mut arena = XOnlyPublicKeyArena::new();
+        arena.extend(iter);
+        arena
+    }
+}
+
+#[cfg(feature = "alloc")]
+impl<'a> IntoIterator for &'a XOnlyPublicKeyArena {
+    type Item = XOnlyPublicKey;
+    type IntoIter = XOnlyPublicKeyArenaIter<'a>;
+
+    fn into_iter(self) -> Self::IntoIter { self.iter() }
+}
+
+#[cfg(feature = "alloc")]
+impl fmt::Debug for XOnlyPublicKeyArena {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        f.debug_struct("XOnlyPublicKeyArena").field("len", &self.len()).finish()
+    }
+}
+
+/// An iterator over the keys of an [`XOnlyPublicKeyArena`], decompressing them in chunks.
+#[cfg(feature = "alloc")]
+pub struct XOnlyPublicKeyArenaIter<'a> {
+    arena: &'a XOnlyPublicKeyArena,
+    next: usize,
+    buf: [ffi::XOnlyPublicKey; ARENA_CHUNK],
+    buf_start: usize,
+    buf_len: usize,
+}
+
+#[cfg(feature = "alloc")]
+impl Iterator for XOnlyPublicKeyArenaIter<'_> {
+    type Item = XOnlyPublicKey;
+
+    fn next(&mut self) -> Option<XOnlyPublicKey> {
+        if self.next >= self.arena.len() {
+            return None;
+        }
+        if self.next >= self.buf_start + self.buf_len {
+            self.buf_start = self.next;
+            self.buf_len = ARENA_CHUNK.min(self.arena.len() - self.next);
+            self.arena.decompress(self.buf_start, &mut self.buf[..self.buf_len]);
+        }
+        let pk = XOnlyPublicKey(self.buf[self.next - self.buf_start]);
+        self.next += 1;
+        Some(pk)
+    }
+
+    fn size_hint(&self) -> (usize, Option<usize>) {
+        let n = self.arena.len() - self.next;
+        (n, Some(n))
+    }
+}
+
+#[cfg(feature = "alloc")]
+impl ExactSizeIterator for XOnlyPublicKeyArenaIter<'_> {}
+
+#[cfg(feature = "alloc")]
+impl fmt::Debug for XOnlyPublicKeyArenaIter<'_> {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        f.debug_struct("XOnlyPublicKeyArenaIter").field("next", &self.next).finish()
+    }
+}
+
 #[cfg(test)]
 #[allow(unused_imports)]
 mod test {
@@ -2248,6 +2982,177 @@ mod test {
         }
     }
 
+    #[test]
+    #[cfg(all(feature = "alloc", not(secp256k1_fuzz)))]
+    fn test_sort_slice() {
+        let s = Secp256k1::new();
+
+        // The last 40 keys are equal, so their bucket is sorted with hsort.
+        let mut keys: Vec<PublicKey> = (0..3000u32)
+            .map(|i| {
+                let mut sk = [1; 32];
+                sk[..4].copy_from_slice(&(i.min(2960) + 1).to_be_bytes());
+                SecretKey::from_slice(&sk).unwrap().public_key(&s)
+            })
+            .collect();
+        let mut want = keys.clone();
+        want.sort();
+        PublicKey::sort_slice(&mut keys);
+        assert!(keys.iter().zip(&want).all(|(a, b)| a.serialize() == b.serialize()));
+
+        for n in [0, 1, 2, 17] {
+            let mut keys = want[..n].to_vec();
+            keys.reverse();
+            PublicKey::sort_slice(&mut keys);
+            assert_eq!(keys, want[..n]);
+        }
+    }
+
+    #[test]
+    #[cfg(all(feature = "alloc", not(secp256k1_fuzz)))]
+    fn test_keypair_from_keys_batch() {
+        let s = Secp256k1::new();
+
+        // More than one chunk, with a bad key in the second.
+        let mut items: Vec<(SecretKey, PublicKey)> = (0..KEYPAIR_IMPORT_CHUNK as u32 + 100)
+            .map(|i| {
+                let mut sk = [7; 32];
+                sk[..4].copy_from_slice(&i.to_be_bytes());
+                let sk = SecretKey::from_slice(&sk).unwrap();
+                (sk, sk.public_key(&s))
+            })
+            .collect();
+        let bad = KEYPAIR_IMPORT_CHUNK + 42;
+        items[bad].1 = items[bad].1.negate(&s);
+
+        let keypairs = Keypair::from_keys_batch(&s, &items);
+        assert_eq!(keypairs.len(), items.len());
+        for (i, ((sk, _), kp)) in items.iter().zip(&keypairs).enumerate() {
+            if i == bad {
+                assert_eq!(*kp, Err(InvalidPublicKey));
+            } else {
+                assert_eq!(*kp, Ok(Keypair::from_secret_key(&s, sk)));
+            }
+        }
+        assert!(Keypair::from_keys_batch(&s, &[]).is_empty());
+    }
+
+    #[test]
+    #[cfg(all(feature = "alloc", not(secp256k1_fuzz)))]
+    fn test_arena() {
+        let s = Secp256k1::new();
+
+        // More than two chunks, with both parities.
+        let keys: Vec<PublicKey> = (1..=150u8)
+            .map(|i| SecretKey::from_slice(&[i; 32]).unwrap().public_key(&s))
+            .collect();
+        assert!(keys.iter().any(|pk| pk.serialize()[0] == 2));
+        assert!(keys.iter().any(|pk| pk.serialize()[0] == 3));
+
+        let arena: PublicKeyArena = keys.iter().copied().collect();
+        assert_eq!(arena.len(), keys.len());
+        assert_eq!(arena.x.len() * 32 + arena.odd.len(), 150 * 32 + 19);
+        for (i, pk) in keys.iter().enumerate() {
+            assert_eq!(arena.get(i), Some(*pk));
+            assert_eq!(arena.serialize(i), Some(pk.serialize()));
+        }
+        assert_eq!(arena.get(150), None);
+        assert_eq!(arena.serialize(150), None);
+        assert_eq!(arena.get_range(60..130), &keys[60..130]);
+        assert!(arena.get_range(7..7).is_empty());
+        assert_eq!(arena.iter().len(), 150);
+        assert!(arena.iter().eq(keys.iter().copied()));
+        assert_eq!(arena.iter().skip(64).next(), Some(keys[64]));
+
+        let xonly: Vec<XOnlyPublicKey> = keys.iter().map(|pk| pk.x_only_public_key().0).collect();
+        let arena: XOnlyPublicKeyArena = xonly.iter().copied().collect();
+        for (i, pk) in xonly.iter().enumerate() {
+            assert_eq!(arena.get(i), Some(*pk));
+        }
+        assert_eq!(arena.get(150), None);
+        assert_eq!(arena.get_range(0..150), xonly);
+        assert!((&arena).into_iter().eq(xonly.iter().copied()));
+        assert!(XOnlyPublicKeyArena::new().iter().next().is_none());
+    }
+
+    #[test]
+    #[cfg(all(feature = "alloc", not(secp256k1_fuzz)))]
+    fn test_add_tweak_batch() {
+        let s = Secp256k1::new();
+
+        let items: Vec<_> = (1..=40u8)
+            .map(|i| {
+                let kp = Keypair::from_seckey_slice(&s, &[i; 32]).unwrap();
+                (kp.x_only_public_key().0, Scalar::from_be_bytes([0x80 ^ i; 32]).unwrap())
+            })
+            .collect();
+        let batch = XOnlyPublicKey::add_tweak_batch(&s, &items);
+        assert_eq!(batch.len(), items.len());
+        for ((pk, tweak), tweaked) in items.iter().zip(&batch) {
+            assert_eq!(*tweaked, pk.add_tweak(&s, tweak));
+        }
+        assert!(XOnlyPublicKey::add_tweak_batch(&s, &[]).is_empty());
+
+        // A tweak which cancels the key.
+        let sk = SecretKey::from_slice(&[3; 32]).unwrap();
+        let (pk, parity) = sk.x_only_public_key(&s);
+        let neg = if parity == Parity::Even { sk.negate() } else { sk };
+        let batch = XOnlyPublicKey::add_tweak_batch(&s, &[items[0], (pk, neg.into()), items[1]]);
+        assert_eq!(batch[0], items[0].0.add_tweak(&s, &items[0].1));
+        assert_eq!(batch[1], Err(Error::InvalidTweak));
+        assert_eq!(batch[2], items[1].0.add_tweak(&s, &items[1].1));
+
+        // Test vectors from BIP341, with and without a script tree.
+        let internal = [
+            XOnlyPublicKey::from_str(
+                "d6889cb081036e0faefa3a35157ad71086b123b2b144b649798b494c300a961d",
+            )
+            .unwrap(),
+            XOnlyPublicKey::from_str(
+                "187791b6f712a8ea41c8ecdd0ee77fab3e85263b37e1ec18a3651926b3a6cf27",
+            )
+            .unwrap(),
+        ];
+        let output = XOnlyPublicKey::taproot_output_key_batch(&s, &internal[..1], None);
+        assert_eq!(
+            output[0].unwrap().0.to_string(),
+            "53a1f6e454df1aa2776a2814a721372d6258050de330b3c6d10ee8f4e0dda343"
+        );
+        let roots =
+            [[0; 32], hex!("5b75adecf53548f3ec6ad7d78383bf84cc57b55a3127c72b9a2481752dd88b21")];
+        let output = XOnlyPublicKey::taproot_output_key_batch(&s, &internal, Some(&roots));
+        assert_eq!(
+            output[1].unwrap().0.to_string(),
+            "147c9c57132f6e7ecddba9800bb0c4449251c92a1e60371ee77557b6620f3ea3"
+        );
+    }
+
+    #[test]
+    #[cfg(all(feature = "alloc", not(secp256k1_fuzz)))]
+    fn test_tweak_add_check_batch() {
+        let s = Secp256k1::new();
+
+        let mut items: Vec<_> = (1..=100u8)
+            .map(|i| {
+                let kp = Keypair::from_seckey_slice(&s, &[i; 32]).unwrap();
+                let (xonly, _) = XOnlyPublicKey::from_keypair(&kp);
+                let tweak = Scalar::from_be_bytes([0x80 ^ i; 32]).unwrap();
+                let (tweaked, parity) = xonly.add_tweak(&s, &tweak).unwrap();
+                (xonly, tweaked, parity, tweak)
+            })
+            .collect();
+
+        // Small batches use Strauss' algorithm, large ones Pippenger's.
+        for n in [0, 1, 2, 10, 100] {
+            assert!(XOnlyPublicKey::tweak_add_check_batch(&s, &items[..n]).is_empty());
+        }
+        items[5].2 = items[5].2 ^ Parity::Odd;
+        items[42].3 = items[43].3;
+        items[99].1 = items[99].0;
+        assert_eq!(XOnlyPublicKey::tweak_add_check_batch(&s, &items), [5, 42, 99]);
+        assert_eq!(XOnlyPublicKey::tweak_add_check_batch(&s, &items[6..42]), []);
+    }
+
     #[test]
     fn test_from_key_pubkey() {
         let kpk1 = PublicKey::from_str(
@@ -131,8 +131,14 @@
 //! * `rand` - use `rand` library to provide random generator (e.g. to generate keys).
 //! * `hashes` - use the `hashes` library.
 //! * `recovery` - enable functions that can compute the public key from signature.
-//! * `lowmemory` - optimize the library for low-memory environments.
+//! * `lowmemory` - optimize the library for low-memory environments (see also
+//!   `RUST_SECP_ECMULT_WINDOW_SIZE` in the README).
 //! * `global-context` - enable use of global secp256k1 context (implies `std`).
+//! * `instrumentation` - count calls to expensive internal operations, see the [`stats`] module.
+//! * `instrumentation-cycles` - additionally measure the CPU cycles spent in them (x86 only).
+//! * `ecmult-tune` - export the entry points needed by the `ecmult_tune` benchmark.
+//! * `rayon` - bulk signing, verification and key generation on the `rayon` thread pool, see
+//!   the [`parallel`] module (implies `std`).
 //! * `serde` - implements serialization and deserialization for types in this crate using `serde`.
 //!           **Important**: `serde` encoding is **not** the same as consensus encoding!
 //!
@@ -161,13 +167,30 @@ mod macros;
 mod secret;
 mod context;
 mod key;
+#[cfg(all(feature = "std", feature = "rand"))]
+mod presign;
 
 pub mod constants;
 pub mod ecdh;
 pub mod ecdsa;
 pub mod ellswift;
+pub mod hd;
 pub mod scalar;
 pub mod schnorr;
+#[cfg(feature = "alloc")]
+pub mod fixed_base;
+#[cfg(feature = "rayon")]
+pub mod parallel;
+#[cfg(feature = "std")]
+pub mod pubkey_cache;
+#[cfg(feature = "std")]
+pub mod silentpayments;
+#[cfg(feature = "instrumentation")]
+pub mod stats;
+#[cfg(feature = "std")]
+pub mod tables;
+#[cfg(feature = "std")]
+pub mod verify_service;
 #[cfg(feature = "serde")]
 mod serde_util;
 
@@ -191,7 +214,13 @@ pub use crate::context::{
 };
 use crate::ffi::types::AlignedType;
 use crate::ffi::CPtr;
-pub use crate::key::{InvalidParityValue, Keypair, Parity, PublicKey, SecretKey, XOnlyPublicKey};
+pub use crate::key::{
+    InvalidParityValue, Keypair, Parity, PublicKey, PublicKeyBytes, SecretKey, XOnlyPublicKey,
+};
+#[cfg(feature = "alloc")]
+pub use crate::key::{
+    PublicKeyArena, PublicKeyArenaIter, XOnlyPublicKeyArena, XOnlyPublicKeyArenaIter,
+};
 pub use crate::scalar::Scalar;
 
 /// Trait describing something that promises to be a 32-byte uniformly random number.
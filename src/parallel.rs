@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: CC0-1.0
+
+//! Bulk operations spread over the [`rayon`] thread pool.
+//!
+//! The inputs are split into chunks which are processed by the threads of the current rayon
+//! pool. Each rayon task works with its own copy of the context, so that threads do not share the
+//! cache lines of one context, and the results come back in input order.
+//!
+//! ```
+//! # #[cfg(feature = "rand")] {
+//! use secp256k1::{Message, Secp256k1};
+//!
+//! let secp = Secp256k1::new();
+//! let keys = secp.par_generate_keypairs(100);
+//! let items: Vec<_> = keys.iter().map(|(sk, _)| (Message::from_digest([1; 32]), *sk)).collect();
+//! let sigs = secp.par_sign_ecdsa(&items);
+//!
+//! let mut checks: Vec<_> = sigs
+//!     .iter()
+//!     .zip(&keys)
+//!     .map(|(sig, (_, pk))| (Message::from_digest([1; 32]), *sig, *pk))
+//!     .collect();
+//! checks[42].0 = Message::from_digest([2; 32]);
+//! assert_eq!(secp.par_verify_ecdsa(&checks), vec![42]);
+//! # }
+//! ```
+
+use std::vec::Vec;
+
+use rayon::prelude::*;
+
+use crate::key::{Keypair, PublicKey, SecretKey, XOnlyPublicKey};
+use crate::{ecdsa, schnorr, Message, Secp256k1, Signing, Verification};
+
+/// The largest number of items processed by one rayon task.
+const MAX_CHUNK: usize = 64;
+
+/// Returns the chunk size for `len` items: small enough that every thread of the pool gets a few
+/// chunks, but not so small that cloning the context shows.
+fn chunk_size(len: usize) -> usize {
+    (len / (rayon::current_num_threads() * 4)).clamp(1, MAX_CHUNK)
+}
+
+impl<C: Verification> Secp256k1<C> {
+    /// Verifies ECDSA signatures in parallel, see [`Secp256k1::verify_ecdsa`].
+    ///
+    /// Returns the indices into `items` of the signatures which do not verify, in increasing
+    /// order; the result is empty if all of them do.
+    pub fn par_verify_ecdsa(&self, items: &[(Message, ecdsa::Signature, PublicKey)]) -> Vec<usize> {
+        self.par_failures(
+            items,
+            |_, _| false,
+            |secp, (msg, sig, pk)| secp.verify_ecdsa(*msg, sig, pk).is_ok(),
+        )
+    }
+
+    /// Verifies schnorr signatures in parallel, see [`Secp256k1::verify_schnorr`].
+    ///
+    /// Each chunk is first checked with [`Secp256k1::verify_schnorr_batch`], and only verified
+    /// signature by signature if that fails.
+    ///
+    /// Returns the indices into `items` of the signatures which do not verify, in increasing
+    /// order; the result is empty if all of them do.
+    pub fn par_verify_schnorr(
+        &self,
+        items: &[(schnorr::Signature, &[u8], XOnlyPublicKey)],
+    ) -> Vec<usize> {
+        self.par_failures(
+            items,
+            |secp, chunk| secp.verify_schnorr_batch(chunk).is_ok(),
+            |secp, (sig, msg, pk)| secp.verify_schnorr(sig, msg, pk).is_ok(),
+        )
+    }
+
+    /// Returns the indices of the items for which `check` fails, skipping the chunks for which
+    /// `check_all` succeeds.
+    fn par_failures<T, A, F>(&self, items: &[T], check_all: A, check: F) -> Vec<usize>
+    where
+        T: Sync,
+        A: Fn(&Secp256k1<C>, &[T]) -> bool + Sync + Send,
+        F: Fn(&Secp256k1<C>, &T) -> bool + Sync + Send,
+    {
+        let size = chunk_size(items.len());
+        items
+            .par_chunks(size)
+            .enumerate()
+            .map_init(
+                || self.clone(),
+                |secp, (i, chunk)| {
+                    if check_all(secp, chunk) {
+                        return Vec::new();
+                    }
+                    chunk
+                        .iter()
+                        .enumerate()
+                        .filter(|(_, item)| !check(secp, item))
+                        .map(|(j, _)| i * size + j)
+                        .collect::<Vec<_>>()
+                },
+            )
+            .flat_map_iter(|failures| failures)
+            .collect()
+    }
+}
+
+impl<C: Signing> Secp256k1<C> {
+    /// Creates ECDSA signatures in parallel, see [`Secp256k1::sign_ecdsa`].
+    pub fn par_sign_ecdsa(&self, items: &[(Message, SecretKey)]) -> Vec<ecdsa::Signature> {
+        self.par_map(items, |secp, (msg, sk)| secp.sign_ecdsa(*msg, sk))
+    }
+
+    /// Creates schnorr signatures in parallel without auxiliary random data, see
+    /// [`Secp256k1::sign_schnorr_no_aux_rand`].
+    pub fn par_sign_schnorr_no_aux_rand(
+        &self,
+        items: &[(&[u8], Keypair)],
+    ) -> Vec<schnorr::Signature> {
+        self.par_map(items, |secp, (msg, keypair)| secp.sign_schnorr_no_aux_rand(msg, keypair))
+    }
+
+    /// Creates schnorr signatures in parallel, drawing the auxiliary random data of each from the
+    /// thread's [`rand::rngs::ThreadRng`], see [`Secp256k1::sign_schnorr`].
+    #[cfg(feature = "rand")]
+    pub fn par_sign_schnorr(&self, items: &[(&[u8], Keypair)]) -> Vec<schnorr::Signature> {
+        self.par_map(items, |secp, (msg, keypair)| {
+            secp.sign_schnorr_with_rng(msg, keypair, &mut rand::thread_rng())
+        })
+    }
+
+    /// Generates `n` key pairs in parallel using each thread's [`rand::rngs::ThreadRng`], see
+    /// [`Secp256k1::generate_keypair`].
+    #[cfg(feature = "rand")]
+    pub fn par_generate_keypairs(&self, n: usize) -> Vec<(SecretKey, PublicKey)> {
+        (0..n)
+            .into_par_iter()
+            .with_min_len(chunk_size(n))
+            .map_init(
+                || (self.clone(), rand::thread_rng()),
+                |(secp, rng), _| secp.generate_keypair(rng),
+            )
+            .collect()
+    }
+
+    /// Applies `f` to every item, in parallel, and returns the results in order.
+    fn par_map<T, R, F>(&self, items: &[T], f: F) -> Vec<R>
+    where
+        T: Sync,
+        R: Send,
+        F: Fn(&Secp256k1<C>, &T) -> R + Sync + Send,
+    {
+        items
+            .par_chunks(chunk_size(items.len()))
+            .map_init(
+                || self.clone(),
+                |secp, chunk| chunk.iter().map(|item| f(secp, item)).collect::<Vec<_>>(),
+            )
+            .flat_map_iter(|results| results)
+            .collect()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn parallel_matches_sequential() {
+        let secp = Secp256k1::new();
+        let keys: Vec<SecretKey> =
+            (1..=150u8).map(|i| SecretKey::from_slice(&[i; 32]).unwrap()).collect();
+        let msgs: Vec<[u8; 32]> = (0..150u8).map(|i| [i; 32]).collect();
+
+        let items: Vec<_> =
+            keys.iter().zip(&msgs).map(|(sk, msg)| (Message::from_digest(*msg), *sk)).collect();
+        let sigs = secp.par_sign_ecdsa(&items);
+        for ((msg, sk), sig) in items.iter().zip(&sigs) {
+            assert_eq!(*sig, secp.sign_ecdsa(*msg, sk));
+        }
+        let mut checks: Vec<_> = items
+            .iter()
+            .zip(&sigs)
+            .map(|((msg, sk), sig)| (*msg, *sig, sk.public_key(&secp)))
+            .collect();
+        assert!(secp.par_verify_ecdsa(&checks).is_empty());
+        checks[0].0 = Message::from_digest([0xff; 32]);
+        checks[77].2 = checks[78].2;
+        checks[149].1 = checks[148].1;
+        assert_eq!(secp.par_verify_ecdsa(&checks), [0, 77, 149]);
+
+        let keypairs: Vec<_> = keys.iter().map(|sk| Keypair::from_secret_key(&secp, sk)).collect();
+        let items: Vec<_> = msgs.iter().map(|m| &m[..]).zip(keypairs.iter().copied()).collect();
+        let sigs = secp.par_sign_schnorr_no_aux_rand(&items);
+        let mut checks: Vec<_> = items
+            .iter()
+            .zip(&sigs)
+            .map(|((msg, keypair), sig)| (*sig, *msg, keypair.x_only_public_key().0))
+            .collect();
+        assert!(secp.par_verify_schnorr(&checks).is_empty());
+        checks[3].1 = &msgs[4];
+        assert_eq!(secp.par_verify_schnorr(&checks), [3]);
+        assert!(secp.par_verify_schnorr(&[]).is_empty());
+    }
+}
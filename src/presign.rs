@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: CC0-1.0
+
+//! The pool behind [`ecdsa::PresignaturePool`] and [`schnorr::PresignaturePool`].
+//!
+//! [`ecdsa::PresignaturePool`]: crate::ecdsa::PresignaturePool
+//! [`schnorr::PresignaturePool`]: crate::schnorr::PresignaturePool
+
+use std::mem;
+use std::sync::{Arc, Condvar, Mutex, MutexGuard};
+use std::thread::{self, JoinHandle};
+use std::vec::Vec;
+
+use rand::{CryptoRng, Rng};
+
+use crate::{Secp256k1, Signing};
+
+/// A precomputed nonce, which erases itself when dropped.
+pub(crate) trait Presign: Send + 'static {
+    /// Creates a presignature for a nonce drawn from `rng`.
+    fn create<C: Signing, R: Rng + CryptoRng + ?Sized>(secp: &Secp256k1<C>, rng: &mut R) -> Self;
+
+    /// Returns an all-zero presignature, which the sign functions reject.
+    fn zeroed() -> Self;
+}
+
+struct State<P> {
+    presigs: Vec<P>,
+    capacity: usize,
+    low_water: usize,
+    shutdown: bool,
+}
+
+struct Shared<P> {
+    state: Mutex<State<P>>,
+    cond: Condvar,
+}
+
+/// Locks `mutex`, ignoring poisoning: no code that panics while holding the lock leaves the pool
+/// inconsistent.
+fn lock<T>(mutex: &Mutex<T>) -> MutexGuard<'_, T> {
+    mutex.lock().unwrap_or_else(|e| e.into_inner())
+}
+
+/// A pool of single-use presignatures, optionally refilled by a background thread.
+pub(crate) struct Pool<P> {
+    shared: Arc<Shared<P>>,
+    worker: Option<JoinHandle<()>>,
+}
+
+impl<P: Presign> Pool<P> {
+    pub(crate) fn new(capacity: usize) -> Pool<P> {
+        Pool {
+            shared: Arc::new(Shared {
+                // Allocated up front, so that presignatures are never left behind by a
+                // reallocation.
+                state: Mutex::new(State {
+                    presigs: Vec::with_capacity(capacity),
+                    capacity,
+                    low_water: 0,
+                    shutdown: false,
+                }),
+                cond: Condvar::new(),
+            }),
+            worker: None,
+        }
+    }
+
+    pub(crate) fn with_refill(capacity: usize, low_water: usize) -> Pool<P> {
+        assert!(low_water <= capacity, "low_water must not exceed capacity");
+        let mut pool = Pool::new(capacity);
+        lock(&pool.shared.state).low_water = low_water;
+        let shared = Arc::clone(&pool.shared);
+        pool.worker = Some(
+            thread::Builder::new()
+                .name("secp256k1-presign".into())
+                .spawn(move || refill(&shared))
+                .expect("failed to spawn the presignature worker"),
+        );
+        pool
+    }
+
+    pub(crate) fn len(&self) -> usize { lock(&self.shared.state).presigs.len() }
+
+    /// Fills the pool up to its capacity, computing the presignatures without holding the lock.
+    pub(crate) fn fill<C: Signing, R: Rng + CryptoRng + ?Sized>(
+        &self,
+        secp: &Secp256k1<C>,
+        rng: &mut R,
+    ) {
+        let missing = {
+            let state = lock(&self.shared.state);
+            state.capacity - state.presigs.len()
+        };
+        let mut presigs: Vec<P> = (0..missing).map(|_| P::create(secp, rng)).collect();
+        let mut state = lock(&self.shared.state);
+        let room = state.capacity - state.presigs.len();
+        // Move the presignatures out one by one, leaving zeros behind. Dropping `presigs` then
+        // erases its whole buffer, including any presignatures that did not fit.
+        for presig in presigs.iter_mut().take(room) {
+            state.presigs.push(mem::replace(presig, P::zeroed()));
+        }
+    }
+
+    /// Removes a presignature, waking the refill thread if the pool runs low.
+    pub(crate) fn take(&self) -> Option<P> {
+        let mut state = lock(&self.shared.state);
+        let presig = state.presigs.last_mut().map(|last| mem::replace(last, P::zeroed()));
+        // Unlike `pop`, which would leave a copy of the presignature in the spare capacity,
+        // `truncate` drops the zeroed slot in place.
+        let len = state.presigs.len().saturating_sub(1);
+        state.presigs.truncate(len);
+        if state.presigs.len() < state.low_water {
+            self.shared.cond.notify_one();
+        }
+        presig
+    }
+}
+
+impl<P> Drop for Pool<P> {
+    fn drop(&mut self) {
+        lock(&self.shared.state).shutdown = true;
+        self.shared.cond.notify_one();
+        if let Some(worker) = self.worker.take() {
+            let _ = worker.join();
+        }
+    }
+}
+
+/// The refill loop: waits for the pool to run low, then fills it one presignature at a time.
+fn refill<P: Presign>(shared: &Shared<P>) {
+    let secp = Secp256k1::signing_only();
+    let mut rng = rand::thread_rng();
+    loop {
+        {
+            let mut state = lock(&shared.state);
+            while state.presigs.len() >= state.low_water && !state.shutdown {
+                state = shared.cond.wait(state).unwrap_or_else(|e| e.into_inner());
+            }
+            if state.shutdown {
+                return;
+            }
+        }
+        loop {
+            let presig = P::create(&secp, &mut rng);
+            let mut state = lock(&shared.state);
+            if state.shutdown {
+                return;
+            }
+            if state.presigs.len() < state.capacity {
+                state.presigs.push(presig);
+            }
+            if state.presigs.len() == state.capacity {
+                break;
+            }
+        }
+    }
+}
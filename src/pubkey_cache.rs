@@ -0,0 +1,408 @@
+// SPDX-License-Identifier: CC0-1.0
+
+//! A cache of parsed public keys.
+//!
+//! Parsing a compressed or x-only public key computes a square root to recover the y coordinate.
+//! Applications which see the same keys over and over (the keys of busy wallets, contracts or
+//! Lightning nodes) can keep the parsed keys in a [`PubkeyCache`] and look them up by their
+//! serialization instead.
+//!
+//! The cache holds a fixed number of keys. It is split into shards, each behind its own lock, and
+//! lookups which hit only take a shared lock. When a shard is full, keys are evicted with the
+//! clock algorithm: a key which was looked up since the clock hand last passed it gets a second
+//! chance.
+//!
+//! ```
+//! use secp256k1::pubkey_cache::PubkeyCache;
+//! use secp256k1::{PublicKey, Secp256k1, SecretKey};
+//!
+//! let secp = Secp256k1::new();
+//! let ser = SecretKey::from_slice(&[7; 32]).unwrap().public_key(&secp).serialize();
+//!
+//! let cache = PubkeyCache::new(4096);
+//! for _ in 0..10 {
+//!     let pk = PublicKey::from_slice_cached(&ser, &cache).unwrap();
+//!     assert_eq!(pk.serialize(), ser);
+//! }
+//! assert_eq!(cache.stats().hits, 9);
+//! ```
+
+use core::mem;
+use core::sync::atomic::{AtomicBool, AtomicU64, Ordering};
+use std::collections::HashMap;
+use std::sync::{RwLock, RwLockReadGuard, RwLockWriteGuard};
+use std::vec::Vec;
+
+use crate::key::{PublicKey, PublicKeyBytes, XOnlyPublicKey};
+use crate::{constants, ecdsa, schnorr, Error, Message, Secp256k1, Verification};
+
+/// The number of shards of a cache.
+const SHARDS: usize = 16;
+
+/// The leading byte of the cache key of an x-only key, which no compressed key starts with.
+const X_ONLY_TAG: u8 = 0;
+
+/// A parsed key.
+#[derive(Copy, Clone)]
+enum Parsed {
+    Full(PublicKey),
+    XOnly(XOnlyPublicKey),
+}
+
+/// A cached key: its tagged serialization and the parsed key.
+struct Entry {
+    key: [u8; constants::PUBLIC_KEY_SIZE],
+    parsed: Parsed,
+    referenced: AtomicBool,
+}
+
+struct Shard {
+    index: HashMap<[u8; constants::PUBLIC_KEY_SIZE], usize>,
+    /// The capacity of `index` when it was allocated.
+    index_capacity: usize,
+    entries: Vec<Entry>,
+    capacity: usize,
+    hand: usize,
+}
+
+impl Shard {
+    fn insert(&mut self, key: [u8; constants::PUBLIC_KEY_SIZE], parsed: Parsed) {
+        if self.capacity == 0 || self.index.contains_key(&key) {
+            return;
+        }
+        let entry = Entry { key, parsed, referenced: AtomicBool::new(false) };
+        if self.entries.len() < self.capacity {
+            self.index.insert(key, self.entries.len());
+            self.entries.push(entry);
+            return;
+        }
+        // Every entry passed is unreferenced, so this ends within one turn of the clock.
+        while self.entries[self.hand].referenced.swap(false, Ordering::Relaxed) {
+            self.hand = (self.hand + 1) % self.capacity;
+        }
+        self.index.remove(&self.entries[self.hand].key);
+        self.index.insert(key, self.hand);
+        // Removals can leave tombstones which make the index grow on a later insertion, even
+        // though it never holds more than `capacity` keys. Give the memory back if it did.
+        if self.index.capacity() > self.index_capacity {
+            self.index.shrink_to(self.capacity);
+        }
+        self.entries[self.hand] = entry;
+        self.hand = (self.hand + 1) % self.capacity;
+    }
+}
+
+/// The hit and miss counts of a [`PubkeyCache`].
+#[derive(Copy, Clone, Default, Debug, PartialEq, Eq)]
+pub struct CacheStats {
+    /// The number of lookups which found the key in the cache.
+    pub hits: u64,
+    /// The number of lookups which had to parse the key.
+    pub misses: u64,
+}
+
+impl CacheStats {
+    /// Returns the fraction of lookups which hit, or zero if there were none.
+    pub fn hit_rate(&self) -> f64 {
+        match self.hits + self.misses {
+            0 => 0.0,
+            total => self.hits as f64 / total as f64,
+        }
+    }
+}
+
+/// A fixed-size cache of parsed public keys, see the [module docs](self).
+///
+/// Compressed and x-only keys are cached; uncompressed keys, whose parsing needs no square root,
+/// are parsed every time. Keys which fail to parse are not cached.
+pub struct PubkeyCache {
+    shards: Vec<RwLock<Shard>>,
+    hits: AtomicU64,
+    misses: AtomicU64,
+}
+
+impl PubkeyCache {
+    /// An upper bound on the number of bytes used per cached key.
+    ///
+    /// This is the entry itself plus its slot and control byte in the hash table index. The
+    /// index keeps at most 7/8 of its slots full and rounds the number of slots up to a power of
+    /// two, so it has fewer than 16/7 slots per key.
+    pub const ENTRY_SIZE: usize = mem::size_of::<Entry>()
+        + ((mem::size_of::<([u8; constants::PUBLIC_KEY_SIZE], usize)>() + 1) * 16 + 6) / 7;
+
+    /// Creates a cache holding up to `capacity` keys.
+    ///
+    /// The memory for all keys is allocated up front. A cache with capacity zero caches nothing
+    /// but still counts lookups.
+    pub fn new(capacity: usize) -> PubkeyCache {
+        let shards = (0..SHARDS)
+            .map(|i| {
+                let capacity = capacity / SHARDS + usize::from(i < capacity % SHARDS);
+                let index = HashMap::with_capacity(capacity);
+                RwLock::new(Shard {
+                    index_capacity: index.capacity(),
+                    index,
+                    entries: Vec::with_capacity(capacity),
+                    capacity,
+                    hand: 0,
+                })
+            })
+            .collect();
+        PubkeyCache { shards, hits: AtomicU64::new(0), misses: AtomicU64::new(0) }
+    }
+
+    /// Creates a cache whose keys take at most `bytes` bytes, see [`PubkeyCache::ENTRY_SIZE`].
+    ///
+    /// On top of that, every shard has a fixed overhead of less than 1 KiB.
+    pub fn with_memory_budget(bytes: usize) -> PubkeyCache {
+        PubkeyCache::new(bytes / PubkeyCache::ENTRY_SIZE)
+    }
+
+    /// Returns the number of cached keys.
+    pub fn len(&self) -> usize { self.shards.iter().map(|s| read(s).entries.len()).sum() }
+
+    /// Returns whether the cache holds no keys.
+    pub fn is_empty(&self) -> bool { self.len() == 0 }
+
+    /// Returns the hit and miss counts since the cache was created or the stats were reset.
+    pub fn stats(&self) -> CacheStats {
+        CacheStats {
+            hits: self.hits.load(Ordering::Relaxed),
+            misses: self.misses.load(Ordering::Relaxed),
+        }
+    }
+
+    /// Resets the hit and miss counts to zero.
+    pub fn reset_stats(&self) {
+        self.hits.store(0, Ordering::Relaxed);
+        self.misses.store(0, Ordering::Relaxed);
+    }
+
+    /// Removes all keys.
+    pub fn clear(&self) {
+        for shard in &self.shards {
+            let mut shard = write(shard);
+            shard.index.clear();
+            shard.entries.clear();
+            shard.hand = 0;
+        }
+    }
+
+    /// Parses a compressed or uncompressed key, see [`PublicKeyBytes::to_public_key`].
+    ///
+    /// # Errors
+    ///
+    /// Returns [`Error::InvalidPublicKey`] if this is an x-only key or the bytes do not encode a
+    /// point on the curve.
+    pub fn public_key(&self, pk: PublicKeyBytes) -> Result<PublicKey, Error> {
+        let key = match <[u8; constants::PUBLIC_KEY_SIZE]>::try_from(pk.as_bytes()) {
+            Ok(key) => key,
+            Err(_) => return pk.to_public_key(),
+        };
+        match self.get_or_parse(key, || pk.to_public_key().map(Parsed::Full))? {
+            Parsed::Full(pk) => Ok(pk),
+            Parsed::XOnly(_) => unreachable!("compressed keys are not tagged as x-only"),
+        }
+    }
+
+    /// Parses a key as an x-only key, see [`PublicKeyBytes::to_x_only_public_key`].
+    ///
+    /// # Errors
+    ///
+    /// Returns [`Error::InvalidPublicKey`] if the bytes do not encode a point on the curve.
+    pub fn x_only_public_key(&self, pk: PublicKeyBytes) -> Result<XOnlyPublicKey, Error> {
+        if !pk.is_x_only() {
+            return self.public_key(pk).map(XOnlyPublicKey::from);
+        }
+        let mut key = [X_ONLY_TAG; constants::PUBLIC_KEY_SIZE];
+        key[1..].copy_from_slice(pk.as_bytes());
+        match self.get_or_parse(key, || pk.to_x_only_public_key().map(Parsed::XOnly))? {
+            Parsed::XOnly(pk) => Ok(pk),
+            Parsed::Full(_) => unreachable!("x-only keys are tagged"),
+        }
+    }
+
+    /// Looks up the key cached under `key`, or parses and caches it.
+    fn get_or_parse<F>(
+        &self,
+        key: [u8; constants::PUBLIC_KEY_SIZE],
+        parse: F,
+    ) -> Result<Parsed, Error>
+    where
+        F: FnOnce() -> Result<Parsed, Error>,
+    {
+        // The x coordinate is as good as random, unless chosen to hit one shard, which only costs
+        // the chooser contention.
+        let shard = &self.shards[usize::from(u16::from_le_bytes([key[1], key[2]])) % SHARDS];
+        {
+            let shard = read(shard);
+            if let Some(&i) = shard.index.get(&key) {
+                let entry = &shard.entries[i];
+                entry.referenced.store(true, Ordering::Relaxed);
+                self.hits.fetch_add(1, Ordering::Relaxed);
+                return Ok(entry.parsed);
+            }
+        }
+        self.misses.fetch_add(1, Ordering::Relaxed);
+        let parsed = parse()?;
+        write(shard).insert(key, parsed);
+        Ok(parsed)
+    }
+}
+
+impl core::fmt::Debug for PubkeyCache {
+    fn fmt(&self, f: &mut core::fmt::Formatter) -> core::fmt::Result {
+        f.debug_struct("PubkeyCache")
+            .field("len", &self.len())
+            .field("stats", &self.stats())
+            .finish()
+    }
+}
+
+/// Locks `shard` for reading, ignoring poisoning: the shard is consistent between statements
+/// which can panic.
+fn read(shard: &RwLock<Shard>) -> RwLockReadGuard<'_, Shard> {
+    shard.read().unwrap_or_else(|e| e.into_inner())
+}
+
+/// Locks `shard` for writing, ignoring poisoning, see [`read`].
+fn write(shard: &RwLock<Shard>) -> RwLockWriteGuard<'_, Shard> {
+    shard.write().unwrap_or_else(|e| e.into_inner())
+}
+
+impl PublicKey {
+    /// Creates a public key from a slice, like [`PublicKey::from_slice`], looking it up in `cache`
+    /// first.
+    pub fn from_slice_cached(data: &[u8], cache: &PubkeyCache) -> Result<PublicKey, Error> {
+        cache.public_key(PublicKeyBytes::from_slice(data)?)
+    }
+}
+
+impl XOnlyPublicKey {
+    /// Creates a schnorr public key from a byte array, like [`XOnlyPublicKey::from_byte_array`],
+    /// looking it up in `cache` first.
+    pub fn from_byte_array_cached(
+        data: &[u8; constants::SCHNORR_PUBLIC_KEY_SIZE],
+        cache: &PubkeyCache,
+    ) -> Result<XOnlyPublicKey, Error> {
+        cache.x_only_public_key(PublicKeyBytes::from_slice(data)?)
+    }
+}
+
+impl<C: Verification> Secp256k1<C> {
+    /// Verifies an ECDSA signature against a serialized key, which is looked up in `cache`, see
+    /// [`Secp256k1::verify_ecdsa_ref`].
+    pub fn verify_ecdsa_cached(
+        &self,
+        msg: impl Into<Message>,
+        sig: &ecdsa::Signature,
+        pk: PublicKeyBytes,
+        cache: &PubkeyCache,
+    ) -> Result<(), Error> {
+        self.verify_ecdsa(msg, sig, &cache.public_key(pk)?)
+    }
+
+    /// Verifies a schnorr signature against a serialized key, which is looked up in `cache`, see
+    /// [`Secp256k1::verify_schnorr_ref`].
+    pub fn verify_schnorr_cached(
+        &self,
+        sig: &schnorr::Signature,
+        msg: &[u8],
+        pk: PublicKeyBytes,
+        cache: &PubkeyCache,
+    ) -> Result<(), Error> {
+        self.verify_schnorr(sig, msg, &cache.x_only_public_key(pk)?)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::{Keypair, SecretKey};
+
+    #[test]
+    fn hits_and_eviction() {
+        let secp = Secp256k1::new();
+        let keys: Vec<PublicKey> = (1..=100u8)
+            .map(|i| SecretKey::from_slice(&[i; 32]).unwrap().public_key(&secp))
+            .collect();
+        let sers: Vec<_> = keys.iter().map(|pk| pk.serialize()).collect();
+
+        let cache = PubkeyCache::new(1000);
+        for _ in 0..3 {
+            for (pk, ser) in keys.iter().zip(&sers) {
+                assert_eq!(PublicKey::from_slice_cached(ser, &cache), Ok(*pk));
+            }
+        }
+        assert_eq!(cache.len(), 100);
+        assert_eq!(cache.stats(), CacheStats { hits: 200, misses: 100 });
+        assert!((cache.stats().hit_rate() - 2.0 / 3.0).abs() < 1e-9);
+
+        // X-only and uncompressed keys.
+        let (xonly, _) = keys[5].x_only_public_key();
+        let x = xonly.serialize();
+        assert_eq!(XOnlyPublicKey::from_byte_array_cached(&x, &cache), Ok(xonly));
+        assert_eq!(XOnlyPublicKey::from_byte_array_cached(&x, &cache), Ok(xonly));
+        let full = keys[5].serialize_uncompressed();
+        assert_eq!(PublicKey::from_slice_cached(&full, &cache), Ok(keys[5]));
+        assert_eq!(PublicKey::from_slice_cached(&x, &cache), Err(Error::InvalidPublicKey));
+        assert_eq!(cache.len(), 101);
+
+        // Invalid keys are not cached.
+        cache.reset_stats();
+        let mut bad = sers[0];
+        bad[1..].copy_from_slice(&[0xff; 32]);
+        assert!(PublicKey::from_slice_cached(&bad, &cache).is_err());
+        assert!(PublicKey::from_slice_cached(&bad, &cache).is_err());
+        assert_eq!(cache.stats(), CacheStats { hits: 0, misses: 2 });
+        cache.clear();
+        assert!(cache.is_empty());
+
+        // A full cache keeps the keys in use.
+        let cache = PubkeyCache::new(SHARDS * 2);
+        for round in 0..20 {
+            for ser in &sers[..3] {
+                PublicKey::from_slice_cached(ser, &cache).unwrap();
+            }
+            PublicKey::from_slice_cached(&sers[3 + round], &cache).unwrap();
+        }
+        assert!(cache.len() <= SHARDS * 2);
+        cache.reset_stats();
+        for (pk, ser) in keys.iter().zip(&sers).take(3) {
+            assert_eq!(PublicKey::from_slice_cached(ser, &cache), Ok(*pk));
+        }
+        assert_eq!(cache.stats().hits, 3);
+
+        let cache = PubkeyCache::new(0);
+        assert_eq!(PublicKey::from_slice_cached(&sers[0], &cache), Ok(keys[0]));
+        assert_eq!(PublicKey::from_slice_cached(&sers[0], &cache), Ok(keys[0]));
+        assert_eq!(cache.stats(), CacheStats { hits: 0, misses: 2 });
+        assert!(cache.is_empty());
+    }
+
+    #[test]
+    #[cfg(not(secp256k1_fuzz))] // fuzz-sigs do not verify against parsed keys
+    fn cached_verification() {
+        let secp = Secp256k1::new();
+        let cache = PubkeyCache::with_memory_budget(1 << 20);
+        let sk = SecretKey::from_slice(&[3; 32]).unwrap();
+        let msg = Message::from_digest([1; 32]);
+
+        let sig = secp.sign_ecdsa(msg, &sk);
+        let ser = sk.public_key(&secp).serialize();
+        let pk = PublicKeyBytes::from_slice(&ser).unwrap();
+        assert_eq!(secp.verify_ecdsa_cached(msg, &sig, pk, &cache), Ok(()));
+        assert_eq!(secp.verify_ecdsa_cached(msg, &sig, pk, &cache), Ok(()));
+
+        let keypair = Keypair::from_secret_key(&secp, &sk);
+        let sig = secp.sign_schnorr_no_aux_rand(b"msg", &keypair);
+        let x = keypair.x_only_public_key().0.serialize();
+        let pk = PublicKeyBytes::from_slice(&x).unwrap();
+        assert_eq!(secp.verify_schnorr_cached(&sig, b"msg", pk, &cache), Ok(()));
+        assert_eq!(
+            secp.verify_schnorr_cached(&sig, b"other", pk, &cache),
+            Err(Error::IncorrectSignature)
+        );
+        assert_eq!(cache.stats(), CacheStats { hits: 2, misses: 2 });
+    }
+}
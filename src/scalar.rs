@@ -10,15 +10,19 @@
 
 use core::{fmt, ops};
 
-use crate::constants;
+use crate::{constants, ffi};
 
 /// Positive 256-bit integer guaranteed to be less than the secp256k1 curve order.
 ///
 /// The difference between `SecretKey` and `Scalar` is that `Scalar` doesn't guarantee being
 /// securely usable as a private key.
 ///
-/// **Warning: the operations on this type are NOT constant time!**
-/// Using this with secret values is not advised.
+/// Scalars can be added, subtracted, multiplied, negated and inverted modulo the curve order.
+/// Every operation converts its operands to the internal representation of the library and the
+/// result back to bytes; chains of operations are faster with [`UnpackedScalar`].
+///
+/// **Warning: parsing and comparing this type is NOT constant time!**
+/// The arithmetic is, except for [`Scalar::invert_var`].
 // Internal represenation is big endian to match what `libsecp256k1` uses.
 // Also easier to implement comparison.
 // Debug impl omitted for now, the bytes may be secret
@@ -106,6 +110,48 @@ impl Scalar {
 
         self.as_be_bytes().as_c_ptr()
     }
+
+    /// Returns the multiplicative inverse of the scalar, or `None` if it is zero.
+    pub fn invert(&self) -> Option<Scalar> {
+        UnpackedScalar::from(*self).invert().map(Scalar::from)
+    }
+
+    /// Returns the multiplicative inverse of the scalar, or `None` if it is zero, in variable time.
+    ///
+    /// This is faster than [`Scalar::invert`], but leaks the scalar through timing. Use it only for
+    /// public scalars.
+    pub fn invert_var(&self) -> Option<Scalar> {
+        UnpackedScalar::from(*self).invert_var().map(Scalar::from)
+    }
+}
+
+/// Implements a binary operator for [`Scalar`] through [`UnpackedScalar`].
+macro_rules! impl_scalar_op {
+    ($trait:ident, $fn:ident, $assign_trait:ident, $assign_fn:ident) => {
+        impl ops::$trait for Scalar {
+            type Output = Scalar;
+
+            #[inline]
+            fn $fn(self, other: Scalar) -> Scalar {
+                Scalar::from(UnpackedScalar::from(self).$fn(UnpackedScalar::from(other)))
+            }
+        }
+
+        impl ops::$assign_trait for Scalar {
+            #[inline]
+            fn $assign_fn(&mut self, other: Scalar) { *self = ops::$trait::$fn(*self, other) }
+        }
+    };
+}
+impl_scalar_op!(Add, add, AddAssign, add_assign);
+impl_scalar_op!(Sub, sub, SubAssign, sub_assign);
+impl_scalar_op!(Mul, mul, MulAssign, mul_assign);
+
+impl ops::Neg for Scalar {
+    type Output = Scalar;
+
+    #[inline]
+    fn neg(self) -> Scalar { Scalar::from(-UnpackedScalar::from(self)) }
 }
 
 impl<I> ops::Index<I> for Scalar
@@ -122,6 +168,190 @@ impl From<crate::SecretKey> for Scalar {
     fn from(value: crate::SecretKey) -> Self { Scalar(value.secret_bytes()) }
 }
 
+/// A [`Scalar`] in the internal representation of the library.
+///
+/// A [`Scalar`] stores its big-endian bytes, so each of its operations parses its operands and
+/// serializes its result. An `UnpackedScalar` stays in the representation which the arithmetic
+/// works on: convert the inputs of a computation with `From<Scalar>`, do all the operations on
+/// unpacked scalars and convert the result back with `From<UnpackedScalar>`.
+///
+/// The representation depends on the platform, so unpacked scalars have no serialization. The
+/// arithmetic is constant time, except for [`UnpackedScalar::invert_var`], but comparisons are
+/// not.
+///
+/// ```
+/// use secp256k1::scalar::{Scalar, UnpackedScalar};
+///
+/// // Evaluates a polynomial with coefficients `coeffs` at `x`.
+/// fn evaluate(coeffs: &[Scalar], x: Scalar) -> Scalar {
+///     let x = UnpackedScalar::from(x);
+///     let mut acc = UnpackedScalar::ZERO;
+///     for coeff in coeffs.iter().rev() {
+///         acc = acc * x + UnpackedScalar::from(*coeff);
+///     }
+///     Scalar::from(acc)
+/// }
+///
+/// let coeffs = [Scalar::ONE, Scalar::ONE, Scalar::ONE];
+/// let x = Scalar::ONE + Scalar::ONE;
+/// assert_eq!(evaluate(&coeffs, x), x * x + x + Scalar::ONE);
+/// ```
+#[derive(Copy, Clone, PartialEq, Eq)]
+pub struct UnpackedScalar(ffi::UnpackedScalar);
+
+impl UnpackedScalar {
+    /// Scalar representing `0`
+    pub const ZERO: UnpackedScalar = UnpackedScalar(ffi::UnpackedScalar::ZERO);
+
+    /// Returns the multiplicative inverse of the scalar, or `None` if it is zero.
+    pub fn invert(&self) -> Option<UnpackedScalar> {
+        let mut r = UnpackedScalar::ZERO;
+        let ret = unsafe {
+            ffi::secp256k1_unpacked_scalar_inverse(
+                ffi::secp256k1_context_no_precomp,
+                &mut r.0,
+                &self.0,
+            )
+        };
+        if ret == 1 {
+            Some(r)
+        } else {
+            None
+        }
+    }
+
+    /// Returns the multiplicative inverse of the scalar, or `None` if it is zero, in variable time.
+    ///
+    /// This is faster than [`UnpackedScalar::invert`], but leaks the scalar through timing. Use it
+    /// only for public scalars.
+    pub fn invert_var(&self) -> Option<UnpackedScalar> {
+        let mut r = UnpackedScalar::ZERO;
+        let ret = unsafe {
+            ffi::secp256k1_unpacked_scalar_inverse_var(
+                ffi::secp256k1_context_no_precomp,
+                &mut r.0,
+                &self.0,
+            )
+        };
+        if ret == 1 {
+            Some(r)
+        } else {
+            None
+        }
+    }
+}
+
+impl From<Scalar> for UnpackedScalar {
+    fn from(value: Scalar) -> Self {
+        let mut r = UnpackedScalar::ZERO;
+        unsafe {
+            let ret = ffi::secp256k1_unpacked_scalar_parse(
+                ffi::secp256k1_context_no_precomp,
+                &mut r.0,
+                value.as_c_ptr(),
+            );
+            // Scalars are below the curve order.
+            debug_assert_eq!(ret, 1);
+        }
+        r
+    }
+}
+
+impl From<UnpackedScalar> for Scalar {
+    fn from(value: UnpackedScalar) -> Self {
+        let mut bytes = [0u8; 32];
+        unsafe {
+            ffi::secp256k1_unpacked_scalar_serialize(
+                ffi::secp256k1_context_no_precomp,
+                bytes.as_mut_ptr(),
+                &value.0,
+            )
+        };
+        Scalar(bytes)
+    }
+}
+
+impl ops::Add for UnpackedScalar {
+    type Output = UnpackedScalar;
+
+    #[inline]
+    fn add(self, other: UnpackedScalar) -> UnpackedScalar {
+        let mut r = UnpackedScalar::ZERO;
+        unsafe {
+            ffi::secp256k1_unpacked_scalar_add(
+                ffi::secp256k1_context_no_precomp,
+                &mut r.0,
+                &self.0,
+                &other.0,
+            )
+        };
+        r
+    }
+}
+
+impl ops::Sub for UnpackedScalar {
+    type Output = UnpackedScalar;
+
+    #[inline]
+    fn sub(self, other: UnpackedScalar) -> UnpackedScalar { self + -other }
+}
+
+impl ops::Mul for UnpackedScalar {
+    type Output = UnpackedScalar;
+
+    #[inline]
+    fn mul(self, other: UnpackedScalar) -> UnpackedScalar {
+        let mut r = UnpackedScalar::ZERO;
+        unsafe {
+            ffi::secp256k1_unpacked_scalar_mul(
+                ffi::secp256k1_context_no_precomp,
+                &mut r.0,
+                &self.0,
+                &other.0,
+            )
+        };
+        r
+    }
+}
+
+impl ops::Neg for UnpackedScalar {
+    type Output = UnpackedScalar;
+
+    #[inline]
+    fn neg(self) -> UnpackedScalar {
+        let mut r = UnpackedScalar::ZERO;
+        unsafe {
+            ffi::secp256k1_unpacked_scalar_negate(
+                ffi::secp256k1_context_no_precomp,
+                &mut r.0,
+                &self.0,
+            )
+        };
+        r
+    }
+}
+
+impl ops::AddAssign for UnpackedScalar {
+    #[inline]
+    fn add_assign(&mut self, other: UnpackedScalar) { *self = *self + other }
+}
+
+impl ops::SubAssign for UnpackedScalar {
+    #[inline]
+    fn sub_assign(&mut self, other: UnpackedScalar) { *self = *self - other }
+}
+
+impl ops::MulAssign for UnpackedScalar {
+    #[inline]
+    fn mul_assign(&mut self, other: UnpackedScalar) { *self = *self * other }
+}
+
+impl fmt::Debug for UnpackedScalar {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        fmt::Debug::fmt(&Scalar::from(*self), f)
+    }
+}
+
 /// Error returned when the value of scalar is invalid - larger than the curve order.
 // Intentionally doesn't implement `Copy` to improve forward compatibility.
 // Same reason for `non_exhaustive`.
@@ -138,3 +368,53 @@ impl fmt::Display for OutOfRangeError {
 
 #[cfg(feature = "std")]
 impl std::error::Error for OutOfRangeError {}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn arithmetic() {
+        let two = Scalar::ONE + Scalar::ONE;
+        let three = two + Scalar::ONE;
+        let mut six = [0u8; 32];
+        six[31] = 6;
+        assert_eq!(two * three, Scalar::from_be_bytes(six).unwrap());
+        assert_eq!(three - two, Scalar::ONE);
+        assert_eq!(two - three, Scalar::MAX);
+        assert_eq!(Scalar::MAX + Scalar::ONE, Scalar::ZERO);
+        assert_eq!(Scalar::MAX * Scalar::MAX, Scalar::ONE);
+        assert_eq!(-Scalar::ONE, Scalar::MAX);
+        assert_eq!(-Scalar::ZERO, Scalar::ZERO);
+
+        assert_eq!(Scalar::ZERO.invert(), None);
+        assert_eq!(Scalar::ZERO.invert_var(), None);
+        assert_eq!(Scalar::ONE.invert(), Some(Scalar::ONE));
+        assert_eq!(Scalar::MAX.invert_var(), Some(Scalar::MAX));
+        let x = Scalar::from_be_bytes([0x5a; 32]).unwrap();
+        assert_eq!(x * x.invert().unwrap(), Scalar::ONE);
+        assert_eq!(x.invert(), x.invert_var());
+
+        let mut acc = x;
+        acc += three;
+        acc *= two;
+        acc -= x;
+        assert_eq!(acc, x + two * three);
+
+        // Unpacked scalars give the same results without converting in between.
+        let ux = UnpackedScalar::from(x);
+        let utwo = UnpackedScalar::from(two);
+        assert_eq!(Scalar::from(UnpackedScalar::from(Scalar::MAX)), Scalar::MAX);
+        assert_eq!(Scalar::from(UnpackedScalar::ZERO), Scalar::ZERO);
+        assert_eq!(UnpackedScalar::from(Scalar::ZERO), UnpackedScalar::ZERO);
+        assert_eq!(Scalar::from(ux * utwo - ux + -utwo), x * two - x - two);
+        assert_eq!(Scalar::from(ux.invert().unwrap()), x.invert().unwrap());
+        assert_eq!(ux.invert_var(), ux.invert());
+        assert_eq!(UnpackedScalar::ZERO.invert(), None);
+        let mut uacc = ux;
+        uacc += utwo;
+        uacc *= utwo;
+        uacc -= ux;
+        assert_eq!(Scalar::from(uacc), x + two * two);
+    }
+}
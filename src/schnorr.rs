@@ -3,14 +3,19 @@
 //! Support for schnorr signatures.
 //!
 
+#[cfg(all(feature = "std", feature = "rand"))]
+mod presign;
+
 use core::{fmt, ptr, str};
 
 #[cfg(feature = "rand")]
 use rand::{CryptoRng, Rng};
 use secp256k1_sys::SchnorrSigExtraParams;
 
+#[cfg(all(feature = "std", feature = "rand"))]
+pub use self::presign::PresignaturePool;
 use crate::ffi::{self, CPtr};
-use crate::key::{Keypair, XOnlyPublicKey};
+use crate::key::{Keypair, PublicKeyBytes, XOnlyPublicKey};
 #[cfg(feature = "global-context")]
 use crate::SECP256K1;
 use crate::{constants, from_hex, Error, Secp256k1, Signing, Verification};
@@ -111,6 +116,56 @@ impl Signature {
     }
 }
 
+/// A schnorr signature borrowed from a larger buffer, such as a transaction witness.
+///
+/// Verifying with [`Secp256k1::verify_schnorr_ref`] passes the borrowed bytes to the library
+/// without copying them into a [`Signature`] first.
+#[derive(Copy, Clone, PartialEq, Eq, PartialOrd, Ord, Hash)]
+pub struct SignatureRef<'a>(&'a [u8; constants::SCHNORR_SIGNATURE_SIZE]);
+
+impl<'a> SignatureRef<'a> {
+    /// Borrows a signature from a 64 bytes array.
+    #[inline]
+    pub fn from_byte_array(sig: &'a [u8; constants::SCHNORR_SIGNATURE_SIZE]) -> Self {
+        SignatureRef(sig)
+    }
+
+    /// Borrows a signature from a slice.
+    ///
+    /// # Errors
+    ///
+    /// Returns [`Error::InvalidSignature`] if the slice is not 64 bytes long.
+    #[inline]
+    pub fn from_slice(data: &'a [u8]) -> Result<Self, Error> {
+        <&[u8; constants::SCHNORR_SIGNATURE_SIZE]>::try_from(data)
+            .map(SignatureRef)
+            .map_err(|_| Error::InvalidSignature)
+    }
+
+    /// Returns the borrowed bytes.
+    #[inline]
+    pub fn as_byte_array(&self) -> &'a [u8; constants::SCHNORR_SIGNATURE_SIZE] { self.0 }
+
+    /// Copies the signature into an owned [`Signature`].
+    #[inline]
+    pub fn to_signature(&self) -> Signature { Signature(*self.0) }
+}
+
+impl<'a> From<&'a Signature> for SignatureRef<'a> {
+    #[inline]
+    fn from(sig: &'a Signature) -> Self { SignatureRef(&sig.0) }
+}
+
+impl fmt::Debug for SignatureRef<'_> {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        f.write_str("SignatureRef(")?;
+        for byte in self.0 {
+            write!(f, "{:02x}", byte)?;
+        }
+        f.write_str(")")
+    }
+}
+
 impl<C: Signing> Secp256k1<C> {
     fn sign_schnorr_helper(
         &self,
@@ -198,6 +253,93 @@ impl<C: Verification> Secp256k1<C> {
             }
         }
     }
+
+    /// Verifies a schnorr signature given as borrowed bytes, for instance straight from a
+    /// transaction witness.
+    ///
+    /// The signature is read in place; only the public key is parsed.
+    ///
+    /// # Errors
+    ///
+    /// Returns [`Error::InvalidPublicKey`] if `pubkey` is not a 32-byte x-only key or does not
+    /// encode a point on the curve, and [`Error::IncorrectSignature`] if the signature does not
+    /// verify.
+    pub fn verify_schnorr_ref(
+        &self,
+        sig: SignatureRef,
+        msg: &[u8],
+        pubkey: PublicKeyBytes,
+    ) -> Result<(), Error> {
+        // BIP340 keys have no parity; accepting a full key would silently drop it.
+        if !pubkey.is_x_only() {
+            return Err(Error::InvalidPublicKey);
+        }
+        let pubkey = pubkey.to_x_only_public_key()?;
+        unsafe {
+            let ret = ffi::secp256k1_schnorrsig_verify(
+                self.ctx.as_ptr(),
+                sig.0.as_c_ptr(),
+                msg.as_c_ptr(),
+                msg.len(),
+                pubkey.as_c_ptr(),
+            );
+
+            if ret == 1 {
+                Ok(())
+            } else {
+                Err(Error::IncorrectSignature)
+            }
+        }
+    }
+
+    /// Verifies many schnorr signatures at once.
+    ///
+    /// The verification equations of all signatures are combined, with random factors derived
+    /// from all inputs, into one multi-scalar multiplication, which is considerably faster than
+    /// verifying the signatures one by one. The result is the same as that of calling
+    /// [`Secp256k1::verify_schnorr`] on each item (except with negligible probability), but an
+    /// error does not tell which signatures are invalid; verify them individually to find out.
+    ///
+    /// # Errors
+    ///
+    /// Returns [`Error::IncorrectSignature`] if at least one signature does not verify.
+    #[cfg(feature = "alloc")]
+    pub fn verify_schnorr_batch(
+        &self,
+        items: &[(Signature, &[u8], XOnlyPublicKey)],
+    ) -> Result<(), Error> {
+        use alloc::vec::Vec;
+
+        use crate::ffi::types::AlignedType;
+
+        let sigs: Vec<[u8; constants::SCHNORR_SIGNATURE_SIZE]> =
+            items.iter().map(|(sig, _, _)| sig.0).collect();
+        let msgs: Vec<*const ffi::types::c_uchar> =
+            items.iter().map(|(_, msg, _)| msg.as_ptr()).collect();
+        let msglens: Vec<usize> = items.iter().map(|(_, msg, _)| msg.len()).collect();
+        let pubkeys: Vec<ffi::XOnlyPublicKey> =
+            items.iter().map(|(_, _, pk)| unsafe { *pk.as_c_ptr() }).collect();
+        unsafe {
+            let size = ffi::secp256k1_schnorrsig_verify_batch_scratch_size(items.len());
+            let mut scratch = alloc::vec![AlignedType::zeroed(); (size + 15) / 16];
+            let ret = ffi::secp256k1_schnorrsig_verify_batch(
+                self.ctx.as_ptr(),
+                scratch.as_mut_ptr() as *mut ffi::types::c_void,
+                scratch.len() * 16,
+                sigs.as_ptr() as *const ffi::types::c_uchar,
+                msgs.as_ptr(),
+                msglens.as_ptr(),
+                pubkeys.as_ptr(),
+                items.len(),
+            );
+
+            if ret == 1 {
+                Ok(())
+            } else {
+                Err(Error::IncorrectSignature)
+            }
+        }
+    }
 }
 
 #[cfg(test)]
@@ -303,6 +445,75 @@ mod tests {
         assert!(secp.verify_schnorr(&sig, &msg, &pubkey).is_ok());
     }
 
+    #[test]
+    #[cfg(not(secp256k1_fuzz))] // fixed sig vectors can't work with fuzz-sigs
+    #[cfg(feature = "alloc")]
+    fn schnorr_verify_ref() {
+        let secp = Secp256k1::new();
+
+        let msg = hex_32!("E48441762FB75010B2AA31A512B62B4148AA3FB08EB0765D76B252559064A614");
+        // A witness: signature followed by the key.
+        let mut witness = [0u8; 96];
+        from_hex("6470FD1303DDA4FDA717B9837153C24A6EAB377183FC438F939E0ED2B620E9EE5077C4A8B8DCA28963D772A94F5F0DDF598E1C47C137F91933274C7C3EDADCE8B33CC9EDC096D0A83416964BD3C6247B8FECD256E4EFA7870D2C854BDEB33390", &mut witness).unwrap();
+
+        let sig = SignatureRef::from_slice(&witness[..64]).unwrap();
+        let pubkey = PublicKeyBytes::from_slice(&witness[64..]).unwrap();
+        assert!(secp.verify_schnorr_ref(sig, &msg, pubkey).is_ok());
+        assert_eq!(
+            secp.verify_schnorr_ref(sig, &[0; 32], pubkey),
+            Err(Error::IncorrectSignature)
+        );
+        let owned = sig.to_signature();
+        assert_eq!(SignatureRef::from(&owned), sig);
+        assert!(secp.verify_schnorr(&owned, &msg, &pubkey.to_x_only_public_key().unwrap()).is_ok());
+
+        assert_eq!(SignatureRef::from_slice(&witness[..63]), Err(Error::InvalidSignature));
+        let off_curve = PublicKeyBytes::from_slice(&[0xff; 32]).unwrap();
+        assert_eq!(secp.verify_schnorr_ref(sig, &msg, off_curve), Err(InvalidPublicKey));
+
+        // The same key with a parity byte is not a BIP340 key.
+        let mut compressed = [0x02; 33];
+        compressed[1..].copy_from_slice(&witness[64..]);
+        let compressed = PublicKeyBytes::from_slice(&compressed).unwrap();
+        assert!(compressed.to_public_key().is_ok());
+        assert_eq!(secp.verify_schnorr_ref(sig, &msg, compressed), Err(InvalidPublicKey));
+    }
+
+    #[test]
+    #[cfg(all(feature = "alloc", not(secp256k1_fuzz)))]
+    fn schnorr_verify_batch() {
+        let secp = Secp256k1::new();
+        let msgs: Vec<Vec<u8>> = (0..100u8).map(|i| vec![i; i as usize]).collect();
+        let keypairs: Vec<_> = (1..=100u8)
+            .map(|i| Keypair::from_secret_key(&secp, &SecretKey::from_slice(&[i; 32]).unwrap()))
+            .collect();
+        let mut items: Vec<_> = msgs
+            .iter()
+            .zip(&keypairs)
+            .map(|(msg, keypair)| {
+                let sig = secp.sign_schnorr_no_aux_rand(msg, keypair);
+                (sig, &msg[..], keypair.x_only_public_key().0)
+            })
+            .collect();
+
+        // Small batches use Strauss' algorithm, large ones Pippenger's.
+        for n in [0, 1, 2, 10, 100] {
+            assert_eq!(secp.verify_schnorr_batch(&items[..n]), Ok(()), "{} signatures", n);
+        }
+        items[57].1 = &msgs[58];
+        assert_eq!(secp.verify_schnorr_batch(&items), Err(Error::IncorrectSignature));
+        assert_eq!(secp.verify_schnorr_batch(&items[..57]), Ok(()));
+        // An s value of zero, and an r value which is not on the curve.
+        items[57].1 = &msgs[57];
+        let mut bad = *items[3].0.as_byte_array();
+        bad[32..].copy_from_slice(&[0; 32]);
+        items[3].0 = Signature::from_byte_array(bad);
+        assert_eq!(secp.verify_schnorr_batch(&items[..10]), Err(Error::IncorrectSignature));
+        bad[..32].copy_from_slice(&[0; 32]);
+        items[3].0 = Signature::from_byte_array(bad);
+        assert_eq!(secp.verify_schnorr_batch(&items[..10]), Err(Error::IncorrectSignature));
+    }
+
     #[test]
     fn test_serialize() {
         let sig = Signature::from_str("6470FD1303DDA4FDA717B9837153C24A6EAB377183FC438F939E0ED2B620E9EE5077C4A8B8DCA28963D772A94F5F0DDF598E1C47C137F91933274C7C3EDADCE8").unwrap();
@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: CC0-1.0
+
+//! BIP340 signing with precomputed nonces.
+
+use rand::{CryptoRng, Rng};
+
+use super::Signature;
+use crate::ffi::CPtr;
+use crate::presign::{Pool, Presign};
+use crate::{constants, ffi, Keypair, Secp256k1, Signing};
+
+/// A precomputed nonce: the x coordinate of `R` followed by the nonce.
+struct Presignature([u8; 64]);
+
+impl Presign for Presignature {
+    fn create<C: Signing, R: Rng + CryptoRng + ?Sized>(
+        secp: &Secp256k1<C>,
+        rng: &mut R,
+    ) -> Presignature {
+        let mut presig = Presignature([0; 64]);
+        loop {
+            let mut nonce = crate::random_32_bytes(rng);
+            let ret = unsafe {
+                ffi::secp256k1_schnorrsig_presignature_create(
+                    secp.ctx.as_ptr(),
+                    presig.0.as_mut_c_ptr(),
+                    nonce.as_c_ptr(),
+                )
+            };
+            ffi::non_secure_erase_impl(&mut nonce, [0; 32]);
+            // Fails only for nonces which are not valid scalars.
+            if ret == 1 {
+                return presig;
+            }
+        }
+    }
+
+    fn zeroed() -> Presignature { Presignature([0; 64]) }
+}
+
+impl Drop for Presignature {
+    fn drop(&mut self) { ffi::non_secure_erase_impl(&mut self.0, [0; 64]); }
+}
+
+/// A pool of single-use BIP340 presignatures.
+///
+/// Like [`ecdsa::PresignaturePool`], this pool multiplies random nonces with the generator ahead
+/// of time. Signing then only hashes the challenge and computes `s = k + e*x`.
+/// The signatures verify like any other BIP340 signature, but their nonces are random instead of
+/// derived from the key and message as in [`Secp256k1::sign_schnorr`].
+///
+/// Every presignature is used for exactly one signature: two signatures made with the same
+/// presignature reveal the secret key. The pool hands each one out once, erases it when it is
+/// used or dropped, and never exposes it, so it cannot be copied, serialized or restored.
+/// Processes which fork must not use the same pool in both the parent and the child.
+///
+/// ```
+/// use secp256k1::schnorr::PresignaturePool;
+/// use secp256k1::{Keypair, Secp256k1};
+///
+/// let secp = Secp256k1::new();
+/// let keypair = Keypair::from_seckey_slice(&secp, &[7; 32]).unwrap();
+///
+/// let pool = PresignaturePool::new(16);
+/// pool.fill(&secp, &mut secp256k1::rand::thread_rng());
+///
+/// let sig = pool.sign_schnorr(b"attestation", &keypair).expect("the pool is not empty");
+/// # #[cfg(not(secp256k1_fuzz))]
+/// assert!(secp.verify_schnorr(&sig, b"attestation", &keypair.x_only_public_key().0).is_ok());
+/// ```
+///
+/// [`ecdsa::PresignaturePool`]: crate::ecdsa::PresignaturePool
+pub struct PresignaturePool(Pool<Presignature>);
+
+impl PresignaturePool {
+    /// Creates an empty pool holding up to `capacity` presignatures, to be filled with
+    /// [`PresignaturePool::fill`].
+    pub fn new(capacity: usize) -> PresignaturePool { PresignaturePool(Pool::new(capacity)) }
+
+    /// Creates a pool holding up to `capacity` presignatures which a background thread fills up
+    /// whenever fewer than `low_water` are left, with nonces from [`rand::thread_rng`].
+    ///
+    /// Dropping the pool stops the thread.
+    ///
+    /// # Panics
+    ///
+    /// If `low_water` is greater than `capacity` or the thread cannot be spawned.
+    pub fn with_refill(capacity: usize, low_water: usize) -> PresignaturePool {
+        PresignaturePool(Pool::with_refill(capacity, low_water))
+    }
+
+    /// Returns the number of presignatures left.
+    pub fn len(&self) -> usize { self.0.len() }
+
+    /// Returns whether no presignatures are left.
+    pub fn is_empty(&self) -> bool { self.len() == 0 }
+
+    /// Fills the pool up to its capacity, with nonces drawn from `rng`.
+    ///
+    /// The presignatures are computed without holding the lock of the pool, so signing is not
+    /// held up.
+    pub fn fill<C: Signing, R: Rng + CryptoRng + ?Sized>(
+        &self,
+        secp: &Secp256k1<C>,
+        rng: &mut R,
+    ) {
+        self.0.fill(secp, rng)
+    }
+
+    /// Signs `msg` with `keypair`, using up one presignature.
+    ///
+    /// Returns `None` if the pool is empty; callers can then fall back to
+    /// [`Secp256k1::sign_schnorr`].
+    pub fn sign_schnorr(&self, msg: &[u8], keypair: &Keypair) -> Option<Signature> {
+        let mut presig = self.0.take()?;
+        let mut sig = [0u8; constants::SCHNORR_SIGNATURE_SIZE];
+        unsafe {
+            let ret = ffi::secp256k1_schnorrsig_presignature_sign(
+                ffi::secp256k1_context_no_precomp,
+                sig.as_mut_c_ptr(),
+                presig.0.as_mut_c_ptr(),
+                msg.as_c_ptr(),
+                msg.len(),
+                keypair.as_c_ptr(),
+            );
+            // Presignatures in the pool and key pairs are valid.
+            assert_eq!(ret, 1);
+        }
+        Some(Signature(sig))
+    }
+}
+
+impl core::fmt::Debug for PresignaturePool {
+    fn fmt(&self, f: &mut core::fmt::Formatter) -> core::fmt::Result {
+        f.debug_struct("PresignaturePool").field("len", &self.len()).finish()
+    }
+}
+
+#[cfg(all(test, not(secp256k1_fuzz)))]
+mod tests {
+    use std::vec::Vec;
+
+    use super::*;
+
+    #[test]
+    fn presignatures() {
+        let secp = Secp256k1::new();
+        let keypairs: Vec<_> = (1..=8u8)
+            .map(|i| Keypair::from_seckey_slice(&secp, &[i; 32]).unwrap())
+            .collect();
+
+        let pool = PresignaturePool::new(8);
+        assert!(pool.sign_schnorr(b"msg", &keypairs[0]).is_none());
+        pool.fill(&secp, &mut rand::thread_rng());
+        assert_eq!(pool.len(), 8);
+        let mut rs = Vec::new();
+        for (i, keypair) in keypairs.iter().enumerate() {
+            // Messages of any length, including none.
+            let msg = &[i as u8; 8][..i];
+            let sig = pool.sign_schnorr(msg, keypair).unwrap();
+            assert!(secp.verify_schnorr(&sig, msg, &keypair.x_only_public_key().0).is_ok());
+            assert!(secp.verify_schnorr(&sig, b"other", &keypair.x_only_public_key().0).is_err());
+            rs.push(sig.0[..32].to_vec());
+        }
+        assert!(pool.is_empty());
+        rs.sort();
+        rs.dedup();
+        assert_eq!(rs.len(), 8);
+
+        // A presignature can only be used once.
+        let mut presig = Presignature::create(&secp, &mut rand::thread_rng());
+        let mut sig = [0u8; 64];
+        unsafe {
+            let ret = ffi::secp256k1_schnorrsig_presignature_sign(
+                ffi::secp256k1_context_no_precomp,
+                sig.as_mut_c_ptr(),
+                presig.0.as_mut_c_ptr(),
+                b"msg".as_c_ptr(),
+                3,
+                keypairs[0].as_c_ptr(),
+            );
+            assert_eq!(ret, 1);
+            assert_eq!(presig.0, [0; 64]);
+            let ret = ffi::secp256k1_schnorrsig_presignature_sign(
+                ffi::secp256k1_context_no_precomp,
+                sig.as_mut_c_ptr(),
+                presig.0.as_mut_c_ptr(),
+                b"msg".as_c_ptr(),
+                3,
+                keypairs[0].as_c_ptr(),
+            );
+            assert_eq!(ret, 0);
+            assert_eq!(sig, [0; 64]);
+        }
+
+        let pool = PresignaturePool::with_refill(32, 16);
+        for i in 0..100u8 {
+            let keypair = &keypairs[usize::from(i) % 8];
+            let sig = loop {
+                match pool.sign_schnorr(&[i], keypair) {
+                    Some(sig) => break sig,
+                    None => std::thread::yield_now(),
+                }
+            };
+            assert!(secp.verify_schnorr(&sig, &[i], &keypair.x_only_public_key().0).is_ok());
+        }
+    }
+}
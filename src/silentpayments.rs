@@ -0,0 +1,336 @@
+// SPDX-License-Identifier: CC0-1.0
+
+//! Support for scanning for Silent Payments as described in [BIP352].
+//!
+//! A silent payment recipient publishes a scan public key and a spend public key. To find the
+//! outputs paid to it, the recipient has to perform an ECDH with the sum of the input public keys
+//! of every eligible transaction and compare the derived candidate output keys against the
+//! transaction's taproot outputs. [`Recipient`] does all of this in a single call into the C
+//! library per transaction.
+//!
+//! Deciding which inputs are eligible (and extracting their public keys) and finding the smallest
+//! outpoint of a transaction is left to the caller.
+//!
+//! [BIP352]: https://github.com/bitcoin/bips/blob/master/bip-0352.mediawiki
+
+use core::{fmt, ptr};
+use std::collections::HashMap;
+
+use crate::ffi::types::{c_uchar, c_void};
+use crate::ffi::{self, CPtr};
+use crate::{Error, PublicKey, Scalar, Secp256k1, SecretKey, Signing, Verification, XOnlyPublicKey};
+
+/// The size of a serialized outpoint (32-byte txid followed by the 4-byte little-endian index).
+pub const OUTPOINT_SIZE: usize = 36;
+
+/// The data of a transaction that is needed to scan it.
+#[derive(Copy, Clone, Debug)]
+pub struct TransactionData<'a> {
+    /// The lexicographically smallest outpoint spent by the transaction, serialized as the 32-byte
+    /// txid followed by the 4-byte little-endian output index.
+    pub smallest_outpoint: [u8; OUTPOINT_SIZE],
+    /// Public keys of the eligible taproot key path inputs.
+    pub xonly_inputs: &'a [XOnlyPublicKey],
+    /// Public keys of all other eligible inputs.
+    pub plain_inputs: &'a [PublicKey],
+    /// The taproot output keys of the transaction.
+    pub outputs: &'a [XOnlyPublicKey],
+}
+
+/// An output that belongs to a [`Recipient`].
+#[derive(Copy, Clone, Debug, PartialEq, Eq)]
+pub struct FoundOutput {
+    /// The output key.
+    pub output: XOnlyPublicKey,
+    /// The tweak that has to be added to the spend secret key to obtain the output's secret key.
+    pub tweak: Scalar,
+    /// The index of the label the output was paid to, if any.
+    pub label: Option<u32>,
+}
+
+#[derive(Copy, Clone)]
+struct LabelEntry {
+    tweak: [u8; 32],
+    m: u32,
+}
+
+/// A silent payments recipient, able to scan transactions for outputs paid to it.
+#[derive(Clone)]
+pub struct Recipient {
+    scan_key: SecretKey,
+    spend_pubkey: PublicKey,
+    labels: HashMap<[u8; 33], LabelEntry>,
+}
+
+impl fmt::Debug for Recipient {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        f.debug_struct("Recipient")
+            .field("spend_pubkey", &self.spend_pubkey)
+            .field("labels", &self.labels.len())
+            .finish_non_exhaustive()
+    }
+}
+
+unsafe extern "C" fn label_lookup(
+    label33: *const c_uchar,
+    label_context: *const c_void,
+) -> *const c_uchar {
+    let labels = &*(label_context as *const HashMap<[u8; 33], LabelEntry>);
+    let mut label = [0u8; 33];
+    ptr::copy_nonoverlapping(label33, label.as_mut_ptr(), label.len());
+    match labels.get(&label) {
+        Some(entry) => entry.tweak.as_ptr(),
+        None => ptr::null(),
+    }
+}
+
+impl Recipient {
+    /// Creates a recipient from its scan secret key and spend public key.
+    pub fn new(scan_key: SecretKey, spend_pubkey: PublicKey) -> Recipient {
+        Recipient { scan_key, spend_pubkey, labels: HashMap::new() }
+    }
+
+    /// Returns the spend public key of this recipient.
+    pub fn spend_pubkey(&self) -> PublicKey { self.spend_pubkey }
+
+    /// Registers the label `m` so that outputs paid to it are found by the scan functions, and
+    /// returns the corresponding labeled spend public key.
+    pub fn add_label<C: Signing>(&mut self, secp: &Secp256k1<C>, m: u32) -> Result<PublicKey, Error> {
+        let mut label = unsafe { ffi::PublicKey::new() };
+        let mut tweak = [0u8; 32];
+        let res = unsafe {
+            ffi::secp256k1_silentpayments_recipient_create_label(
+                secp.ctx().as_ptr(),
+                &mut label,
+                tweak.as_mut_c_ptr(),
+                self.scan_key.as_c_ptr(),
+                m,
+            )
+        };
+        if res != 1 {
+            return Err(Error::InvalidTweak);
+        }
+        let label = PublicKey::from(label);
+        let labeled = self.spend_pubkey.combine(&label)?;
+        self.labels.insert(label.serialize(), LabelEntry { tweak, m });
+        Ok(labeled)
+    }
+
+    /// Scans one transaction for outputs paid to this recipient.
+    ///
+    /// # Errors
+    ///
+    /// Returns [`Error::InvalidPublicKeySum`] if the transaction has no input public keys or they
+    /// sum to infinity; such transactions cannot contain silent payments.
+    pub fn scan_transaction<C: Verification>(
+        &self,
+        secp: &Secp256k1<C>,
+        tx: &TransactionData,
+    ) -> Result<Vec<FoundOutput>, Error> {
+        let mut buf = Vec::new();
+        let n = self.scan_into(secp, tx, &mut buf)?;
+        Ok(buf[..n].iter().map(|found| self.found_output(found)).collect())
+    }
+
+    /// Scans all transactions of a block, returning the found outputs together with the index of
+    /// the transaction (in `txs`) they were found in.
+    ///
+    /// Transactions that cannot contain silent payments are skipped.
+    pub fn scan_block<'a, C: Verification, I: IntoIterator<Item = TransactionData<'a>>>(
+        &self,
+        secp: &Secp256k1<C>,
+        txs: I,
+    ) -> Vec<(usize, FoundOutput)> {
+        let mut buf = Vec::new();
+        let mut ret = Vec::new();
+        for (i, tx) in txs.into_iter().enumerate() {
+            if let Ok(n) = self.scan_into(secp, &tx, &mut buf) {
+                ret.extend(buf[..n].iter().map(|found| (i, self.found_output(found))));
+            }
+        }
+        ret
+    }
+
+    /// Scans `tx`, writing the found outputs to the start of `buf` and returning their number.
+    fn scan_into<C: Verification>(
+        &self,
+        secp: &Secp256k1<C>,
+        tx: &TransactionData,
+        buf: &mut Vec<ffi::SilentpaymentsFoundOutput>,
+    ) -> Result<usize, Error> {
+        if tx.xonly_inputs.is_empty() && tx.plain_inputs.is_empty() {
+            return Err(Error::InvalidPublicKeySum);
+        }
+        if tx.outputs.is_empty() {
+            return Ok(0);
+        }
+        if buf.len() < tx.outputs.len() {
+            buf.resize(tx.outputs.len(), unsafe { ffi::SilentpaymentsFoundOutput::new() });
+        }
+
+        let (lookup, context) = if self.labels.is_empty() {
+            (None, ptr::null())
+        } else {
+            let lookup: ffi::SilentpaymentsLabelLookupFn = Some(label_lookup);
+            (lookup, &self.labels as *const _ as *const c_void)
+        };
+        let mut n_found = 0;
+        let res = unsafe {
+            ffi::secp256k1_silentpayments_recipient_scan_outputs(
+                secp.ctx().as_ptr(),
+                buf.as_mut_c_ptr(),
+                &mut n_found,
+                tx.outputs.as_c_ptr() as *const ffi::XOnlyPublicKey,
+                tx.outputs.len(),
+                self.scan_key.as_c_ptr(),
+                tx.xonly_inputs.as_c_ptr() as *const ffi::XOnlyPublicKey,
+                tx.xonly_inputs.len(),
+                tx.plain_inputs.as_c_ptr() as *const ffi::PublicKey,
+                tx.plain_inputs.len(),
+                tx.smallest_outpoint.as_ptr(),
+                self.spend_pubkey.as_c_ptr(),
+                lookup,
+                context,
+            )
+        };
+        if res == 1 {
+            Ok(n_found)
+        } else {
+            Err(Error::InvalidPublicKeySum)
+        }
+    }
+
+    fn found_output(&self, found: &ffi::SilentpaymentsFoundOutput) -> FoundOutput {
+        let label = if found.found_with_label != 0 {
+            let label = PublicKey::from(found.label).serialize();
+            self.labels.get(&label).map(|entry| entry.m)
+        } else {
+            None
+        };
+        FoundOutput {
+            output: XOnlyPublicKey::from(found.output),
+            tweak: Scalar::from_be_bytes(found.tweak).expect("tweak is reduced by the library"),
+            label,
+        }
+    }
+}
+
+/// Creates the `k`-th silent payment output of a transaction to the recipient with the given scan
+/// and (possibly labeled) spend public key.
+///
+/// `input_keys` are the secret keys of the eligible inputs of the transaction. Secret keys of
+/// taproot inputs must be negated if their public key has an odd Y coordinate.
+pub fn create_output<C: Signing>(
+    secp: &Secp256k1<C>,
+    input_keys: &[SecretKey],
+    smallest_outpoint: &[u8; OUTPOINT_SIZE],
+    scan_pubkey: &PublicKey,
+    spend_pubkey: &PublicKey,
+    k: u32,
+) -> Result<XOnlyPublicKey, Error> {
+    if input_keys.is_empty() {
+        return Err(Error::InvalidSecretKey);
+    }
+    let mut output = unsafe { ffi::XOnlyPublicKey::new() };
+    let res = unsafe {
+        ffi::secp256k1_silentpayments_sender_create_output(
+            secp.ctx().as_ptr(),
+            &mut output,
+            input_keys.as_c_ptr() as *const c_uchar,
+            input_keys.len(),
+            smallest_outpoint.as_ptr(),
+            scan_pubkey.as_c_ptr(),
+            spend_pubkey.as_c_ptr(),
+            k,
+        )
+    };
+    if res == 1 {
+        Ok(XOnlyPublicKey::from(output))
+    } else {
+        Err(Error::InvalidSecretKey)
+    }
+}
+
+#[cfg(all(test, not(secp256k1_fuzz)))]
+mod tests {
+    use super::*;
+    use crate::{Keypair, Parity};
+
+    #[cfg(all(feature = "rand", feature = "std"))]
+    fn random_outputs(secp: &Secp256k1<crate::All>, n: usize) -> Vec<XOnlyPublicKey> {
+        (0..n).map(|_| Keypair::new(secp, &mut rand::thread_rng()).x_only_public_key().0).collect()
+    }
+
+    #[test]
+    #[cfg(all(feature = "rand", feature = "std"))]
+    fn scan() {
+        let secp = Secp256k1::new();
+        let (scan_key, scan_pubkey) = secp.generate_keypair(&mut rand::thread_rng());
+        let (spend_key, spend_pubkey) = secp.generate_keypair(&mut rand::thread_rng());
+        let mut recipient = Recipient::new(scan_key, spend_pubkey);
+        let labeled = recipient.add_label(&secp, 1).unwrap();
+        recipient.add_label(&secp, 7).unwrap();
+
+        // One taproot input and one plain input.
+        let taproot_input = Keypair::new(&secp, &mut rand::thread_rng());
+        let (xonly_input, parity) = taproot_input.x_only_public_key();
+        let mut taproot_key = taproot_input.secret_key();
+        if parity == Parity::Odd {
+            taproot_key = taproot_key.negate();
+        }
+        let (plain_key, plain_input) = secp.generate_keypair(&mut rand::thread_rng());
+        let input_keys = [taproot_key, plain_key];
+        let outpoint = [7u8; OUTPOINT_SIZE];
+
+        let mut outputs = random_outputs(&secp, 5);
+        let out0 =
+            create_output(&secp, &input_keys, &outpoint, &scan_pubkey, &spend_pubkey, 0).unwrap();
+        let out1 =
+            create_output(&secp, &input_keys, &outpoint, &scan_pubkey, &spend_pubkey, 1).unwrap();
+        let out2 = create_output(&secp, &input_keys, &outpoint, &scan_pubkey, &labeled, 2).unwrap();
+        outputs.insert(3, out0);
+        outputs.insert(1, out2);
+        outputs.push(out1);
+
+        let tx = TransactionData {
+            smallest_outpoint: outpoint,
+            xonly_inputs: &[xonly_input],
+            plain_inputs: &[plain_input],
+            outputs: &outputs,
+        };
+        let found = recipient.scan_transaction(&secp, &tx).unwrap();
+        assert_eq!(found.len(), 3);
+        assert_eq!(found[0].output, out0);
+        assert_eq!(found[0].label, None);
+        assert_eq!(found[1].output, out1);
+        assert_eq!(found[1].label, None);
+        assert_eq!(found[2].output, out2);
+        assert_eq!(found[2].label, Some(1));
+        for f in &found {
+            let sk = spend_key.add_tweak(&f.tweak).unwrap();
+            assert_eq!(sk.x_only_public_key(&secp).0, f.output);
+        }
+
+        // Without the label only the unlabeled outputs are found.
+        let unlabeled = Recipient::new(scan_key, spend_pubkey);
+        assert_eq!(unlabeled.scan_transaction(&secp, &tx).unwrap().len(), 2);
+
+        // A different outpoint or input set yields a different shared secret.
+        let other = TransactionData { smallest_outpoint: [8u8; OUTPOINT_SIZE], ..tx };
+        assert!(recipient.scan_transaction(&secp, &other).unwrap().is_empty());
+        let other = TransactionData { plain_inputs: &[], ..tx };
+        assert!(recipient.scan_transaction(&secp, &other).unwrap().is_empty());
+
+        let other = TransactionData { xonly_inputs: &[], plain_inputs: &[], ..tx };
+        assert_eq!(recipient.scan_transaction(&secp, &other), Err(Error::InvalidPublicKeySum));
+        let other = TransactionData { outputs: &[], ..tx };
+        assert!(recipient.scan_transaction(&secp, &other).unwrap().is_empty());
+
+        let unrelated = random_outputs(&secp, 3);
+        let block = [other, tx, TransactionData { outputs: &unrelated, ..tx }, tx];
+        let found = recipient.scan_block(&secp, block.iter().copied());
+        assert_eq!(found.len(), 6);
+        assert!(found[..3].iter().all(|(i, _)| *i == 1));
+        assert!(found[3..].iter().all(|(i, _)| *i == 3));
+    }
+}
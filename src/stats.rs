@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: CC0-1.0
+
+//! Counters of the expensive operations performed by the C library.
+//!
+//! With the `instrumentation` feature the library counts, per thread, how often it runs each of
+//! the operations in [`Op`]. This tells where the time of a workload goes without a profiler,
+//! e.g. how many field inversions a batch API saves over the single-item calls. With the
+//! `instrumentation-cycles` feature the library also accumulates the time stamp counter across
+//! the operations on x86 targets.
+//!
+//! Without the feature none of this code is compiled, and the C library is built exactly as
+//! upstream.
+//!
+//! ```
+//! # #[cfg(all(feature = "std", not(secp256k1_fuzz)))] {
+//! use secp256k1::{stats, Secp256k1, SecretKey, PublicKey};
+//!
+//! let secp = Secp256k1::signing_only();
+//! let before = stats::snapshot();
+//! let _ = PublicKey::from_secret_key(&secp, &SecretKey::from_slice(&[1; 32]).unwrap());
+//! let diff = stats::snapshot().since(&before);
+//! assert_eq!(diff.count(stats::Op::EcmultGen), 1);
+//! # }
+//! ```
+
+use core::fmt;
+
+use crate::ffi;
+
+/// An operation counted by the C library.
+#[derive(Copy, Clone, PartialEq, Eq, PartialOrd, Ord, Hash, Debug)]
+#[non_exhaustive]
+pub enum Op {
+    /// Double multiplication `a*P + b*G` (signature verification, public key recovery).
+    Ecmult,
+    /// Multi-scalar multiplication.
+    EcmultMulti,
+    /// Constant-time multiplication of the generator (key generation, signing).
+    EcmultGen,
+    /// Constant-time multiplication of an arbitrary point (ECDH).
+    EcmultConst,
+    /// Constant-time field inversion.
+    FeInv,
+    /// Variable-time field inversion.
+    FeInvVar,
+    /// Field square root (point decompression).
+    FeSqrt,
+    /// Variable-time quadratic residue test.
+    FeIsSquareVar,
+    /// SHA256 compression function.
+    Sha256Transform,
+}
+
+impl Op {
+    /// All operations, in the order of the C library's `SECP256K1_STATS_*` constants.
+    pub const ALL: [Op; NUM_OPS] = [
+        Op::Ecmult,
+        Op::EcmultMulti,
+        Op::EcmultGen,
+        Op::EcmultConst,
+        Op::FeInv,
+        Op::FeInvVar,
+        Op::FeSqrt,
+        Op::FeIsSquareVar,
+        Op::Sha256Transform,
+    ];
+
+    /// Returns the name of the operation as used by the C library.
+    pub fn name(self) -> &'static str {
+        match self {
+            Op::Ecmult => "ecmult",
+            Op::EcmultMulti => "ecmult_multi",
+            Op::EcmultGen => "ecmult_gen",
+            Op::EcmultConst => "ecmult_const",
+            Op::FeInv => "fe_inv",
+            Op::FeInvVar => "fe_inv_var",
+            Op::FeSqrt => "fe_sqrt",
+            Op::FeIsSquareVar => "fe_is_square_var",
+            Op::Sha256Transform => "sha256_transform",
+        }
+    }
+}
+
+impl fmt::Display for Op {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result { f.write_str(self.name()) }
+}
+
+const NUM_OPS: usize = 9;
+
+/// The counters of the current thread at some point in time, see [`snapshot`].
+#[derive(Copy, Clone, PartialEq, Eq, Debug)]
+pub struct Snapshot {
+    counts: [u64; NUM_OPS],
+    cycles: Option<[u64; NUM_OPS]>,
+}
+
+impl Snapshot {
+    /// Returns how often `op` was performed.
+    #[inline]
+    pub fn count(&self, op: Op) -> u64 { self.counts[op as usize] }
+
+    /// Returns the number of cycles spent in `op`, if the library measures cycles.
+    ///
+    /// Cycles are only measured with the `instrumentation-cycles` feature on x86. Operations
+    /// with several exits in the C code ([`Op::EcmultMulti`] and [`Op::FeIsSquareVar`]) are
+    /// counted but not timed.
+    #[inline]
+    pub fn cycles(&self, op: Op) -> Option<u64> { self.cycles.map(|c| c[op as usize]) }
+
+    /// Returns the operations performed between `earlier` and `self`.
+    pub fn since(&self, earlier: &Snapshot) -> Snapshot {
+        let mut ret = *self;
+        for i in 0..NUM_OPS {
+            ret.counts[i] = self.counts[i].wrapping_sub(earlier.counts[i]);
+        }
+        if let (Some(ref mut cycles), Some(earlier)) = (&mut ret.cycles, earlier.cycles) {
+            for i in 0..NUM_OPS {
+                cycles[i] = cycles[i].wrapping_sub(earlier[i]);
+            }
+        }
+        ret
+    }
+}
+
+impl fmt::Display for Snapshot {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        for op in Op::ALL {
+            write!(f, "{:<18} {:>12}", op.name(), self.count(op))?;
+            if let Some(cycles) = self.cycles(op) {
+                write!(f, " {:>16} cycles", cycles)?;
+            }
+            writeln!(f)?;
+        }
+        Ok(())
+    }
+}
+
+/// Returns the current thread's counters.
+pub fn snapshot() -> Snapshot {
+    let mut counts = [0; NUM_OPS];
+    let mut cycles = [0; NUM_OPS];
+    let have_cycles = unsafe {
+        ffi::secp256k1_stats_snapshot(counts.as_mut_ptr(), cycles.as_mut_ptr(), NUM_OPS)
+    };
+    Snapshot { counts, cycles: if have_cycles == 1 { Some(cycles) } else { None } }
+}
+
+/// Resets the current thread's counters to zero.
+pub fn reset() { unsafe { ffi::secp256k1_stats_reset() } }
+
+#[cfg(all(test, feature = "std", not(secp256k1_fuzz)))]
+mod tests {
+    use super::*;
+    use crate::{ecdsa, Message, PublicKey, Secp256k1, SecretKey};
+
+    #[test]
+    fn counts_verification() {
+        let secp = Secp256k1::new();
+        let sk = SecretKey::from_slice(&[0x42; 32]).unwrap();
+        let pk = PublicKey::from_secret_key(&secp, &sk);
+        let msg = Message::from_digest([0xab; 32]);
+        let sig = secp.sign_ecdsa(msg, &sk);
+        let der = sig.serialize_der();
+        let serialized = pk.serialize();
+
+        reset();
+        let before = snapshot();
+        assert_eq!(before.count(Op::Ecmult), 0);
+
+        let sig = ecdsa::Signature::from_der(&der).unwrap();
+        let pk = PublicKey::from_slice(&serialized).unwrap();
+        secp.verify_ecdsa(msg, &sig, &pk).unwrap();
+
+        let diff = snapshot().since(&before);
+        assert_eq!(diff.count(Op::Ecmult), 1);
+        assert_eq!(diff.count(Op::EcmultGen), 0);
+        assert!(diff.count(Op::FeSqrt) >= 1); // decompressing the public key
+        // The result is compared in Jacobian coordinates, without an inversion.
+        assert_eq!(diff.count(Op::FeInv) + diff.count(Op::FeInvVar), 0);
+        if let Some(cycles) = diff.cycles(Op::Ecmult) {
+            assert!(cycles > 0);
+        }
+
+        // Counters are per thread.
+        std::thread::spawn(|| assert_eq!(snapshot().count(Op::Ecmult), 0)).join().unwrap();
+    }
+}
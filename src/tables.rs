@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: CC0-1.0
+
+//! Placement of the precomputed tables.
+//!
+//! Verification and signing read precomputed multiples of the generator from static tables of
+//! [`size`] bytes (about 1.3 MB unless the `lowmemory` feature is enabled). The reads are random,
+//! so they miss the TLB often, and on multi-socket machines most threads read them from a remote
+//! NUMA node. [`Tables`] is a copy of the tables in memory chosen by the caller: with
+//! [`Tables::in_region`] the copy can live on huge pages or on the local node of a set of threads.
+//!
+//! The library's multiplication routines do not take a context, so a copy is installed for the
+//! current thread with [`set_thread`] (matching threads pinned to a NUMA node) or for the whole
+//! process with [`set_default`], rather than per context. Installed copies must live for the rest
+//! of the program, which [`Box::leak`] provides for heap copies.
+//!
+//! ```
+//! use secp256k1::{tables, Message, Secp256k1, SecretKey};
+//!
+//! let copy = Box::leak(Box::new(tables::Tables::new()));
+//! tables::set_thread(Some(copy));
+//! // Everything on this thread now reads from `copy`.
+//! let secp = Secp256k1::new();
+//! let sk = SecretKey::from_slice(&[1; 32]).unwrap();
+//! let sig = secp.sign_ecdsa(Message::from_digest([2; 32]), &sk);
+//! # assert!(secp.verify_ecdsa(Message::from_digest([2; 32]), &sig, &sk.public_key(&secp)).is_ok());
+//! assert!(tables::memory_usage().copies >= 1);
+//! ```
+
+use core::ptr::{self, NonNull};
+use core::sync::atomic::{AtomicUsize, Ordering};
+use std::boxed::Box;
+
+use crate::ffi::types::c_void;
+use crate::{ffi, Error};
+
+/// The alignment of a copy: a cache line.
+const ALIGN: usize = 64;
+
+#[derive(Copy, Clone)]
+#[repr(C, align(64))]
+struct CacheLine([u8; ALIGN]);
+
+static COPIES: AtomicUsize = AtomicUsize::new(0);
+static COPY_BYTES: AtomicUsize = AtomicUsize::new(0);
+
+/// Returns the size in bytes of the precomputed tables, which is also the size of a copy.
+pub fn size() -> usize { unsafe { ffi::secp256k1_tables_size() } }
+
+/// The memory used by the precomputed tables, see [`memory_usage`].
+#[derive(Copy, Clone, PartialEq, Eq, Debug)]
+#[non_exhaustive]
+pub struct MemoryUsage {
+    /// Size in bytes of the static tables compiled into the library.
+    pub static_tables: usize,
+    /// Number of live [`Tables`] copies.
+    pub copies: usize,
+    /// Total size in bytes of the live copies, including alignment padding of heap copies.
+    pub copy_bytes: usize,
+}
+
+impl MemoryUsage {
+    /// Returns the total size in bytes of the static tables and all copies.
+    ///
+    /// The static tables only become resident once they are read, which they no longer are
+    /// when every thread uses a copy.
+    pub fn total(&self) -> usize { self.static_tables + self.copy_bytes }
+}
+
+/// Returns the memory used by the precomputed tables of the library.
+pub fn memory_usage() -> MemoryUsage {
+    MemoryUsage {
+        static_tables: size(),
+        copies: COPIES.load(Ordering::Relaxed),
+        copy_bytes: COPY_BYTES.load(Ordering::Relaxed),
+    }
+}
+
+/// A copy of the precomputed tables.
+pub struct Tables {
+    ptr: NonNull<u8>,
+    bytes: usize,
+    _heap: Option<Box<[CacheLine]>>,
+}
+
+// The copy is never written to after construction.
+unsafe impl Send for Tables {}
+unsafe impl Sync for Tables {}
+
+impl Tables {
+    /// Copies the tables to a fresh heap allocation.
+    pub fn new() -> Tables {
+        let lines = (size() + ALIGN - 1) / ALIGN;
+        let mut heap = std::vec![CacheLine([0; ALIGN]); lines].into_boxed_slice();
+        let ptr = NonNull::new(heap.as_mut_ptr() as *mut u8).expect("boxed slices are non-null");
+        unsafe { Tables::copy_to(ptr, lines * ALIGN, Some(heap)) }
+    }
+
+    /// Copies the tables into `region`, for instance memory mapped on huge pages or allocated
+    /// on a particular NUMA node.
+    ///
+    /// The copy starts at the first 64-byte aligned address of `region`, which therefore needs
+    /// up to 63 bytes more than [`size`].
+    ///
+    /// # Errors
+    ///
+    /// Returns [`Error::NotEnoughMemory`] if `region` is too small.
+    pub fn in_region(region: &'static mut [u8]) -> Result<Tables, Error> {
+        let offset = region.as_ptr().align_offset(ALIGN);
+        if offset > region.len() || region.len() - offset < size() {
+            return Err(Error::NotEnoughMemory);
+        }
+        let region = &mut region[offset..];
+        let ptr = NonNull::new(region.as_mut_ptr()).expect("slices are non-null");
+        Ok(unsafe { Tables::copy_to(ptr, region.len(), None) })
+    }
+
+    /// Copies the tables to `ptr`, which must point to `len` writable bytes aligned to `ALIGN`.
+    unsafe fn copy_to(ptr: NonNull<u8>, len: usize, heap: Option<Box<[CacheLine]>>) -> Tables {
+        let ret = ffi::secp256k1_tables_copy(ptr.as_ptr() as *mut c_void, len);
+        assert_eq!(ret, 1, "region too small for the tables");
+        let bytes = if heap.is_some() { len } else { size() };
+        COPIES.fetch_add(1, Ordering::Relaxed);
+        COPY_BYTES.fetch_add(bytes, Ordering::Relaxed);
+        Tables { ptr, bytes, _heap: heap }
+    }
+
+    fn as_c_ptr(tables: Option<&Tables>) -> *const c_void {
+        tables.map_or(ptr::null(), |t| t.ptr.as_ptr() as *const c_void)
+    }
+}
+
+impl Default for Tables {
+    fn default() -> Self { Tables::new() }
+}
+
+impl Drop for Tables {
+    fn drop(&mut self) {
+        COPIES.fetch_sub(1, Ordering::Relaxed);
+        COPY_BYTES.fetch_sub(self.bytes, Ordering::Relaxed);
+    }
+}
+
+impl core::fmt::Debug for Tables {
+    fn fmt(&self, f: &mut core::fmt::Formatter) -> core::fmt::Result {
+        f.debug_struct("Tables").field("ptr", &self.ptr).field("bytes", &self.bytes).finish()
+    }
+}
+
+/// Makes the current thread read from `tables`, or from the default (see [`set_default`]) if
+/// `None`.
+pub fn set_thread(tables: Option<&'static Tables>) {
+    unsafe { ffi::secp256k1_tables_set_thread(Tables::as_c_ptr(tables)) }
+}
+
+/// Makes every thread without a copy of its own (see [`set_thread`]) read from `tables`, or from
+/// the static tables if `None`.
+///
+/// # Safety
+///
+/// No other thread may be using the library while this function runs: the library reads the
+/// default without synchronization.
+pub unsafe fn set_default(tables: Option<&'static Tables>) {
+    ffi::secp256k1_tables_set_default(Tables::as_c_ptr(tables))
+}
+
+#[cfg(all(test, not(secp256k1_fuzz)))]
+mod tests {
+    use super::*;
+    use crate::{Message, PublicKey, Secp256k1, SecretKey};
+
+    #[test]
+    fn copies_are_used() {
+        let secp = Secp256k1::new();
+        let sk = SecretKey::from_slice(&[0x42; 32]).unwrap();
+        let msg = Message::from_digest([0xab; 32]);
+        let pk = PublicKey::from_secret_key(&secp, &sk);
+        let sig = secp.sign_ecdsa(msg, &sk);
+
+        let before = memory_usage();
+        assert!(Tables::in_region(std::vec![0u8; 100].leak()).is_err());
+        // Deliberately misaligned.
+        let region = &mut std::vec![0u8; size() + 100].leak()[1..];
+        let copy = &*Box::leak(Box::new(Tables::in_region(region).unwrap()));
+        let usage = memory_usage();
+        assert_eq!(usage.copies, before.copies + 1);
+        assert_eq!(usage.total(), before.total() + size());
+
+        set_thread(Some(copy));
+        assert_eq!(PublicKey::from_secret_key(&secp, &sk), pk);
+        assert_eq!(secp.sign_ecdsa(msg, &sk), sig);
+        assert!(secp.verify_ecdsa(msg, &sig, &pk).is_ok());
+        set_thread(None);
+
+        // Copies are per thread.
+        let heap = &*Box::leak(Box::new(Tables::new()));
+        std::thread::scope(|s| {
+            s.spawn(|| {
+                set_thread(Some(heap));
+                assert!(secp.verify_ecdsa(msg, &sig, &pk).is_ok());
+            });
+        });
+
+        // A corrupted copy shows that the library reads from it.
+        let mut corrupt = std::vec![CacheLine([0; ALIGN]); (size() + ALIGN - 1) / ALIGN];
+        unsafe {
+            let mem = corrupt.as_mut_ptr() as *mut c_void;
+            assert_eq!(ffi::secp256k1_tables_copy(mem, corrupt.len() * ALIGN), 1);
+            for line in corrupt.iter_mut() {
+                line.0[0] ^= 1;
+            }
+            ffi::secp256k1_tables_set_thread(mem);
+        }
+        assert!(secp.verify_ecdsa(msg, &sig, &pk).is_err());
+        set_thread(None);
+        assert!(secp.verify_ecdsa(msg, &sig, &pk).is_ok());
+    }
+}
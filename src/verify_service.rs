@@ -0,0 +1,317 @@
+// SPDX-License-Identifier: CC0-1.0
+
+//! A verification service which coalesces concurrent requests into batches.
+//!
+//! Callers which verify signatures one at a time from many concurrent tasks (RPC handlers, peer
+//! connections) can hand them to a [`VerifyService`] instead. Requests that arrive within a short
+//! window of each other are verified together on the service's worker thread: schnorr signatures
+//! with one [`Secp256k1::verify_schnorr_batch`] call, ECDSA signatures (which cannot be batched)
+//! one after the other. Every request gets its own [`VerifyFuture`], which works with any
+//! executor.
+//!
+//! ```
+//! use std::time::Duration;
+//!
+//! use secp256k1::verify_service::VerifyService;
+//! use secp256k1::{Keypair, Secp256k1, SecretKey};
+//!
+//! let secp = Secp256k1::new();
+//! let keypair = Keypair::from_secret_key(&secp, &SecretKey::from_slice(&[7; 32]).unwrap());
+//! let sig = secp.sign_schnorr_no_aux_rand(b"hello", &keypair);
+//!
+//! let service = VerifyService::new(Duration::from_millis(1), 256);
+//! let fut = service.verify_schnorr(sig, b"hello", keypair.x_only_public_key().0);
+//! // `fut.await` in async code; here we block on it.
+//! # #[cfg(not(secp256k1_fuzz))]
+//! assert!(fut.wait().is_ok());
+//! ```
+
+use core::future::Future;
+use core::pin::Pin;
+use core::task::{Context, Poll, Waker};
+use std::sync::{Arc, Condvar, Mutex, MutexGuard};
+use std::thread::{self, JoinHandle};
+use std::time::{Duration, Instant};
+use std::vec::Vec;
+
+use crate::{ecdsa, schnorr, Error, Message, PublicKey, Secp256k1, VerifyOnly, XOnlyPublicKey};
+
+/// The state shared between a [`VerifyFuture`] and the worker.
+#[derive(Default)]
+struct Slot {
+    result: Option<Result<(), Error>>,
+    waker: Option<Waker>,
+}
+
+/// One enqueued verification.
+enum Job {
+    Ecdsa(Message, ecdsa::Signature, PublicKey),
+    Schnorr(schnorr::Signature, Vec<u8>, XOnlyPublicKey),
+}
+
+#[derive(Default)]
+struct Queue {
+    jobs: Vec<(Job, Arc<Mutex<Slot>>)>,
+    shutdown: bool,
+}
+
+struct Shared {
+    queue: Mutex<Queue>,
+    cond: Condvar,
+}
+
+/// Locks `mutex`, ignoring poisoning: no code that panics while holding one of our locks leaves
+/// the protected state inconsistent.
+fn lock<T>(mutex: &Mutex<T>) -> MutexGuard<'_, T> {
+    mutex.lock().unwrap_or_else(|e| e.into_inner())
+}
+
+/// A worker thread verifying signatures in batches, see the [module docs](self).
+///
+/// Dropping the service verifies the requests still queued and then stops the worker.
+pub struct VerifyService {
+    shared: Arc<Shared>,
+    worker: Option<JoinHandle<()>>,
+}
+
+impl VerifyService {
+    /// Starts a service whose worker waits up to `window` after the first request of a batch for
+    /// more requests, and verifies at most `max_batch` requests at once.
+    ///
+    /// A batch is verified as soon as it is full, so under load the window is never waited for.
+    ///
+    /// # Panics
+    ///
+    /// If `max_batch` is zero or the worker thread cannot be spawned.
+    pub fn new(window: Duration, max_batch: usize) -> VerifyService {
+        assert!(max_batch > 0, "max_batch must not be zero");
+        let shared = Arc::new(Shared { queue: Mutex::new(Queue::default()), cond: Condvar::new() });
+        let worker = {
+            let shared = Arc::clone(&shared);
+            thread::Builder::new()
+                .name("secp256k1-verify".into())
+                .spawn(move || run(&shared, window, max_batch))
+                .expect("failed to spawn the verification worker")
+        };
+        VerifyService { shared, worker: Some(worker) }
+    }
+
+    /// Queues the verification of an ECDSA signature, see [`Secp256k1::verify_ecdsa`].
+    pub fn verify_ecdsa(
+        &self,
+        msg: impl Into<Message>,
+        sig: ecdsa::Signature,
+        pk: PublicKey,
+    ) -> VerifyFuture {
+        self.submit(Job::Ecdsa(msg.into(), sig, pk))
+    }
+
+    /// Queues the verification of a schnorr signature, see [`Secp256k1::verify_schnorr`].
+    pub fn verify_schnorr(
+        &self,
+        sig: schnorr::Signature,
+        msg: &[u8],
+        pk: XOnlyPublicKey,
+    ) -> VerifyFuture {
+        self.submit(Job::Schnorr(sig, msg.to_vec(), pk))
+    }
+
+    fn submit(&self, job: Job) -> VerifyFuture {
+        let slot = Arc::new(Mutex::new(Slot::default()));
+        let mut queue = lock(&self.shared.queue);
+        queue.jobs.push((job, Arc::clone(&slot)));
+        // The worker only needs waking for the first request and for a full batch, but telling
+        // these apart here would need the batch size; waking it is cheap.
+        self.shared.cond.notify_one();
+        VerifyFuture { slot }
+    }
+}
+
+impl Drop for VerifyService {
+    fn drop(&mut self) {
+        lock(&self.shared.queue).shutdown = true;
+        self.shared.cond.notify_one();
+        if let Some(worker) = self.worker.take() {
+            let _ = worker.join();
+        }
+    }
+}
+
+impl core::fmt::Debug for VerifyService {
+    fn fmt(&self, f: &mut core::fmt::Formatter) -> core::fmt::Result {
+        f.debug_struct("VerifyService")
+            .field("queued", &lock(&self.shared.queue).jobs.len())
+            .finish()
+    }
+}
+
+/// The worker loop: waits for a batch to fill up or its window to pass, then verifies it.
+fn run(shared: &Shared, window: Duration, max_batch: usize) {
+    let secp = Secp256k1::verification_only();
+    loop {
+        let batch = {
+            let mut queue = lock(&shared.queue);
+            while queue.jobs.is_empty() && !queue.shutdown {
+                queue = shared.cond.wait(queue).unwrap_or_else(|e| e.into_inner());
+            }
+            if queue.jobs.is_empty() {
+                return;
+            }
+            let deadline = Instant::now() + window;
+            while queue.jobs.len() < max_batch && !queue.shutdown {
+                let now = Instant::now();
+                if now >= deadline {
+                    break;
+                }
+                queue = shared
+                    .cond
+                    .wait_timeout(queue, deadline - now)
+                    .unwrap_or_else(|e| e.into_inner())
+                    .0;
+            }
+            let n = queue.jobs.len().min(max_batch);
+            queue.jobs.drain(..n).collect::<Vec<_>>()
+        };
+        verify_batch(&secp, batch);
+    }
+}
+
+/// Verifies `batch` and completes its futures.
+fn verify_batch(secp: &Secp256k1<VerifyOnly>, batch: Vec<(Job, Arc<Mutex<Slot>>)>) {
+    let mut schnorr = Vec::new();
+    let mut schnorr_slots = Vec::new();
+    for (job, slot) in &batch {
+        match job {
+            Job::Ecdsa(msg, sig, pk) => complete(slot, secp.verify_ecdsa(*msg, sig, pk)),
+            Job::Schnorr(sig, msg, pk) => {
+                schnorr.push((*sig, &msg[..], *pk));
+                schnorr_slots.push(slot);
+            }
+        }
+    }
+
+    if secp.verify_schnorr_batch(&schnorr).is_ok() {
+        schnorr_slots.iter().for_each(|slot| complete(slot, Ok(())));
+    } else {
+        // Find the invalid signatures.
+        for ((sig, msg, pk), slot) in schnorr.iter().zip(schnorr_slots) {
+            complete(slot, secp.verify_schnorr(sig, msg, pk));
+        }
+    }
+}
+
+fn complete(slot: &Mutex<Slot>, result: Result<(), Error>) {
+    let waker = {
+        let mut slot = lock(slot);
+        slot.result = Some(result);
+        slot.waker.take()
+    };
+    if let Some(waker) = waker {
+        waker.wake();
+    }
+}
+
+/// The result of a verification queued on a [`VerifyService`].
+///
+/// Resolves to the result of the corresponding `Secp256k1::verify_*` call.
+pub struct VerifyFuture {
+    slot: Arc<Mutex<Slot>>,
+}
+
+impl VerifyFuture {
+    /// Blocks the current thread until the verification is done, for callers outside of async
+    /// code.
+    pub fn wait(self) -> Result<(), Error> {
+        struct ThreadWaker(thread::Thread);
+        impl std::task::Wake for ThreadWaker {
+            fn wake(self: Arc<Self>) {
+                self.0.unpark()
+            }
+        }
+
+        let waker = Waker::from(Arc::new(ThreadWaker(thread::current())));
+        let mut cx = Context::from_waker(&waker);
+        let mut fut = self;
+        loop {
+            if let Poll::Ready(result) = Pin::new(&mut fut).poll(&mut cx) {
+                return result;
+            }
+            thread::park();
+        }
+    }
+}
+
+impl Future for VerifyFuture {
+    type Output = Result<(), Error>;
+
+    fn poll(self: Pin<&mut Self>, cx: &mut Context) -> Poll<Self::Output> {
+        let mut slot = lock(&self.slot);
+        match slot.result.take() {
+            Some(result) => Poll::Ready(result),
+            None => {
+                if !slot.waker.as_ref().map_or(false, |w| w.will_wake(cx.waker())) {
+                    slot.waker = Some(cx.waker().clone());
+                }
+                Poll::Pending
+            }
+        }
+    }
+}
+
+impl core::fmt::Debug for VerifyFuture {
+    fn fmt(&self, f: &mut core::fmt::Formatter) -> core::fmt::Result {
+        f.debug_struct("VerifyFuture").field("done", &lock(&self.slot).result.is_some()).finish()
+    }
+}
+
+#[cfg(all(test, not(secp256k1_fuzz)))]
+mod tests {
+    use super::*;
+    use crate::{Keypair, SecretKey};
+
+    #[test]
+    fn coalesced_results() {
+        let secp = Secp256k1::new();
+        let service = VerifyService::new(Duration::from_millis(50), 64);
+        let msgs: Vec<[u8; 32]> = (0..100u8).map(|i| [i; 32]).collect();
+
+        let mut futures = vec![];
+        let mut expected = vec![];
+        for (i, msg) in msgs.iter().enumerate() {
+            let sk = SecretKey::from_slice(&[i as u8 + 1; 32]).unwrap();
+            let keypair = Keypair::from_secret_key(&secp, &sk);
+            let valid = i % 7 != 3;
+            let other = if valid { msg } else { &msgs[0] };
+            if i % 2 == 0 {
+                let sig = secp.sign_ecdsa(Message::from_digest(*other), &sk);
+                futures.push(service.verify_ecdsa(
+                    Message::from_digest(*msg),
+                    sig,
+                    sk.public_key(&secp),
+                ));
+            } else {
+                let sig = secp.sign_schnorr_no_aux_rand(other, &keypair);
+                futures.push(service.verify_schnorr(sig, msg, keypair.x_only_public_key().0));
+            }
+            expected.push(if valid { Ok(()) } else { Err(Error::IncorrectSignature) });
+        }
+
+        // Completed from other threads, in any order.
+        let results: Vec<_> = thread::scope(|s| {
+            let handles: Vec<_> = futures.into_iter().rev().map(|f| s.spawn(|| f.wait())).collect();
+            handles.into_iter().rev().map(|h| h.join().unwrap()).collect()
+        });
+        assert_eq!(results, expected);
+
+        // Requests still queued when the service is dropped are completed.
+        let sig = secp.sign_schnorr_no_aux_rand(
+            &msgs[1],
+            &Keypair::from_seckey_slice(&secp, &[9; 32]).unwrap(),
+        );
+        let pk = Keypair::from_seckey_slice(&secp, &[9; 32]).unwrap().x_only_public_key().0;
+        let service = VerifyService::new(Duration::from_secs(3600), 1000);
+        let fut = service.verify_schnorr(sig, &msgs[1], pk);
+        drop(service);
+        assert_eq!(fut.wait(), Ok(()));
+    }
+}